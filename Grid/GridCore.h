@@ -59,6 +59,11 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 #include <Grid/cshift/Cshift.h>       
 #include <Grid/stencil/Stencil.h>      
 #include <Grid/parallelIO/BinaryIO.h>
+#include <Grid/parallelIO/BinaryIOAsync.h>
+#include <Grid/parallelIO/BinaryIOCompress.h>
+#ifdef HAVE_HDF5
+#include <Grid/parallelIO/Hdf5LatticeIO.h>
+#endif
 #include <Grid/algorithms/Algorithms.h>   
 NAMESPACE_CHECK(GridCore)
 
@@ -354,7 +354,7 @@ public:
 
     SimpleCompressor<siteVector> compressor;
 
-    Stencil.HaloExchange(in,compressor);
+    Stencil.HaloExchangeBegin(in,compressor);
     autoView( in_v , in, AcceleratorRead);
     autoView( out_v , out, AcceleratorWrite);
     autoView( Stencil_v  , Stencil, AcceleratorRead);
@@ -372,6 +372,10 @@ public:
 
     int osites=Grid()->oSites();
 
+    ////////////////////////////////////////////////////////
+    // Interior: all neighbours that are local or arrived
+    // through shared memory, overlapped with the MPI faces
+    ////////////////////////////////////////////////////////
     accelerator_for(sss, Grid()->oSites()*nbasis, Nsimd, {
       int ss = sss/nbasis;
       int b  = sss%nbasis;
@@ -383,21 +387,60 @@ public:
       for(int point=0;point<geom_v.npoint;point++){
 
 	SE=Stencil_v.GetEntry(ptype,point,ss);
+	int onnode = SE->_is_local || Stencil_v.same_node[point];
 	  
 	if(SE->_is_local) { 
 	  nbr = coalescedReadPermute(in_v[SE->_offset],ptype,SE->_permute);
-	} else {
+	} else if(onnode) {
 	  nbr = coalescedRead(Stencil_v.CommBuf()[SE->_offset]);
 	}
 	acceleratorSynchronise();
 
-	for(int bb=0;bb<nbasis;bb++) {
-	  res = res + coalescedRead(Aview_p[point][ss](b,bb))*nbr(bb);
+	if(onnode) {
+	  for(int bb=0;bb<nbasis;bb++) {
+	    res = res + coalescedRead(Aview_p[point][ss](b,bb))*nbr(bb);
+	  }
 	}
       }
       coalescedWrite(out_v[ss](b),res);
       });
 
+    Stencil.HaloExchangeFinish(compressor);
+
+    ////////////////////////////////////////////////////////
+    // Exterior: add the off node faces on the surface sites
+    ////////////////////////////////////////////////////////
+    int nsurface = Stencil.surface_list.size();
+    if ( nsurface ) {
+      int *surface_p = &Stencil.surface_list[0];
+      accelerator_for(sss, nsurface*nbasis, Nsimd, {
+	int ss = surface_p[sss/nbasis];
+	int b  = sss%nbasis;
+	calcComplex res = coalescedRead(out_v[ss](b));
+	calcVector nbr;
+	int ptype;
+	StencilEntry *SE;
+
+	for(int point=0;point<geom_v.npoint;point++){
+
+	  SE=Stencil_v.GetEntry(ptype,point,ss);
+	  int offnode = (!SE->_is_local) && (!Stencil_v.same_node[point]);
+
+	  if(offnode) {
+	    nbr = coalescedRead(Stencil_v.CommBuf()[SE->_offset]);
+	  }
+	  acceleratorSynchronise();
+
+	  if(offnode) {
+	    for(int bb=0;bb<nbasis;bb++) {
+	      res = res + coalescedRead(Aview_p[point][ss](b,bb))*nbr(bb);
+	    }
+	  }
+	}
+	coalescedWrite(out_v[ss](b),res);
+      });
+    }
+
     for(int p=0;p<geom.npoint;p++) AcceleratorViewContainer[p].ViewClose();
   };
 
@@ -796,6 +839,7 @@ public:
     dag_factor(nbasis*nbasis)
   {
     fillFactor();
+    Stencil.BuildSurfaceList(1,CoarseGrid.oSites());
   };
 
   CoarsenedMatrix(GridCartesian &CoarseGrid, GridRedBlackCartesian &CoarseRBGrid, int hermitian_=0) 	:
@@ -816,6 +860,7 @@ public:
     dag_factor(nbasis*nbasis)
   {
     fillFactor();
+    Stencil.BuildSurfaceList(1,CoarseGrid.oSites());
   };
 
   void fillFactor() {
@@ -144,6 +144,33 @@ public:
   }
 };
 
+////////////////////////////////////////////////////////////////////
+// Shift the HermOp of an existing linear operator, e.g. for the
+// single shift cleanup of a multi-shift solve
+////////////////////////////////////////////////////////////////////
+template<class Field>
+class ShiftedHermOpLinearOperator : public LinearOperatorBase<Field> {
+  LinearOperatorBase<Field> &_Linop;
+  RealD _shift;
+public:
+  ShiftedHermOpLinearOperator(LinearOperatorBase<Field> &Linop,RealD shift): _Linop(Linop), _shift(shift){};
+  void OpDiag (const Field &in, Field &out) { assert(0); }
+  void OpDir  (const Field &in, Field &out,int dir,int disp) { assert(0); }
+  void OpDirAll  (const Field &in, std::vector<Field> &out){ assert(0); };
+  void Op     (const Field &in, Field &out){ assert(0); }
+  void AdjOp  (const Field &in, Field &out){ assert(0); }
+  void HermOpAndNorm(const Field &in, Field &out,RealD &n1,RealD &n2){
+    HermOp(in,out);
+    ComplexD dot = innerProduct(in,out);
+    n1=real(dot);
+    n2=norm2(out);
+  }
+  void HermOp(const Field &in, Field &out){
+    _Linop.HermOp(in,out);
+    axpy(out,_shift,in,out);
+  }
+};
+
 ////////////////////////////////////////////////////////////////////
 // Wrap an already herm matrix
 ////////////////////////////////////////////////////////////////////
@@ -260,8 +287,7 @@ template<class Matrix,class Field>
       Field tmp(in.Grid());
       tmp.Checkerboard() = !in.Checkerboard();
       
-      _Mat.Meooe(in,tmp);
-      _Mat.MooeeInv(tmp,out);
+      _Mat.MooeeInvMeooe(in,out,tmp);
       _Mat.Meooe(out,tmp);
       _Mat.Mooee(in,out);
       axpy(out,-1.0,tmp,out);
@@ -269,8 +295,7 @@ template<class Matrix,class Field>
     virtual void MpcDag   (const Field &in, Field &out){
       Field tmp(in.Grid());
 	
-      _Mat.MeooeDag(in,tmp);
-      _Mat.MooeeInvDag(tmp,out);
+      _Mat.MooeeInvDagMeooeDag(in,out,tmp);
       _Mat.MeooeDag(out,tmp);
       _Mat.MooeeDag(in,out);
       axpy(out,-1.0,tmp,out);
@@ -286,8 +311,7 @@ template<class Matrix,class Field>
     virtual void Mpc      (const Field &in, Field &out) {
       Field tmp(in.Grid());
 
-      _Mat.Meooe(in,out);
-      _Mat.MooeeInv(out,tmp);
+      _Mat.MooeeInvMeooe(in,tmp,out);
       _Mat.Meooe(tmp,out);
       _Mat.MooeeInv(out,tmp);
       axpy(out,-1.0,tmp,in);
@@ -322,8 +346,7 @@ template<class Matrix,class Field>
     virtual  void MpcDag   (const Field &in, Field &out){
       Field tmp(in.Grid());
 
-      _Mat.MeooeDag(in,out);
-      _Mat.MooeeInvDag(out,tmp);
+      _Mat.MooeeInvDagMeooeDag(in,tmp,out);
       _Mat.MeooeDag(tmp,out);
       _Mat.MooeeInvDag(out,tmp);
 
@@ -377,8 +400,7 @@ class NonHermitianSchurDiagMooeeOperator :  public NonHermitianSchurOperatorBase
     Field tmp(in.Grid());
     tmp.Checkerboard() = !in.Checkerboard();
     
-    _Mat.Meooe(in, tmp);
-    _Mat.MooeeInv(tmp, out);
+    _Mat.MooeeInvMeooe(in, out, tmp);
     _Mat.Meooe(out, tmp);
     
     _Mat.Mooee(in, out);
@@ -388,8 +410,7 @@ class NonHermitianSchurDiagMooeeOperator :  public NonHermitianSchurOperatorBase
   virtual void MpcDag(const Field& in, Field& out) {
     Field tmp(in.Grid());
     
-    _Mat.MeooeDag(in, tmp);
-    _Mat.MooeeInvDag(tmp, out);
+    _Mat.MooeeInvDagMeooeDag(in, out, tmp);
     _Mat.MeooeDag(out, tmp);
 	  
     _Mat.MooeeDag(in, out);
@@ -409,8 +430,7 @@ class NonHermitianSchurDiagOneOperator : public NonHermitianSchurOperatorBase<Fi
   virtual void Mpc(const Field& in, Field& out) {
     Field tmp(in.Grid());
 	  
-    _Mat.Meooe(in, out);
-    _Mat.MooeeInv(out, tmp);
+    _Mat.MooeeInvMeooe(in, tmp, out);
     _Mat.Meooe(tmp, out);
     _Mat.MooeeInv(out, tmp);
 
@@ -450,8 +470,7 @@ class NonHermitianSchurDiagTwoOperator : public NonHermitianSchurOperatorBase<Fi
   virtual void MpcDag(const Field& in, Field& out) {
     Field tmp(in.Grid());
     
-    _Mat.MeooeDag(in, out);
-    _Mat.MooeeInvDag(out, tmp);
+    _Mat.MooeeInvDagMeooeDag(in, tmp, out);
     _Mat.MeooeDag(tmp, out);
     _Mat.MooeeInvDag(out, tmp);
 
@@ -513,6 +532,48 @@ class SchurStaggeredOperator :  public SchurOperatorBase<Field> {
 };
 template<class Matrix,class Field> using SchurStagOperator = SchurStaggeredOperator<Matrix,Field>;
 
+/////////////////////////////////////////////////////////////
+// Hermitian operator on a set of fields; the first n of in
+// are mapped to the first n of out in one call
+/////////////////////////////////////////////////////////////
+template<class Field> class LinearOperatorMultiRHSBase {
+public:
+  virtual void HermOp(const std::vector<Field> &in, std::vector<Field> &out,int n) = 0;
+  virtual ~LinearOperatorMultiRHSBase() {};
+};
+
+// Column by column through a single field operator
+template<class Field> class MultiRHSLoopOperator : public LinearOperatorMultiRHSBase<Field> {
+  LinearOperatorBase<Field> &Linop;
+public:
+  MultiRHSLoopOperator(LinearOperatorBase<Field> &_Linop) : Linop(_Linop) {};
+  void HermOp(const std::vector<Field> &in, std::vector<Field> &out,int n) {
+    for(int b=0;b<n;b++) Linop.HermOp(in[b],out[b]);
+  }
+};
+
+// Through an operator on the Nrhs blocked layout of InsertRHS, e.g. a
+// five dimensional action constructed with Nrhs. Columns are applied Nrhs
+// at a time; a short final batch is zero padded.
+template<class Field> class MultiRHSBlockOperator : public LinearOperatorMultiRHSBase<Field> {
+  LinearOperatorBase<Field> &BlockLinop;
+  Field in_b;
+  Field out_b;
+  int Nrhs;
+public:
+  MultiRHSBlockOperator(LinearOperatorBase<Field> &_BlockLinop,GridBase *BlockGrid,int _Nrhs)
+    : BlockLinop(_BlockLinop), in_b(BlockGrid), out_b(BlockGrid), Nrhs(_Nrhs) {};
+  void HermOp(const std::vector<Field> &in, std::vector<Field> &out,int n) {
+    for(int b0=0;b0<n;b0+=Nrhs){
+      int nb = std::min(Nrhs,n-b0);
+      if ( nb < Nrhs ) in_b = Zero();
+      for(int r=0;r<nb;r++) InsertRHS(in[b0+r],in_b,r);
+      BlockLinop.HermOp(in_b,out_b);
+      for(int r=0;r<nb;r++) ExtractRHS(out[b0+r],out_b,r);
+    }
+  }
+};
+
 /////////////////////////////////////////////////////////////
 // Base classes for functions of operators
 /////////////////////////////////////////////////////////////
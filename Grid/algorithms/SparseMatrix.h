@@ -73,6 +73,17 @@ public:
   virtual  void MooeeDag    (const Field &in, Field &out)=0;
   virtual  void MooeeInvDag (const Field &in, Field &out)=0;
 
+  // out = MooeeInv Meooe in, tmp is scratch. Operators with a site local
+  // MooeeInv can override this with a single fused pass.
+  virtual  void MooeeInvMeooe      (const Field &in, Field &out, Field &tmp) {
+    Meooe(in,tmp);
+    MooeeInv(tmp,out);
+  }
+  virtual  void MooeeInvDagMeooeDag(const Field &in, Field &out, Field &tmp) {
+    MeooeDag(in,tmp);
+    MooeeInvDag(tmp,out);
+  }
+
 };
 
 NAMESPACE_END(Grid);
@@ -44,106 +44,133 @@ public:
 };
 
 // Implementation of Brower et al.'s chronological inverter (arXiv:hep-lat/9509012),
-// used to forecast solutions across poles of the EOFA heatbath.
+// used to forecast solutions across poles of the EOFA heatbath and across
+// molecular dynamics steps of the pseudofermion force solves.
+//
+// Minimises the MdagM norm of the error over the span of the previous
+// solutions; HermOp(in,out) applies MdagM.
 //
 // Modified from CPS (cps_pp/src/util/dirac_op/d_op_base/comsrc/minresext.C)
+template<class Field, class HermOp>
+Field ChronoExtrapolate(HermOp MdagM, const Field& phi, const std::vector<Field>& prev_solns)
+{
+  int degree = prev_solns.size();
+  Field chi(phi); // forecasted solution
+
+  // Trivial cases
+  if(degree == 0){ chi = Zero(); return chi; }
+  else if(degree == 1){ return prev_solns[0]; }
+
+  ComplexD xp;
+  Field r(phi); // residual
+  std::vector<Field> v; // orthonormalized previous solutions
+  std::vector<Field> MdagMv;
+
+  // Orthonormalize the vector basis, dropping (near) linearly dependent solutions
+  // which would otherwise leave a singular Galerkin matrix
+  for(int i=0; i<degree; i++){
+    Field vi(prev_solns[i]);
+    RealD nrm0 = norm2(vi);
+    if ( nrm0 == 0.0 ) continue;
+    for(int j=0; j<v.size(); j++){ vi -= innerProduct(v[j],vi) * v[j]; }
+    RealD nrm = norm2(vi);
+    if ( nrm <= 1.0e-12*nrm0 ) continue;
+    vi *= 1.0/std::sqrt(nrm);
+    v.push_back(vi);
+  }
+  degree = v.size();
+  if(degree == 0){ chi = Zero(); return chi; }
+  MdagMv.resize(degree,phi);
+
+  // Array to hold the matrix elements
+  std::vector<std::vector<ComplexD>> G(degree, std::vector<ComplexD>(degree));
+
+  // Solution and source vectors
+  std::vector<ComplexD> a(degree);
+  std::vector<ComplexD> b(degree);
+
+  // Perform sparse matrix multiplication and construct rhs
+  for(int i=0; i<degree; i++){
+    b[i] = innerProduct(v[i],phi);
+    MdagM(v[i],MdagMv[i]);
+    G[i][i] = innerProduct(v[i],MdagMv[i]);
+  }
+
+  // Construct the matrix
+  for(int j=0; j<degree; j++){
+    for(int k=j+1; k<degree; k++){
+      G[j][k] = innerProduct(v[j],MdagMv[k]);
+      G[k][j] = conjugate(G[j][k]);
+    }}
+
+  // Gauss-Jordan elimination with partial pivoting
+  for(int i=0; i<degree; i++){
+
+    // Perform partial pivoting
+    int k = i;
+    for(int j=i+1; j<degree; j++){ if(abs(G[j][j]) > abs(G[k][k])){ k = j; } }
+    if(k != i){
+      xp = b[k];
+      b[k] = b[i];
+      b[i] = xp;
+      for(int j=0; j<degree; j++){
+	xp = G[k][j];
+	G[k][j] = G[i][j];
+	G[i][j] = xp;
+      }
+    }
+
+    // Convert matrix to upper triangular form
+    for(int j=i+1; j<degree; j++){
+      xp = G[j][i]/G[i][i];
+      b[j] -= xp * b[i];
+      for(int k=0; k<degree; k++){ G[j][k] -= xp*G[i][k]; }
+    }
+  }
+
+  // Use Gaussian elimination to solve equations and calculate initial guess
+  chi = Zero();
+  r = phi;
+  for(int i=degree-1; i>=0; i--){
+    a[i] = 0.0;
+    for(int j=i+1; j<degree; j++){ a[i] += G[i][j] * a[j]; }
+    a[i] = (b[i]-a[i])/G[i][i];
+    chi += a[i]*v[i];
+    r -= a[i]*MdagMv[i];
+  }
+
+  RealD error = std::sqrt(norm2(r)/norm2(phi));
+  std::cout << GridLogMessage << "ChronoForecast: |res|/|src| = " << error << std::endl;
+
+  return chi;
+}
+
+// Forecast for a sparse matrix; MdagM is applied as Mdag(M(v))
 template<class Matrix, class Field>
 class ChronoForecast : public Forecast<Matrix,Field>
 {
 public:
   Field operator()(Matrix &Mat, const Field& phi, const std::vector<Field>& prev_solns)
   {
-    int degree = prev_solns.size();
-    Field chi(phi); // forecasted solution
-
-    // Trivial cases
-    if(degree == 0){ chi = Zero(); return chi; }
-    else if(degree == 1){ return prev_solns[0]; }
-
-    //    RealD dot;
-    ComplexD xp;
-    Field r(phi); // residual
     Field Mv(phi);
-    std::vector<Field> v(prev_solns); // orthonormalized previous solutions
-    std::vector<Field> MdagMv(degree,phi);
-
-    // Array to hold the matrix elements
-    std::vector<std::vector<ComplexD>> G(degree, std::vector<ComplexD>(degree));
-
-    // Solution and source vectors
-    std::vector<ComplexD> a(degree);
-    std::vector<ComplexD> b(degree);
-
-    // Orthonormalize the vector basis
-    for(int i=0; i<degree; i++){
-      v[i] *= 1.0/std::sqrt(norm2(v[i]));
-      for(int j=i+1; j<degree; j++){ v[j] -= innerProduct(v[i],v[j]) * v[i]; }
-    }
-
-    // Perform sparse matrix multiplication and construct rhs
-    for(int i=0; i<degree; i++){
-      b[i] = innerProduct(v[i],phi);
-      Mat.M(v[i],Mv);
-      Mat.Mdag(Mv,MdagMv[i]);
-      G[i][i] = innerProduct(v[i],MdagMv[i]);
-    }
-
-    // Construct the matrix
-    for(int j=0; j<degree; j++){
-      for(int k=j+1; k<degree; k++){
-	G[j][k] = innerProduct(v[j],MdagMv[k]);
-	G[k][j] = conjugate(G[j][k]);
-      }}
-
-    // Gauss-Jordan elimination with partial pivoting
-    for(int i=0; i<degree; i++){
-
-      // Perform partial pivoting
-      int k = i;
-      for(int j=i+1; j<degree; j++){ if(abs(G[j][j]) > abs(G[k][k])){ k = j; } }
-      if(k != i){
-	xp = b[k];
-	b[k] = b[i];
-	b[i] = xp;
-	for(int j=0; j<degree; j++){
-	  xp = G[k][j];
-	  G[k][j] = G[i][j];
-	  G[i][j] = xp;
-	}
-      }
-
-      // Convert matrix to upper triangular form
-      for(int j=i+1; j<degree; j++){
-	xp = G[j][i]/G[i][i];
-	b[j] -= xp * b[i];
-	for(int k=0; k<degree; k++){ G[j][k] -= xp*G[i][k]; }
-      }
-    }
-
-    // Use Gaussian elimination to solve equations and calculate initial guess
-    chi = Zero();
-    r = phi;
-    for(int i=degree-1; i>=0; i--){
-      a[i] = 0.0;
-      for(int j=i+1; j<degree; j++){ a[i] += G[i][j] * a[j]; }
-      a[i] = (b[i]-a[i])/G[i][i];
-      chi += a[i]*v[i];
-      r -= a[i]*MdagMv[i];
-    }
-
-    RealD true_r(0.0);
-    ComplexD tmp;
-    for(int i=0; i<degree; i++){
-      tmp = -b[i];
-      for(int j=0; j<degree; j++){ tmp += G[i][j]*a[j]; }
-      tmp = conjugate(tmp)*tmp;
-      true_r += std::sqrt(tmp.real());
-    }
-
-    RealD error = std::sqrt(norm2(r)/norm2(phi));
-    std::cout << GridLogMessage << "ChronoForecast: |res|/|src| = " << error << std::endl;
+    auto MdagM = [&](const Field &in, Field &out) {
+      Mat.M(in,Mv);
+      Mat.Mdag(Mv,out);
+    };
+    return ChronoExtrapolate(MdagM,phi,prev_solns);
+  };
+};
 
-    return chi;
+// Forecast for a hermitian (normal equation) linear operator such as
+// MdagMLinearOperator or a Schur preconditioned MpcDagMpc
+template<class Field>
+class ChronoHermForecast : public Forecast<LinearOperatorBase<Field>,Field>
+{
+public:
+  Field operator()(LinearOperatorBase<Field> &HermOp, const Field& phi, const std::vector<Field>& prev_solns)
+  {
+    auto MdagM = [&](const Field &in, Field &out) { HermOp.HermOp(in,out); };
+    return ChronoExtrapolate(MdagM,phi,prev_solns);
   };
 };
 
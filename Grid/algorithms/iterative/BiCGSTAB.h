@@ -167,25 +167,17 @@ class BiCGSTAB : public OperatorFunction<Field>
 
         LinalgTimer.Start();
         InnerTimer.Start();
-        ComplexD Comega = innerProduct(t,s);
+        ComplexD Comega;
+        RealD    tt;
+        fuse(fuse_innerProduct(Comega,t,s), fuse_norm2(tt,t));
         InnerTimer.Stop();
-        omega = Comega.real() / norm2(t);
+        omega = Comega.real() / tt;
 
         LinearCombTimer.Start();
-	{
-	  autoView( psi_v,psi, AcceleratorWrite);
-	  autoView( r_v , r, AcceleratorWrite);
-	  autoView( h_v , h, AcceleratorRead);
-	  autoView( s_v , s, AcceleratorRead);
-	  autoView( t_v , t, AcceleratorRead);
-	  accelerator_for(ss, psi_v.size(), Field::vector_object::Nsimd(),{
-	      coalescedWrite(psi_v[ss], h_v(ss) + omega * s_v(ss));
-	      coalescedWrite(r_v[ss], -omega * t_v(ss) + s_v(ss));
-	    });
-	}
+        fuse(fuse_assign(psi, h + omega*s),
+             fuse_assign(r  , s - omega*t),
+             fuse_norm2(cp, r));
         LinearCombTimer.Stop();
-	
-        cp = norm2(r);
         LinalgTimer.Stop();
 
         std::cout << GridLogIterative << "BiCGSTAB: Iteration " << k << " residual " << sqrt(cp/ssq) << " target " << Tolerance << std::endl;
@@ -0,0 +1,387 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/algorithms/iterative/BlockConjugateGradientMultiRHS.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// Block CG (rQ form, Dubrulle 2001; see BlockConjugateGradient.h) over a set
+// of right hand sides held as separate fields, with the operator applied to
+// the whole active block in one LinearOperatorMultiRHSBase call.
+//
+// A right hand side whose recursive residual meets the tolerance is dropped
+// from the block: its solution is written out, and the remaining columns
+// restart from their residuals R = Q C. This keeps the block well
+// conditioned as columns converge at different rates, and the cost per
+// iteration falls with the active block size.
+//
+// Initial guesses come from an optional LinearFunction, e.g. a
+// DeflatedGuesser over low modes.
+//
+// All block inner products of an iteration are formed in one pass over the
+// fields and one global sum.
+/////////////////////////////////////////////////////////////////////////////
+template <class Field>
+class BlockConjugateGradientMultiRHS {
+public:
+
+  typedef typename Field::vector_object vobj;
+  typedef typename Field::scalar_type   scomplex;
+
+  bool ErrorOnNoConverge;  // throw an assert when the CG fails to converge.
+                           // Defaults true.
+  RealD Tolerance;
+  Integer MaxIterations;
+  Integer IterationsToComplete;              // Block iterations until the last rhs dropped
+  std::vector<Integer> IterationsToConverge; // Per rhs, filled in upon completion
+  std::vector<std::vector<RealD> > ResidualHistory; // Per rhs relative residual at each iteration
+  std::vector<RealD> TrueResiduals;
+  RealD TrueResidual;                        // Max over rhs
+
+  BlockConjugateGradientMultiRHS(RealD tol, Integer maxit, bool err_on_no_conv = true)
+    : Tolerance(tol),
+      MaxIterations(maxit),
+      ErrorOnNoConverge(err_on_no_conv){};
+
+  ////////////////////////////////////////////////////////
+  // m(i,j) = X_i^dag Y_j, i,j < n
+  ////////////////////////////////////////////////////////
+  void InnerProductMatrix(Eigen::MatrixXcd &m,const std::vector<Field> &X,const std::vector<Field> &Y,int n)
+  {
+    typedef decltype(X[0].View(AcceleratorRead)) View;
+    typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+
+    GridBase *grid = X[0].Grid();
+    const uint64_t sites = grid->oSites();
+    const int nn = n*n;
+
+    Vector<View> X_v; X_v.reserve(n);
+    Vector<View> Y_v; Y_v.reserve(n);
+    for(int i=0;i<n;i++) X_v.push_back(X[i].View(AcceleratorRead));
+    for(int i=0;i<n;i++) Y_v.push_back(Y[i].View(AcceleratorRead));
+    auto X_vp = &X_v[0];
+    auto Y_vp = &Y_v[0];
+
+    Vector<inner_t> inner_tmp(sites*nn);
+    auto inner_tmp_v = &inner_tmp[0];
+
+    accelerator_for(ss, sites, 1,{
+      for(int i=0;i<n;i++){
+	auto x_i = X_vp[i][ss];
+	for(int j=0;j<n;j++){
+	  inner_tmp_v[(i*n+j)*sites+ss] = innerProductD(x_i,Y_vp[j][ss]);
+	}
+      }
+    });
+    for(int i=0;i<n;i++) X_v[i].ViewClose();
+    for(int i=0;i<n;i++) Y_v[i].ViewClose();
+
+    std::vector<ComplexD> ip(nn);
+    for(int ij=0;ij<nn;ij++){
+      ip[ij] = TensorRemove(sum(&inner_tmp_v[ij*sites],sites));
+    }
+    grid->GlobalSumVector(&ip[0],nn);
+
+    m.resize(n,n);
+    for(int i=0;i<n;i++){
+      for(int j=0;j<n;j++){
+	m(i,j) = ip[i*n+j];
+      }
+    }
+  }
+
+  ////////////////////////////////////////////////////////
+  // R_j = Y_j + scale * sum_i X_i m(i,j) ; j < nout, i < nin
+  // R must not alias X; Y may be R or absent (nullptr)
+  ////////////////////////////////////////////////////////
+  void MaddMatrix(std::vector<Field> &R,const Eigen::MatrixXcd &m,const std::vector<Field> &X,
+		  const std::vector<Field> *Y,int nin,int nout,RealD scale=1.0)
+  {
+    typedef decltype(X[0].View(AcceleratorRead)) View;
+    typedef decltype(R[0].View(AcceleratorWrite)) WView;
+
+    GridBase *grid = X[0].Grid();
+    assert(&R!=&X);
+
+    Vector<scomplex> coeff(nin*nout);
+    for(int i=0;i<nin;i++){
+      for(int j=0;j<nout;j++){
+	coeff[i*nout+j] = scale*m(i,j);
+      }
+    }
+    auto c = &coeff[0];
+
+    Vector<View>  X_v; X_v.reserve(nin);
+    Vector<View>  Y_v; Y_v.reserve(nout);
+    Vector<WView> R_v; R_v.reserve(nout);
+    for(int i=0;i<nin;i++) X_v.push_back(X[i].View(AcceleratorRead));
+    if ( Y ) for(int j=0;j<nout;j++) Y_v.push_back((*Y)[j].View(AcceleratorRead));
+    for(int j=0;j<nout;j++){
+      R[j].Checkerboard() = X[0].Checkerboard();
+      R_v.push_back(R[j].View(AcceleratorWrite));
+    }
+    auto X_vp = &X_v[0];
+    auto Y_vp = Y ? &Y_v[0] : nullptr;
+    auto R_vp = &R_v[0];
+
+    accelerator_for(ss, grid->oSites(), vobj::Nsimd(),{
+      for(int j=0;j<nout;j++){
+	decltype(coalescedRead(X_vp[0][ss])) r;
+	if ( Y_vp ) r = coalescedRead(Y_vp[j][ss]);
+	else        r = Zero();
+	for(int i=0;i<nin;i++){
+	  r = r + c[i*nout+j]*coalescedRead(X_vp[i][ss]);
+	}
+	coalescedWrite(R_vp[j][ss],r);
+      }
+    });
+    for(int i=0;i<nin;i++) X_v[i].ViewClose();
+    for(int j=0;j<Y_v.size();j++) Y_v[j].ViewClose();
+    for(int j=0;j<nout;j++) R_v[j].ViewClose();
+  }
+
+  ////////////////////////////////////////////////////////
+  // Q C = R, C upper triangular (see BlockConjugateGradient)
+  ////////////////////////////////////////////////////////
+  void ThinQRfact(Eigen::MatrixXcd &C,std::vector<Field> &Q,const std::vector<Field> &R,int n)
+  {
+    Eigen::MatrixXcd m_rr;
+    InnerProductMatrix(m_rr,R,R,n);
+    m_rr = 0.5*(m_rr+m_rr.adjoint());
+    Eigen::MatrixXcd L = m_rr.llt().matrixL();
+    C = L.adjoint();
+    Eigen::MatrixXcd Cinv = C.inverse();
+    MaddMatrix(Q,Cinv,R,nullptr,n,n);
+  }
+
+  void operator()(LinearOperatorMultiRHSBase<Field> &Linop,const std::vector<Field> &Src,std::vector<Field> &Psi)
+  {
+    (*this)(Linop,nullptr,Src,Psi);
+  }
+  void operator()(LinearOperatorMultiRHSBase<Field> &Linop,LinearFunction<Field> &Guess,
+		  const std::vector<Field> &Src,std::vector<Field> &Psi)
+  {
+    (*this)(Linop,&Guess,Src,Psi);
+  }
+
+  void operator()(LinearOperatorMultiRHSBase<Field> &Linop,LinearFunction<Field> *Guess,
+		  const std::vector<Field> &Src,std::vector<Field> &Psi)
+  {
+    const int Nrhs = Src.size();
+    assert(Psi.size()==Nrhs);
+    assert(Nrhs>0);
+
+    GridBase *grid = Src[0].Grid();
+    for(int b=0;b<Nrhs;b++){
+      conformable(Src[b].Grid(),grid);
+      conformable(Psi[b].Grid(),grid);
+      Psi[b].Checkerboard() = Src[b].Checkerboard();
+    }
+
+    IterationsToConverge.assign(Nrhs,0);
+    ResidualHistory.assign(Nrhs,std::vector<RealD>());
+    TrueResiduals.assign(Nrhs,0.0);
+
+    ////////////////////////////////////////////////////////
+    // Active block: column a solves rhs act[a]
+    ////////////////////////////////////////////////////////
+    std::vector<int>   act;
+    std::vector<RealD> ssq(Nrhs);
+    std::vector<Field> X  (Nrhs,grid);
+    std::vector<Field> Q  (Nrhs,grid);
+    std::vector<Field> D  (Nrhs,grid);
+    std::vector<Field> Z  (Nrhs,grid);
+    std::vector<Field> tmp(Nrhs,grid);
+
+    for(int b=0;b<Nrhs;b++){
+      if ( Guess ) (*Guess)(Src[b],Psi[b]);
+      RealD guess = norm2(Psi[b]);
+      assert(std::isnan(guess) == 0);
+      ssq[b] = norm2(Src[b]);
+      if ( ssq[b] == 0.0 ) {
+	Psi[b] = Zero();
+	continue;
+      }
+      X[act.size()] = Psi[b];
+      act.push_back(b);
+    }
+    int s = act.size();
+
+    std::cout << GridLogMessage << "BlockConjugateGradientMultiRHS: " << Nrhs << " right hand sides" << std::endl;
+
+    GridStopWatch InnerTimer;
+    GridStopWatch MaddTimer;
+    GridStopWatch QRTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch SolverTimer;
+
+    Eigen::MatrixXcd m_C, m_S, m_DZ, m_M, m_tmp;
+
+    SolverTimer.Start();
+    // R = B - A X ; Q C = R ; D = Q
+    if ( s ) {
+      MatrixTimer.Start();
+      Linop.HermOp(X,Z,s);
+      MatrixTimer.Stop();
+      for(int a=0;a<s;a++) tmp[a] = Src[act[a]] - Z[a];
+    }
+    bool restart = true;
+
+    int k = 0;
+    while ( s > 0 ) {
+
+      if ( restart ) {
+	QRTimer.Start();
+	ThinQRfact(m_C,Q,tmp,s);
+	QRTimer.Stop();
+	for(int a=0;a<s;a++) D[a] = Q[a];
+	restart = false;
+      }
+
+      ////////////////////////////////////////////////////////
+      // Converged or exhausted columns leave the block
+      ////////////////////////////////////////////////////////
+      Eigen::MatrixXcd m_rr = m_C.adjoint()*m_C;
+      std::vector<int> keep;
+      for(int a=0;a<s;a++){
+	int b = act[a];
+	RealD rr = real(m_rr(a,a))/ssq[b];
+	if ( ResidualHistory[b].size() == k ) ResidualHistory[b].push_back(std::sqrt(rr)); // once per iteration across restarts
+	if ( (rr <= Tolerance*Tolerance) || (k >= MaxIterations) ) {
+	  Psi[b] = X[a];
+	  IterationsToConverge[b] = k;
+	  std::cout << GridLogIterative << "BlockConjugateGradientMultiRHS: rhs " << b
+		    << " leaves the block at iteration " << k << " residual " << std::sqrt(rr) << std::endl;
+	} else {
+	  keep.push_back(a);
+	}
+      }
+      if ( keep.size() < s ) {
+	int sk = keep.size();
+	if ( sk == 0 ) break;
+	// Residuals of the remaining columns; R = Q C
+	Eigen::MatrixXcd m_Ck(s,sk);
+	for(int j=0;j<sk;j++) m_Ck.col(j) = m_C.col(keep[j]);
+	MaddTimer.Start();
+	MaddMatrix(tmp,m_Ck,Q,nullptr,s,sk);
+	MaddTimer.Stop();
+	for(int j=0;j<sk;j++){
+	  if ( keep[j] != j ) {
+	    std::swap(X[j],X[keep[j]]);
+	  }
+	  act[j] = act[keep[j]];
+	}
+	act.resize(sk);
+	s = sk;
+	restart = true;
+	continue;
+      }
+
+      k++;
+
+      // Z = A D
+      MatrixTimer.Start();
+      Linop.HermOp(D,Z,s);
+      MatrixTimer.Stop();
+
+      // M = [D^dag Z]^{-1}
+      InnerTimer.Start();
+      InnerProductMatrix(m_DZ,D,Z,s);
+      InnerTimer.Stop();
+      m_M = m_DZ.inverse();
+
+      // X = X + D M C
+      m_tmp = m_M*m_C;
+      MaddTimer.Start();
+      MaddMatrix(X,m_tmp,D,&X,s,s);
+
+      // Q S = Q - Z M
+      MaddMatrix(tmp,m_M,Z,&Q,s,s,-1.0);
+      MaddTimer.Stop();
+      QRTimer.Start();
+      ThinQRfact(m_S,Q,tmp,s);
+      QRTimer.Stop();
+
+      // D = Q + D S^dag
+      m_tmp = m_S.adjoint();
+      MaddTimer.Start();
+      MaddMatrix(Z,m_tmp,D,&Q,s,s);
+      MaddTimer.Stop();
+      for(int a=0;a<s;a++) std::swap(D[a],Z[a]);
+
+      // C = S C
+      m_C = m_S*m_C;
+
+      RealD max_resid = 0;
+      m_rr = m_C.adjoint()*m_C;
+      for(int a=0;a<s;a++) max_resid = std::max(max_resid,real(m_rr(a,a))/ssq[act[a]]);
+      std::cout << GridLogIterative << "BlockConjugateGradientMultiRHS: Iteration " << k
+		<< " active " << s << " max residual " << std::sqrt(max_resid) << " target " << Tolerance << std::endl;
+    }
+    SolverTimer.Stop();
+    IterationsToComplete = k;
+
+    ////////////////////////////////////////////////////////
+    // True residuals, through the block operator
+    ////////////////////////////////////////////////////////
+    for(int b=0;b<Nrhs;b++) X[b] = Psi[b];
+    Linop.HermOp(X,Z,Nrhs);
+    TrueResidual = 0;
+    bool converged = true;
+    for(int b=0;b<Nrhs;b++){
+      if ( ssq[b] == 0.0 ) continue;
+      Z[b] = Z[b] - Src[b];
+      TrueResiduals[b] = std::sqrt(norm2(Z[b])/ssq[b]);
+      TrueResidual = std::max(TrueResidual,TrueResiduals[b]);
+      RealD computed = ResidualHistory[b].back();
+      if ( computed > Tolerance ) converged = false;
+      std::cout << GridLogMessage << "BlockConjugateGradientMultiRHS: rhs " << b
+		<< " iterations " << IterationsToConverge[b]
+		<< "\tComputed residual " << computed
+		<< "\tTrue residual " << TrueResiduals[b] << std::endl;
+    }
+
+    std::cout << GridLogMessage << "Time breakdown "<<std::endl;
+    std::cout << GridLogMessage << "\tElapsed    " << SolverTimer.Elapsed() <<std::endl;
+    std::cout << GridLogMessage << "\tMatrix     " << MatrixTimer.Elapsed() <<std::endl;
+    std::cout << GridLogMessage << "\tInnerProd  " << InnerTimer.Elapsed() <<std::endl;
+    std::cout << GridLogMessage << "\tMaddMatrix " << MaddTimer.Elapsed() <<std::endl;
+    std::cout << GridLogMessage << "\tThinQRfact " << QRTimer.Elapsed() <<std::endl;
+
+    if ( converged ) {
+      std::cout << GridLogMessage << "BlockConjugateGradientMultiRHS converged in " << k << " iterations"
+		<< "\tMax true residual " << TrueResidual << std::endl;
+      if (ErrorOnNoConverge) assert(TrueResidual / Tolerance < 10000.0);
+      return;
+    }
+
+    std::cout << GridLogMessage << "BlockConjugateGradientMultiRHS did NOT converge " << k << " / " << MaxIterations << std::endl;
+    if (ErrorOnNoConverge) assert(0);
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -228,14 +228,17 @@ public:
     //Linop.HermOpAndNorm(p,mmp,d,qq); // d is used
     // The below is faster on KNL
     Linop.HermOp(p,mmp); 
-    d=real(innerProduct(p,mmp));
-    
     MatrixTimer.Stop();  
 
+    // d = <p,mmp>, |p|^2 and the primary shift in one sweep
     AXPYTimer.Start();
-      axpy(mmp,mass[0],p,mmp);
+      ComplexD dc;
+      RealD rn;
+      fuse(fuse_innerProduct(dc,p,mmp),
+	   fuse_norm2(rn,p),
+	   fuse_assign(mmp,mass[0]*p+mmp));
+      d  = real(dc);
     AXPYTimer.Stop();
-      RealD rn = norm2(p);
       d += rn*mass[0];
     
       bp=b;
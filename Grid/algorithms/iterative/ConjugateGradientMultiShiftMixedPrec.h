@@ -0,0 +1,393 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./lib/algorithms/iterative/ConjugateGradientMultiShiftMixedPrec.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef GRID_CONJUGATE_GRADIENT_MULTI_SHIFT_MIXED_PREC_H
+#define GRID_CONJUGATE_GRADIENT_MULTI_SHIFT_MIXED_PREC_H
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Mixed precision multi-shift CG with reliable updates.
+//
+// The Krylov recurrences of all shifts run in single precision on Linop_f,
+// and a shift leaves the update loop as soon as its (implied) residual has
+// converged. The solutions are accumulated in single precision and flushed
+// into double whenever the primary residual has dropped by Delta since the
+// last reliable update; the primary residual is then recomputed in double on
+// Linop_d, as in ConjugateGradientReliableUpdate. The shifted residuals are
+// not corrected by this, so once all shifts have converged each is checked
+// in double and, if short of its tolerance, finished by a double precision
+// CG on the shifted operator starting from the multi-shift solution.
+////////////////////////////////////////////////////////////////////////////////
+template<class FieldD,class FieldF,
+	 typename std::enable_if< getPrecision<FieldD>::value == 2, int>::type = 0,
+	 typename std::enable_if< getPrecision<FieldF>::value == 1, int>::type = 0>
+class ConjugateGradientMultiShiftMixedPrec : public OperatorMultiFunction<FieldD>,
+					     public OperatorFunction<FieldD>
+{
+public:
+
+  using OperatorFunction<FieldD>::operator();
+
+  RealD   Tolerance;
+  Integer MaxIterations;
+  Integer IterationsToComplete; //Number of iterations the CG took to finish. Filled in upon completion
+  std::vector<int> IterationsToCompleteShift;  // Iterations for this shift
+  std::vector<int> IterationsToCleanupShift;   // Double precision cleanup iterations for this shift
+  Integer ReliableUpdatesPerformed;
+  int verbose;
+  MultiShiftFunction shifts;
+  std::vector<RealD> TrueResidualShift;
+
+  LinearOperatorBase<FieldF> &Linop_f;
+  GridBase* SinglePrecGrid;
+  RealD Delta; //reliable update parameter
+
+  ConjugateGradientMultiShiftMixedPrec(Integer maxit, MultiShiftFunction &_shifts,
+				       GridBase* _sp_grid, LinearOperatorBase<FieldF> &_Linop_f,
+				       RealD _delta = 0.1) :
+    MaxIterations(maxit),
+    shifts(_shifts),
+    Linop_f(_Linop_f),
+    SinglePrecGrid(_sp_grid),
+    Delta(_delta)
+  {
+    verbose=1;
+    IterationsToCompleteShift.resize(_shifts.order);
+    IterationsToCleanupShift.resize(_shifts.order);
+    TrueResidualShift.resize(_shifts.order);
+  }
+
+  void operator() (LinearOperatorBase<FieldD> &Linop, const FieldD &src, FieldD &psi)
+  {
+    GridBase *grid = src.Grid();
+    int nshift = shifts.order;
+    std::vector<FieldD> results(nshift,grid);
+    (*this)(Linop,src,results,psi);
+  }
+  void operator() (LinearOperatorBase<FieldD> &Linop, const FieldD &src, std::vector<FieldD> &results, FieldD &psi)
+  {
+    int nshift = shifts.order;
+
+    (*this)(Linop,src,results);
+
+    psi = shifts.norm*src;
+    for(int i=0;i<nshift;i++){
+      psi = psi + shifts.residues[i]*results[i];
+    }
+
+    return;
+  }
+
+  void operator() (LinearOperatorBase<FieldD> &Linop_d, const FieldD &src, std::vector<FieldD> &psi)
+  {
+    GridBase *grid = src.Grid();
+
+    ////////////////////////////////////////////////////////////////////////
+    // Convenience references to the info stored in "MultiShiftFunction"
+    ////////////////////////////////////////////////////////////////////////
+    int nshift = shifts.order;
+
+    std::vector<RealD> &mass(shifts.poles); // Make references to array in "shifts"
+    std::vector<RealD> &mresidual(shifts.tolerances);
+
+    assert(psi.size()==nshift);
+    assert(mass.size()==nshift);
+    assert(mresidual.size()==nshift);
+
+    std::vector<RealD> bs(nshift);
+    std::vector<RealD> rsq(nshift);
+    std::vector<std::array<RealD,2> > z(nshift);
+    std::vector<int> converged(nshift,0);
+    std::vector<int> dirty(nshift,0);   // single precision solution not yet flushed
+
+    const int       primary =0;
+
+    //Primary shift fields CG iteration
+    RealD a,b,c,d;
+    RealD cp,bp; //prev
+
+    // Double precision fields
+    FieldD r_d(grid);
+    FieldD tmp_d(grid);
+    FieldD mmp_d(grid);
+
+    // Single precision fields
+    std::vector<FieldF> ps_f (nshift,SinglePrecGrid);// Search directions
+    std::vector<FieldF> psi_f(nshift,SinglePrecGrid);// Solution since the last reliable update
+    FieldF r_f(SinglePrecGrid);
+    FieldF p_f(SinglePrecGrid);
+    FieldF mmp_f(SinglePrecGrid);
+
+    // Check lightest mass
+    for(int s=0;s<nshift;s++){
+      assert( mass[s]>= mass[primary] );
+    }
+
+    for(int s=0;s<nshift;s++){
+      psi[s] = Zero();
+      psi[s].Checkerboard() = src.Checkerboard();
+    }
+
+    // Wire guess to zero
+    // Residuals "r" are src
+    // First search direction "p" is also src
+    cp = norm2(src);
+
+    // Handle trivial case of zero src.
+    if( cp == 0. ){
+      for(int s=0;s<nshift;s++){
+	IterationsToCompleteShift[s] = 1;
+	IterationsToCleanupShift[s] = 0;
+	TrueResidualShift[s] = 0.;
+      }
+      IterationsToComplete = 1;
+      ReliableUpdatesPerformed = 0;
+      return;
+    }
+
+    for(int s=0;s<nshift;s++){
+      rsq[s] = cp * mresidual[s] * mresidual[s];
+      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec: shift "<<s
+	       <<" target resid "<<rsq[s]<<std::endl;
+    }
+
+    precisionChange(r_f,src);
+    p_f = r_f;
+    for(int s=0;s<nshift;s++) ps_f[s] = r_f;
+
+    //MdagM+m[0]
+    Linop_f.HermOp(p_f,mmp_f);
+    axpy(mmp_f,mass[0],p_f,mmp_f);
+    d = real(innerProduct(p_f,mmp_f));
+
+    b = -cp /d;
+
+    // Set up the various shift variables
+    int       iz=0;
+    z[0][1-iz] = 1.0;
+    z[0][iz]   = 1.0;
+    bs[0]      = b;
+    for(int s=1;s<nshift;s++){
+      z[s][1-iz] = 1.0;
+      z[s][iz]   = 1.0/( 1.0 - b*(mass[s]-mass[0]));
+      bs[s]      = b*z[s][iz];
+    }
+
+    // r += b[0] A.p[0]
+    // c= norm(r)
+    c=axpy_norm(r_f,b,mmp_f,r_f);
+
+    for(int s=0;s<nshift;s++) {
+      psi_f[s] = (RealF)(-bs[s])*ps_f[s];
+      dirty[s] = 1;
+    }
+
+    RealD MaxResidSinceLastRelUp = cp;
+    int l = 0;
+
+    ///////////////////////////////////////
+    // Timers
+    ///////////////////////////////////////
+    GridStopWatch AXPYTimer;
+    GridStopWatch ShiftTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch ReliableTimer;
+    GridStopWatch CleanupTimer;
+    GridStopWatch SolverTimer;
+    SolverTimer.Start();
+
+    // Iteration loop
+    int k;
+
+    for (k=1;k<=MaxIterations;k++){
+
+      a = c /cp;
+      AXPYTimer.Start();
+      axpy(p_f,a,p_f,r_f);
+      for(int s=0;s<nshift;s++){
+	if ( ! converged[s] ) {
+	  if (s==0){
+	    axpy(ps_f[s],a,ps_f[s],r_f);
+	  } else{
+	    RealD as =a *z[s][iz]*bs[s] /(z[s][1-iz]*b);
+	    axpby(ps_f[s],z[s][iz],as,r_f,ps_f[s]);
+	  }
+	}
+      }
+      AXPYTimer.Stop();
+
+      cp=c;
+      MatrixTimer.Start();
+      Linop_f.HermOp(p_f,mmp_f);
+      MatrixTimer.Stop();
+
+      // d = <p,mmp>, |p|^2 and the primary shift in one sweep
+      AXPYTimer.Start();
+      ComplexD dc;
+      RealD rn;
+      fuse(fuse_innerProduct(dc,p_f,mmp_f),
+	   fuse_norm2(rn,p_f),
+	   fuse_assign(mmp_f,(RealF)mass[0]*p_f+mmp_f));
+      d  = real(dc);
+      AXPYTimer.Stop();
+      d += rn*mass[0];
+
+      bp=b;
+      b=-cp/d;
+
+      AXPYTimer.Start();
+      c=axpy_norm(r_f,b,mmp_f,r_f);
+      AXPYTimer.Stop();
+
+      // Toggle the recurrence history
+      bs[0] = b;
+      iz = 1-iz;
+      ShiftTimer.Start();
+      for(int s=1;s<nshift;s++){
+	if((!converged[s])){
+	  RealD z0 = z[s][1-iz];
+	  RealD z1 = z[s][iz];
+	  z[s][iz] = z0*z1*bp
+	    / (b*a*(z1-z0) + z1*bp*(1- (mass[s]-mass[0])*b));
+	  bs[s] = b*z[s][iz]/z0; // NB sign  rel to Mike
+	}
+      }
+      ShiftTimer.Stop();
+
+      AXPYTimer.Start();
+      for(int s=0;s<nshift;s++){
+	if( (!converged[s]) ) {
+	  axpy(psi_f[s],-bs[s],ps_f[s],psi_f[s]);
+	  dirty[s] = 1;
+	}
+      }
+      AXPYTimer.Stop();
+
+      // Convergence checks; a converged shift leaves the update loop
+      int all_converged = 1;
+      for(int s=0;s<nshift;s++){
+	if ( (!converged[s]) ){
+	  IterationsToCompleteShift[s] = k;
+	  RealD css  = c * z[s][iz]* z[s][iz];
+	  if(css<rsq[s]){
+	    std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec k="<<k<<" Shift "<<s<<" has converged"<<std::endl;
+	    converged[s]=1;
+	  } else {
+	    all_converged=0;
+	  }
+	}
+      }
+
+      if ( all_converged ) break;
+
+      if ( c > MaxResidSinceLastRelUp ) MaxResidSinceLastRelUp = c;
+
+      //////////////////////////////////////////////////////////////////
+      // Reliable update: flush into double, true primary residual
+      //////////////////////////////////////////////////////////////////
+      if ( c < Delta * MaxResidSinceLastRelUp ) {
+	ReliableTimer.Start();
+	for(int s=0;s<nshift;s++){
+	  if ( dirty[s] ) {
+	    precisionChange(tmp_d,psi_f[s]);
+	    psi[s] = psi[s] + tmp_d;
+	    psi_f[s] = Zero();
+	    dirty[s] = 0;
+	  }
+	}
+	Linop_d.HermOp(psi[primary],mmp_d);
+	axpy(mmp_d,mass[primary],psi[primary],mmp_d);
+	r_d = src - mmp_d;
+	RealD cn = norm2(r_d);
+	std::cout<<GridLogIterative<<"ConjugateGradientMultiShiftMixedPrec k="<<k<<" reliable update: iterated residual "
+		 <<c<<" true residual "<<cn<<std::endl;
+	c = cn;
+	precisionChange(r_f,r_d);
+	MaxResidSinceLastRelUp = c;
+	l++;
+	ReliableTimer.Stop();
+      }
+    }
+
+    if ( k > MaxIterations ) {
+      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec did not converge"<<std::endl;
+      k = MaxIterations;
+    } else {
+      std::cout<<GridLogMessage<< "ConjugateGradientMultiShiftMixedPrec: All shifts have converged iteration "<<k
+	       <<" after "<<l<<" reliable updates"<<std::endl;
+    }
+
+    for(int s=0;s<nshift;s++){
+      if ( dirty[s] ) {
+	precisionChange(tmp_d,psi_f[s]);
+	psi[s] = psi[s] + tmp_d;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // Check each shift in double; finish those short of tolerance
+    //////////////////////////////////////////////////////////////////
+    CleanupTimer.Start();
+    RealD cn = norm2(src);
+    for(int s=0; s < nshift; s++) {
+      Linop_d.HermOp(psi[s],mmp_d);
+      axpy(tmp_d,mass[s],psi[s],mmp_d);
+      r_d = src - tmp_d;
+      RealD rn = norm2(r_d);
+      IterationsToCleanupShift[s] = 0;
+      if ( rn > rsq[s] ) {
+	ShiftedHermOpLinearOperator<FieldD> ShiftedLinop(Linop_d,mass[s]);
+	ConjugateGradient<FieldD> CG(mresidual[s],MaxIterations,false);
+	CG(ShiftedLinop,src,psi[s]);
+	IterationsToCleanupShift[s] = CG.IterationsToComplete;
+	Linop_d.HermOp(psi[s],mmp_d);
+	axpy(tmp_d,mass[s],psi[s],mmp_d);
+	r_d = src - tmp_d;
+	rn = norm2(r_d);
+      }
+      TrueResidualShift[s] = std::sqrt(rn/cn);
+      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec: shift["<<s<<"] true residual "<< TrueResidualShift[s]
+	       <<" cleanup iterations "<<IterationsToCleanupShift[s]<<std::endl;
+    }
+    CleanupTimer.Stop();
+    SolverTimer.Stop();
+
+    std::cout << GridLogMessage << "Time Breakdown "<<std::endl;
+    std::cout << GridLogMessage << "\tElapsed    " << SolverTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tAXPY    " << AXPYTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tMatrix    " << MatrixTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tShift    " << ShiftTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tReliable    " << ReliableTimer.Elapsed()     <<std::endl;
+    std::cout << GridLogMessage << "\tCleanup    " << CleanupTimer.Elapsed()     <<std::endl;
+
+    IterationsToComplete = k;
+    ReliableUpdatesPerformed = l;
+  }
+
+};
+
+NAMESPACE_END(Grid);
+#endif
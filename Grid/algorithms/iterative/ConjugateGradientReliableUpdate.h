@@ -150,13 +150,11 @@ public:
       a = c / d;
       b_pred = a * (a * qq - d) / c;
 
-      cp = axpy_norm(r_f, -a, mmp_f, r_f);
+      fuse(fuse_assign(psi_f, a * p_f + psi_f),
+	   fuse_assign(r_f, r_f - a * mmp_f),
+	   fuse_norm2(cp, r_f));
       b = cp / c;
 
-      // Fuse these loops ; should be really easy
-      psi_f = a * p_f + psi_f;
-      //p_f = p_f * b + r_f;
-
       LinalgTimer.Stop();
 
       std::cout << GridLogIterative << "ConjugateGradientReliableUpdate: Iteration " << k
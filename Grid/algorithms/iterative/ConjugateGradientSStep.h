@@ -0,0 +1,301 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/algorithms/iterative/ConjugateGradientSStep.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#ifndef GRID_CONJUGATE_GRADIENT_SSTEP_H
+#define GRID_CONJUGATE_GRADIENT_SSTEP_H
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// s-step (communication avoiding) CG; Chronopoulos and Gear, and
+// Carson's CA-CG formulation.
+//
+// Each outer step builds the Krylov basis
+//
+//     V = [ p, Ap, ..., A^s p, r, Ar, ..., A^{s-1} r ]       (2s+1 vectors)
+//
+// and its Gram matrix G = V^dag V in ONE global reduction. The next s CG
+// iterations then run on coordinate vectors of length 2s+1 against G and
+// the shift matrix B (A V_j = V_{j+1} within each block), with no lattice
+// work and no communication, before p, r and psi are rebuilt from V in a
+// single sweep.
+//
+// The monomial basis loses rank quickly as s grows; s of 2..5 is the
+// useful range. 2s-1 operator applications are made per s iterations.
+/////////////////////////////////////////////////////////////////////////////
+template <class Field>
+class ConjugateGradientSStep : public OperatorFunction<Field> {
+public:
+
+  typedef typename Field::vector_object vobj;
+
+  using OperatorFunction<Field>::operator();
+
+  bool ErrorOnNoConverge;  // throw an assert when the CG fails to converge.
+                           // Defaults true.
+  RealD Tolerance;
+  Integer MaxIterations;
+  Integer SStep;
+  Integer IterationsToComplete; //Number of iterations the CG took to finish. Filled in upon completion
+  RealD TrueResidual;
+
+  ConjugateGradientSStep(RealD tol, Integer maxit, Integer s = 4, bool err_on_no_conv = true)
+    : Tolerance(tol),
+      MaxIterations(maxit),
+      SStep(s),
+      ErrorOnNoConverge(err_on_no_conv){ assert(SStep>=1); };
+
+  ////////////////////////////////////////////////////////
+  // Upper triangle of V^dag V in one pass and one sum
+  ////////////////////////////////////////////////////////
+  void GramMatrix(std::vector<Field> &V,Eigen::MatrixXcd &G)
+  {
+    typedef decltype(V[0].View(AcceleratorRead)) View;
+    typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+
+    GridBase *grid = V[0].Grid();
+    const int      n     = V.size();
+    const int      npair = n*(n+1)/2;
+    const uint64_t sites = grid->oSites();
+
+    Vector<View> V_v; V_v.reserve(n);
+    for(int i=0;i<n;i++) V_v.push_back(V[i].View(AcceleratorRead));
+    auto V_vp = &V_v[0];
+
+    Vector<inner_t> inner_tmp(sites*npair);
+    auto inner_tmp_v = &inner_tmp[0];
+
+    accelerator_for(ss, sites, 1,{
+      int ij=0;
+      for(int i=0;i<n;i++){
+	auto v_i = V_vp[i][ss];
+	for(int j=i;j<n;j++){
+	  inner_tmp_v[ij*sites+ss] = innerProductD(v_i,V_vp[j][ss]);
+	  ij++;
+	}
+      }
+    });
+    for(int i=0;i<n;i++) V_v[i].ViewClose();
+
+    std::vector<ComplexD> gram(npair);
+    for(int ij=0;ij<npair;ij++){
+      gram[ij] = TensorRemove(sum(&inner_tmp_v[ij*sites],sites));
+    }
+    grid->GlobalSumVector(&gram[0],npair);
+
+    G.resize(n,n);
+    int ij=0;
+    for(int i=0;i<n;i++){
+      for(int j=i;j<n;j++){
+	G(i,j) = gram[ij];
+	G(j,i) = std::conj(gram[ij]);
+	ij++;
+      }
+    }
+  }
+
+  ////////////////////////////////////////////////////////
+  // psi += V x ; r = V rc ; p = V pc in one pass over V
+  ////////////////////////////////////////////////////////
+  void Recombine(std::vector<Field> &V,
+		 const Eigen::VectorXcd &xc,const Eigen::VectorXcd &rc,const Eigen::VectorXcd &pc,
+		 Field &psi,Field &r,Field &p)
+  {
+    typedef decltype(V[0].View(AcceleratorRead)) View;
+
+    GridBase *grid = V[0].Grid();
+    const int n = V.size();
+
+    Vector<View> V_v; V_v.reserve(n);
+    for(int i=0;i<n;i++) V_v.push_back(V[i].View(AcceleratorRead));
+    auto V_vp = &V_v[0];
+
+    typedef typename vobj::scalar_type scalar_type;
+    Vector<scalar_type> coeff(3*n);
+    for(int i=0;i<n;i++){
+      coeff[i]     = xc(i);
+      coeff[n+i]   = rc(i);
+      coeff[2*n+i] = pc(i);
+    }
+    auto c = &coeff[0];
+
+    r.Checkerboard() = psi.Checkerboard();
+    p.Checkerboard() = psi.Checkerboard();
+    autoView( psi_v , psi, AcceleratorWrite);
+    autoView( r_v   , r,   AcceleratorWrite);
+    autoView( p_v   , p,   AcceleratorWrite);
+    accelerator_for(ss, grid->oSites(), vobj::Nsimd(),{
+      auto x_s = psi_v(ss);
+      decltype(x_s) r_s = Zero();
+      decltype(x_s) p_s = Zero();
+      for(int i=0;i<n;i++){
+	auto v = V_vp[i](ss);
+	x_s = x_s + c[i]    *v;
+	r_s = r_s + c[n+i]  *v;
+	p_s = p_s + c[2*n+i]*v;
+      }
+      coalescedWrite(psi_v[ss],x_s);
+      coalescedWrite(r_v[ss]  ,r_s);
+      coalescedWrite(p_v[ss]  ,p_s);
+    });
+    for(int i=0;i<n;i++) V_v[i].ViewClose();
+  }
+
+  void operator()(LinearOperatorBase<Field> &Linop, const Field &src, Field &psi) {
+
+    psi.Checkerboard() = src.Checkerboard();
+
+    conformable(psi, src);
+
+    const int s = SStep;
+    const int n = 2*s+1;
+    RealD cp, ssq, d, qq;
+
+    Field p(src);
+    Field r(src);
+    Field mmp(src);
+    std::vector<Field> V(n,src.Grid());
+
+    // Initial residual computation & set up
+    RealD guess = norm2(psi);
+    assert(std::isnan(guess) == 0);
+
+    Linop.HermOp(psi, mmp);
+    fuse(fuse_assign(r, src - mmp),
+	 fuse_norm2(cp, r),
+	 fuse_norm2(ssq, src));
+    p = r;
+
+    // Handle trivial case of zero src
+    if (ssq == 0.){
+      psi = Zero();
+      IterationsToComplete = 1;
+      TrueResidual = 0.;
+      return;
+    }
+
+    std::cout << GridLogIterative << std::setprecision(8) << "ConjugateGradientSStep: s " << s << std::endl;
+    std::cout << GridLogIterative << std::setprecision(8) << "ConjugateGradientSStep: guess " << guess << std::endl;
+    std::cout << GridLogIterative << std::setprecision(8) << "ConjugateGradientSStep:   src " << ssq << std::endl;
+    std::cout << GridLogIterative << std::setprecision(8) << "ConjugateGradientSStep:     r " << cp << std::endl;
+
+    RealD rsq = Tolerance * Tolerance * ssq;
+
+    if (cp <= rsq) {
+      TrueResidual = std::sqrt(cp/ssq);
+      std::cout << GridLogMessage << "ConjugateGradientSStep guess is converged already " << std::endl;
+      IterationsToComplete = 0;
+      return;
+    }
+
+    ////////////////////////////////////////////////////////
+    // Shift matrix: column j of B is the basis coordinate of A V_j
+    ////////////////////////////////////////////////////////
+    Eigen::MatrixXcd B = Eigen::MatrixXcd::Zero(n,n);
+    for(int j=0;j<s;j++)   B(j+1,j) = 1.0;        // p block
+    for(int j=0;j<s-1;j++) B(s+2+j,s+1+j) = 1.0;  // r block
+    Eigen::MatrixXcd G;
+
+    GridStopWatch LinalgTimer;
+    GridStopWatch GramTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch SolverTimer;
+
+    SolverTimer.Start();
+    int k = 0;
+    int converged = 0;
+    while ( (k < MaxIterations) && !converged ) {
+
+      MatrixTimer.Start();
+      V[0] = p;
+      for(int j=1;j<=s;j++)   Linop.HermOp(V[j-1],V[j]);
+      V[s+1] = r;
+      for(int j=1;j<=s-1;j++) Linop.HermOp(V[s+j],V[s+1+j]);
+      MatrixTimer.Stop();
+
+      GramTimer.Start();
+      GramMatrix(V,G);
+      GramTimer.Stop();
+
+      Eigen::VectorXcd pc = Eigen::VectorXcd::Zero(n); pc(0)   = 1.0;
+      Eigen::VectorXcd rc = Eigen::VectorXcd::Zero(n); rc(s+1) = 1.0;
+      Eigen::VectorXcd xc = Eigen::VectorXcd::Zero(n);
+
+      RealD c = real(rc.dot(G*rc));
+      for(int j=0;j<s && k<MaxIterations;j++){
+	k++;
+	Eigen::VectorXcd Bp = B*pc;
+	RealD pAp = real(pc.dot(G*Bp));
+	RealD a   = c / pAp;
+	xc = xc + a*pc;
+	rc = rc - a*Bp;
+	cp = real(rc.dot(G*rc));
+	RealD b = cp / c;
+	pc = rc + b*pc;
+	c  = cp;
+
+	std::cout << GridLogIterative << "ConjugateGradientSStep: Iteration " << k
+		  << " residual " << sqrt(cp/ssq) << " target " << Tolerance << std::endl;
+
+	if ( cp <= rsq ) { converged = 1; break; }
+      }
+
+      LinalgTimer.Start();
+      Recombine(V,xc,rc,pc,psi,r,p);
+      LinalgTimer.Stop();
+    }
+    SolverTimer.Stop();
+
+    Linop.HermOpAndNorm(psi, mmp, d, qq);
+    p = mmp - src;
+    RealD true_residual = std::sqrt(norm2(p)/ssq);
+
+    IterationsToComplete = k;
+    TrueResidual = true_residual;
+
+    if ( converged ) {
+      std::cout << GridLogMessage << "ConjugateGradientSStep Converged on iteration " << k
+		<< "\tComputed residual " << std::sqrt(cp / ssq)
+		<< "\tTrue residual " << true_residual
+		<< "\tTarget " << Tolerance << std::endl;
+
+      std::cout << GridLogIterative << "Time breakdown "<<std::endl;
+      std::cout << GridLogIterative << "\tElapsed    " << SolverTimer.Elapsed() <<std::endl;
+      std::cout << GridLogIterative << "\tMatrix     " << MatrixTimer.Elapsed() <<std::endl;
+      std::cout << GridLogIterative << "\tGram       " << GramTimer.Elapsed() <<std::endl;
+      std::cout << GridLogIterative << "\tLinalg     " << LinalgTimer.Elapsed() <<std::endl;
+
+      if (ErrorOnNoConverge) assert(true_residual / Tolerance < 10000.0);
+      return;
+    }
+
+    std::cout << GridLogMessage << "ConjugateGradientSStep did NOT converge "<<k<<" / "<< MaxIterations<< std::endl;
+
+    if (ErrorOnNoConverge) assert(0);
+  }
+};
+NAMESPACE_END(Grid);
+#endif
@@ -1,4 +1,5 @@
 #include <Grid/GridCore.h>
+#include <sys/mman.h>
 
 NAMESPACE_BEGIN(Grid);
 
@@ -22,90 +23,230 @@ void MemoryManager::PrintBytes(void)
 //////////////////////////////////////////////////////////////////////
 // Data tables for recently freed pooiniter caches
 //////////////////////////////////////////////////////////////////////
-MemoryManager::AllocationCacheEntry MemoryManager::Entries[MemoryManager::NallocType][MemoryManager::NallocCacheMax];
-int MemoryManager::Victim[MemoryManager::NallocType];
+MemoryManager::AllocationBinTable MemoryManager::Bins[MemoryManager::NallocType];
+MemoryManager::AllocationAgeList  MemoryManager::Age[MemoryManager::NallocType];
 int MemoryManager::Ncache[MemoryManager::NallocType] = { 8, 32, 8, 32, 8, 32 };
+std::mutex MemoryManager::CacheMutex;
+uint64_t MemoryManager::CacheHits;
+uint64_t MemoryManager::CacheMisses;
+uint64_t MemoryManager::CacheBytes;
+uint64_t MemoryManager::PaddingBytes;
+
+// Byte counters are shared by all allocating threads
+void MemoryManager::AccountAllocate(uint64_t &total,uint64_t fresh,uint64_t padding)
+{
+  std::lock_guard<std::mutex> guard(CacheMutex);
+  total        += fresh;
+  PaddingBytes += padding;
+}
+void MemoryManager::AccountFree(uint64_t &total,uint64_t freed,uint64_t padding)
+{
+  std::lock_guard<std::mutex> guard(CacheMutex);
+  total        -= freed;
+  PaddingBytes -= padding;
+}
 
 //////////////////////////////////////////////////////////////////////
 // Actual allocation and deallocation utils
 //////////////////////////////////////////////////////////////////////
 void *MemoryManager::AcceleratorAllocate(size_t bytes)
 {
-  void *ptr = (void *) Lookup(bytes,Acc);
+  size_t cbytes = SizeClass(bytes);
+  void *ptr = (void *) Lookup(cbytes,Acc);
+  uint64_t fresh = 0;
   if ( ptr == (void *) NULL ) {
-    ptr = (void *) acceleratorAllocDevice(bytes);
-    total_device+=bytes;
+    ptr = (void *) acceleratorAllocDevice(cbytes);
+    fresh = cbytes;
   }
+  AccountAllocate(total_device,fresh,cbytes-bytes);
   return ptr;
 }
 void  MemoryManager::AcceleratorFree    (void *ptr,size_t bytes)
 {
-  void *__freeme = Insert(ptr,bytes,Acc);
+  size_t cbytes = SizeClass(bytes);
+  uint64_t freed = 0;
+  void *__freeme = Insert(ptr,cbytes,Acc);
   if ( __freeme ) {
     acceleratorFreeDevice(__freeme);
-    total_device-=bytes;
+    freed = cbytes;
     //    PrintBytes();
   }
+  AccountFree(total_device,freed,cbytes-bytes);
 }
 void *MemoryManager::SharedAllocate(size_t bytes)
 {
-  void *ptr = (void *) Lookup(bytes,Shared);
+  size_t cbytes = SizeClass(bytes);
+  void *ptr = (void *) Lookup(cbytes,Shared);
+  uint64_t fresh = 0;
   if ( ptr == (void *) NULL ) {
-    ptr = (void *) acceleratorAllocShared(bytes);
-    total_shared+=bytes;
+    ptr = (void *) acceleratorAllocShared(cbytes);
+    fresh = cbytes;
     //    std::cout <<"AcceleratorAllocate: allocated Shared pointer "<<std::hex<<ptr<<std::dec<<std::endl;
     //    PrintBytes();
   }
+  AccountAllocate(total_shared,fresh,cbytes-bytes);
   return ptr;
 }
 void  MemoryManager::SharedFree    (void *ptr,size_t bytes)
 {
-  void *__freeme = Insert(ptr,bytes,Shared);
+  size_t cbytes = SizeClass(bytes);
+  uint64_t freed = 0;
+  void *__freeme = Insert(ptr,cbytes,Shared);
   if ( __freeme ) {
     acceleratorFreeShared(__freeme);
-    total_shared-=bytes;
+    freed = cbytes;
     //    PrintBytes();
   }
+  AccountFree(total_shared,freed,cbytes-bytes);
 }
 #ifdef GRID_UVM
 void *MemoryManager::CpuAllocate(size_t bytes)
 {
-  void *ptr = (void *) Lookup(bytes,Cpu);
+  size_t cbytes = SizeClass(bytes);
+  void *ptr = (void *) Lookup(cbytes,Cpu);
+  uint64_t fresh = 0;
   if ( ptr == (void *) NULL ) {
-    ptr = (void *) acceleratorAllocShared(bytes);
-    total_host+=bytes;
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+    ptr = (void *) acceleratorAllocShared(cbytes);
+#else
+    ptr = (void *) HostAllocate(cbytes);
+#endif
+    fresh = cbytes;
   }
+  AccountAllocate(total_host,fresh,cbytes-bytes);
   return ptr;
 }
 void  MemoryManager::CpuFree    (void *_ptr,size_t bytes)
 {
   NotifyDeletion(_ptr);
-  void *__freeme = Insert(_ptr,bytes,Cpu);
+  size_t cbytes = SizeClass(bytes);
+  uint64_t freed = 0;
+  void *__freeme = Insert(_ptr,cbytes,Cpu);
   if ( __freeme ) { 
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
     acceleratorFreeShared(__freeme);
-    total_host-=bytes;
+#else
+    HostFree(__freeme,cbytes);
+#endif
+    freed = cbytes;
   }
+  AccountFree(total_host,freed,cbytes-bytes);
 }
 #else
 void *MemoryManager::CpuAllocate(size_t bytes)
 {
-  void *ptr = (void *) Lookup(bytes,Cpu);
+  size_t cbytes = SizeClass(bytes);
+  void *ptr = (void *) Lookup(cbytes,Cpu);
+  uint64_t fresh = 0;
   if ( ptr == (void *) NULL ) {
-    ptr = (void *) acceleratorAllocCpu(bytes);
-    total_host+=bytes;
+    ptr = (void *) HostAllocate(cbytes);
+    fresh = cbytes;
   }
+  AccountAllocate(total_host,fresh,cbytes-bytes);
   return ptr;
 }
 void  MemoryManager::CpuFree    (void *_ptr,size_t bytes)
 {
   NotifyDeletion(_ptr);
-  void *__freeme = Insert(_ptr,bytes,Cpu);
+  size_t cbytes = SizeClass(bytes);
+  uint64_t freed = 0;
+  void *__freeme = Insert(_ptr,cbytes,Cpu);
   if ( __freeme ) { 
-    acceleratorFreeCpu(__freeme);
-    total_host-=bytes;
+    HostFree(__freeme,cbytes);
+    freed = cbytes;
+  }
+  AccountFree(total_host,freed,cbytes-bytes);
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// Host page placement. Large fields may be backed by huge pages, and
+// are first touched under the same static thread_for split the lattice
+// kernels use, so each socket's threads fault in the pages they own.
+//////////////////////////////////////////////////////////////////////
+int      MemoryManager::PagePolicy        = PagesDefault;
+int      MemoryManager::FirstTouch        = 0;
+uint64_t MemoryManager::PlacementMinBytes = 2*1024*1024;
+std::unordered_map<uint64_t,size_t> MemoryManager::HugeMaps;
+std::mutex MemoryManager::PlacementMutex;
+
+// MAP_HUGETLB mapping rounded up to whole pages of the policy's size; NULL on failure
+void *MemoryManager::HugeMap(size_t bytes,size_t &mapbytes)
+{
+  void *ptr = NULL;
+  mapbytes = bytes;
+#ifdef __linux__
+  size_t page = (PagePolicy==PagesHuge1GB) ? (1UL<<30) : (1UL<<21);
+  mapbytes = ((bytes+page-1)/page)*page;
+  int flags = MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB;
+#if defined(MAP_HUGE_1GB) && defined(MAP_HUGE_2MB)
+  flags |= (PagePolicy==PagesHuge1GB) ? MAP_HUGE_1GB : MAP_HUGE_2MB;
+#endif
+  ptr = mmap(NULL,mapbytes,PROT_READ|PROT_WRITE,flags,-1,0);
+  if ( ptr == MAP_FAILED ) ptr = NULL;
+#endif
+  return ptr;
+}
+
+void *MemoryManager::HostAllocate(size_t bytes)
+{
+  void *ptr = NULL;
+  bool large = (bytes >= PlacementMinBytes);
+  if ( large && ( (PagePolicy==PagesHuge2MB) || (PagePolicy==PagesHuge1GB) ) ) {
+    size_t mapbytes;
+    ptr = HugeMap(bytes,mapbytes);
+    if ( ptr == NULL ) {
+      // Hugetlbfs pool exhausted; this field gets transparent huge pages instead
+      static std::once_flag warned;
+      std::call_once(warned,[&](){
+	std::cout << GridLogWarning << "MemoryManager: MAP_HUGETLB mmap of "<<mapbytes
+		  <<" bytes failed; falling back to transparent huge pages"<<std::endl;
+      });
+    } else {
+      std::lock_guard<std::mutex> guard(PlacementMutex);
+      HugeMaps[(uint64_t)ptr] = mapbytes;
+    }
+  }
+  if ( ptr == NULL ) {
+    ptr = acceleratorAllocCpu(bytes);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if ( large && (PagePolicy!=PagesDefault) && ptr ) {
+      madvise(ptr,bytes,MADV_HUGEPAGE);
+    }
+#endif
   }
+  if ( large && FirstTouch && ptr ) FirstTouchPages(ptr,bytes);
+  return ptr;
 }
+
+void MemoryManager::HostFree(void *ptr,size_t bytes)
+{
+#ifdef __linux__
+  {
+    std::lock_guard<std::mutex> guard(PlacementMutex);
+    auto map = HugeMaps.find((uint64_t)ptr);
+    if ( map != HugeMaps.end() ) {
+      munmap(ptr,map->second);
+      HugeMaps.erase(map);
+      return;
+    }
+  }
 #endif
+  acceleratorFreeCpu(ptr);
+}
+
+void MemoryManager::FirstTouchPages(void *ptr,size_t bytes)
+{
+#ifdef GRID_OMP
+  assert(omp_in_parallel()==0);
+#endif 
+  const uint64_t page = 4096;
+  uint64_t npages = (bytes+page-1)/page;
+  volatile char *base = (volatile char *)ptr;
+  thread_for(p,npages,{
+    base[p*page] = 0;
+  });
+}
 
 //////////////////////////////////////////
 // call only once
@@ -116,6 +257,20 @@ void MemoryManager::Init(void)
   char * str;
   int Nc;
   int NcS;
+
+  // Settle the page policy before any field is allocated: without a
+  // hugetlbfs pool of the requested size use transparent huge pages
+  if ( (PagePolicy==PagesHuge2MB) || (PagePolicy==PagesHuge1GB) ) {
+    size_t mapbytes;
+    void *probe = HugeMap(1,mapbytes);
+    if ( probe ) {
+      munmap(probe,mapbytes);
+    } else {
+      std::cout << GridLogWarning << "MemoryManager: no "<<sizeString(mapbytes)
+		<<" huge pages available; falling back to transparent huge pages"<<std::endl;
+      PagePolicy = PagesTransparent;
+    }
+  }
   
   str= getenv("GRID_ALLOC_NCACHE_LARGE");
   if ( str ) {
@@ -148,7 +303,17 @@ void MemoryManager::InitMessage(void) {
   std::cout << GridLogMessage<< "MemoryManager::Init() setting up"<<std::endl;
 #ifdef ALLOCATION_CACHE
   std::cout << GridLogMessage<< "MemoryManager::Init() cache pool for recent allocations: SMALL "<<Ncache[CpuSmall]<<" LARGE "<<Ncache[Cpu]<<std::endl;
+  std::cout << GridLogMessage<< "MemoryManager::Init() "<<(1<<GRID_ALLOC_CLASS_BITS)<<" size classes per power of two"<<std::endl;
 #endif
+
+  if ( PagePolicy == PagesTransparent ) 
+    std::cout << GridLogMessage<< "MemoryManager::Init() Transparent huge pages advised for fields >= "<<sizeString(PlacementMinBytes)<<std::endl;
+  if ( PagePolicy == PagesHuge2MB ) 
+    std::cout << GridLogMessage<< "MemoryManager::Init() Explicit 2MB huge pages for fields >= "<<sizeString(PlacementMinBytes)<<std::endl;
+  if ( PagePolicy == PagesHuge1GB ) 
+    std::cout << GridLogMessage<< "MemoryManager::Init() Explicit 1GB huge pages for fields >= "<<sizeString(PlacementMinBytes)<<std::endl;
+  if ( FirstTouch )
+    std::cout << GridLogMessage<< "MemoryManager::Init() Parallel first touch placement of fresh fields"<<std::endl;
   
 #ifdef GRID_UVM
   std::cout << GridLogMessage<< "MemoryManager::Init() Unified memory space"<<std::endl;
@@ -176,51 +341,69 @@ void MemoryManager::InitMessage(void) {
 
 }
 
-void *MemoryManager::Insert(void *ptr,size_t bytes,int type) 
+//////////////////////////////////////////////////////////////////////
+// Size classes: small requests round to GRID_ALLOC_SMALL_QUANTUM, large
+// ones to 2^GRID_ALLOC_CLASS_BITS classes per power of two. Temporaries
+// of nearby sizes then share a bin instead of missing the cache.
+//////////////////////////////////////////////////////////////////////
+size_t MemoryManager::SizeClass(size_t bytes)
 {
 #ifdef ALLOCATION_CACHE
-  bool small = (bytes < GRID_ALLOC_SMALL_LIMIT);
-  int cache = type + small;
-  return Insert(ptr,bytes,Entries[cache],Ncache[cache],Victim[cache]);  
+  if ( bytes < GRID_ALLOC_SMALL_LIMIT ) {
+    return ((bytes+GRID_ALLOC_SMALL_QUANTUM-1)/GRID_ALLOC_SMALL_QUANTUM)*GRID_ALLOC_SMALL_QUANTUM;
+  }
+  int msb = 63 - __builtin_clzll((unsigned long long)bytes);
+  size_t quantum = ((size_t)1) << (msb - GRID_ALLOC_CLASS_BITS);
+  if ( quantum < GRID_ALLOC_SMALL_QUANTUM ) quantum = GRID_ALLOC_SMALL_QUANTUM;
+  return ((bytes+quantum-1)/quantum)*quantum;
 #else
-  return ptr;
+  return bytes;
 #endif
 }
 
-void *MemoryManager::Insert(void *ptr,size_t bytes,AllocationCacheEntry *entries,int ncache,int &victim) 
+void *MemoryManager::Insert(void *ptr,size_t bytes,int type) 
 {
-  assert(ncache>0);
+#ifdef ALLOCATION_CACHE
+  bool small = (bytes < GRID_ALLOC_SMALL_LIMIT);
+  int cache = type + small;
+  int ncache = Ncache[cache];
+  if ( ncache==0 ) return ptr;
 #ifdef GRID_OMP
   assert(omp_in_parallel()==0);
 #endif 
 
-  void * ret = NULL;
-  int v = -1;
-
-  for(int e=0;e<ncache;e++) {
-    if ( entries[e].valid==0 ) {
-      v=e; 
-      break;
-    }
-  }
+  std::lock_guard<std::mutex> guard(CacheMutex);
 
-  if ( v==-1 ) {
-    v=victim;
-    victim = (victim+1)%ncache;
-  }
+  void * ret = NULL;
+  AllocationAgeList &age = Age[cache];
 
-  if ( entries[v].valid ) {
-    ret = entries[v].address;
-    entries[v].valid = 0;
-    entries[v].address = NULL;
-    entries[v].bytes = 0;
+  ///////////////////////////////////////////////
+  // Pool full: recycle the oldest entry, which
+  // is also the front of its own bin.
+  ///////////////////////////////////////////////
+  if ( age.size() >= (size_t)ncache ) {
+    AllocationAgeIterator victim = age.begin();
+    AllocationBinTable::iterator bin = Bins[cache].find(victim->bytes);
+    assert(bin != Bins[cache].end());
+    assert(bin->second.front() == victim);
+    bin->second.pop_front();
+    if ( bin->second.empty() ) Bins[cache].erase(bin);
+    ret = victim->address;
+    CacheBytes -= victim->bytes;
+    age.erase(victim);
   }
 
-  entries[v].address=ptr;
-  entries[v].bytes  =bytes;
-  entries[v].valid  =1;
+  AllocationCacheEntry entry;
+  entry.address = ptr;
+  entry.bytes   = bytes;
+  Bins[cache][bytes].push_back(age.insert(age.end(),entry));
+  CacheBytes += bytes;
 
+  if ( MemoryProfiler::stats ) CacheStats(*MemoryProfiler::stats);
   return ret;
+#else
+  return ptr;
+#endif
 }
 
 void *MemoryManager::Lookup(size_t bytes,int type)
@@ -228,27 +411,51 @@ void *MemoryManager::Lookup(size_t bytes,int type)
 #ifdef ALLOCATION_CACHE
   bool small = (bytes < GRID_ALLOC_SMALL_LIMIT);
   int cache = type+small;
-  return Lookup(bytes,Entries[cache],Ncache[cache]);
+#ifdef GRID_OMP
+  assert(omp_in_parallel()==0);
+#endif 
+
+  std::lock_guard<std::mutex> guard(CacheMutex);
+
+  void * ret = NULL;
+  AllocationBinTable::iterator bin = Bins[cache].find(bytes);
+  if ( bin != Bins[cache].end() ) {
+    // Most recently freed block is the likeliest to still be resident
+    AllocationAgeIterator entry = bin->second.back();
+    bin->second.pop_back();
+    if ( bin->second.empty() ) Bins[cache].erase(bin);
+    ret = entry->address;
+    CacheBytes -= entry->bytes;
+    Age[cache].erase(entry);
+    CacheHits++;
+  } else { 
+    CacheMisses++;
+  }
+  if ( MemoryProfiler::stats ) CacheStats(*MemoryProfiler::stats);
+  return ret;
 #else
   return NULL;
 #endif
 }
 
-void *MemoryManager::Lookup(size_t bytes,AllocationCacheEntry *entries,int ncache) 
+void MemoryManager::CacheStats(MemoryStats &stats)
 {
-  assert(ncache>0);
-#ifdef GRID_OMP
-  assert(omp_in_parallel()==0);
-#endif 
-  for(int e=0;e<ncache;e++){
-    if ( entries[e].valid && ( entries[e].bytes == bytes ) ) {
-      entries[e].valid = 0;
-      return entries[e].address;
-    }
-  }
-  return NULL;
+  stats.cacheHits    = CacheHits;
+  stats.cacheMisses  = CacheMisses;
+  stats.cacheBytes   = CacheBytes;
+  stats.paddingBytes = PaddingBytes;
 }
 
+void MemoryManager::PrintCacheStats(void)
+{
+  uint64_t lookups = CacheHits+CacheMisses;
+  double hitrate = lookups ? (100.0*CacheHits)/lookups : 0.0;
+  std::cout << GridLogMessage << "MemoryManager : free pool hit rate "<<hitrate<<"% ("
+	    << CacheHits<<" hits "<<CacheMisses<<" misses)"<<std::endl;
+  std::cout << GridLogMessage << "MemoryManager : free pool holds "<<sizeString(CacheBytes)<<std::endl;
+  std::cout << GridLogMessage << "MemoryManager : size class padding "<<sizeString(PaddingBytes)
+	    << " of live allocations"<<std::endl;
+}
 
 NAMESPACE_END(Grid);
 
@@ -28,6 +28,8 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 /*  END LEGAL */
 #pragma once
 #include <list> 
+#include <deque> 
+#include <mutex> 
 #include <unordered_map>  
 
 NAMESPACE_BEGIN(Grid);
@@ -35,6 +37,8 @@ NAMESPACE_BEGIN(Grid);
 // Move control to configure.ac and Config.h?
 
 #define GRID_ALLOC_SMALL_LIMIT (4096)
+#define GRID_ALLOC_SMALL_QUANTUM (256)
+#define GRID_ALLOC_CLASS_BITS (4)   // 16 size classes per power of two, <= 6.25% padding
 
 /*Pinning pages is costly*/
 ////////////////////////////////////////////////////////////////////////////
@@ -65,34 +69,67 @@ enum ViewMode {
   CpuWriteDiscard = 0x10 // same for now
 };
 
+////////////////////////////////////////////////////////////////////////////
+// Page placement for large host allocations (lattice fields on CPU targets)
+////////////////////////////////////////////////////////////////////////////
+enum PagePolicyType {
+  PagesDefault     = 0x0,    // Whatever the aligned allocator returns
+  PagesTransparent = 0x1,    // madvise(MADV_HUGEPAGE) for transparent huge pages
+  PagesHuge2MB     = 0x2,    // Explicit MAP_HUGETLB 2MB pages, falling back to transparent
+  PagesHuge1GB     = 0x3     // Explicit MAP_HUGETLB 1GB pages, falling back to transparent
+};
+
 class MemoryManager {
 private:
 
   ////////////////////////////////////////////////////////////
   // For caching recently freed allocations
+  //
+  // Requests are rounded up to a size class; each class keeps a bin of
+  // free blocks so lookup is O(1). All cached blocks of a type are also
+  // threaded on an age list so the oldest block is the eviction victim.
   ////////////////////////////////////////////////////////////
   typedef struct { 
     void *address;
     size_t bytes;
-    int valid;
   } AllocationCacheEntry;
 
-  static const int NallocCacheMax=128; 
+  typedef std::list<AllocationCacheEntry>         AllocationAgeList;
+  typedef typename AllocationAgeList::iterator    AllocationAgeIterator;
+  typedef std::deque<AllocationAgeIterator>       AllocationBin;
+  typedef std::unordered_map<size_t,AllocationBin> AllocationBinTable;
+
+  static const int NallocCacheMax=1024; 
   static const int NallocType=6;
-  static AllocationCacheEntry Entries[NallocType][NallocCacheMax];
-  static int Victim[NallocType];
+  static AllocationBinTable Bins[NallocType];
+  static AllocationAgeList  Age[NallocType];
   static int Ncache[NallocType];
+  static std::mutex CacheMutex;
 
   /////////////////////////////////////////////////
   // Free pool
   /////////////////////////////////////////////////
+  static size_t SizeClass(size_t bytes);
   static void *Insert(void *ptr,size_t bytes,int type) ;
   static void *Lookup(size_t bytes,int type) ;
-  static void *Insert(void *ptr,size_t bytes,AllocationCacheEntry *entries,int ncache,int &victim) ;
-  static void *Lookup(size_t bytes,AllocationCacheEntry *entries,int ncache) ;
+  static void  AccountAllocate(uint64_t &total,uint64_t fresh,uint64_t padding);
+  static void  AccountFree    (uint64_t &total,uint64_t freed,uint64_t padding);
 
   static void PrintBytes(void);
+
+  /////////////////////////////////////////////////
+  // Host page placement
+  /////////////////////////////////////////////////
+  static std::unordered_map<uint64_t,size_t> HugeMaps;
+  static std::mutex PlacementMutex;
+  static void *HostAllocate(size_t bytes);
+  static void  HostFree    (void *ptr,size_t bytes);
+  static void  FirstTouchPages(void *ptr,size_t bytes);
+  static void *HugeMap(size_t bytes,size_t &mapbytes);
  public:
+  static int      PagePolicy;        // PagePolicyType; fixed once Init() has run
+  static int      FirstTouch;        // Touch fresh pages under thread_for so they land on the owning socket
+  static uint64_t PlacementMinBytes; // Allocations below this keep default placement
   static void Init(void);
   static void InitMessage(void);
   static void *AcceleratorAllocate(size_t bytes);
@@ -112,6 +149,16 @@ private:
   static uint64_t     DeviceToHostBytes;
   static uint64_t     HostToDeviceXfer;
   static uint64_t     DeviceToHostXfer;
+
+  ////////////////////////////////////////////////////////
+  // Free pool efficiency
+  ////////////////////////////////////////////////////////
+  static uint64_t     CacheHits;
+  static uint64_t     CacheMisses;
+  static uint64_t     CacheBytes;    // bytes parked in the free pool
+  static uint64_t     PaddingBytes;  // size class rounding of live allocations
+  static void         CacheStats(MemoryStats &stats);
+  static void         PrintCacheStats(void);
  
  private:
 #ifndef GRID_UVM
@@ -37,6 +37,9 @@ struct MemoryStats
 {
   size_t totalAllocated{0}, maxAllocated{0}, 
     currentlyAllocated{0}, totalFreed{0};
+  // MemoryManager free pool: hit rate and size class fragmentation
+  size_t cacheHits{0}, cacheMisses{0},
+    cacheBytes{0}, paddingBytes{0};
 };
     
 class MemoryProfiler
@@ -60,6 +63,9 @@ public:
 		<< std::endl;						\
       std::cout << GridLogDebug << "[Memory debug] freed  : " << memString(s->totalFreed) \
 		<< std::endl;						\
+      std::cout << GridLogDebug << "[Memory debug] pool   : " << s->cacheHits << " hits " \
+		<< s->cacheMisses << " misses " << memString(s->cacheBytes) << " cached " \
+		<< memString(s->paddingBytes) << " padding" << std::endl;	\
     }
 
 #define profilerAllocate(bytes)						\
@@ -39,6 +39,8 @@ NAMESPACE_BEGIN(Grid);
 CartesianCommunicator::CommunicatorPolicy_t  
 CartesianCommunicator::CommunicatorPolicy= CartesianCommunicator::CommunicatorPolicyConcurrent;
 int CartesianCommunicator::nCommThreads = -1;
+int CartesianCommunicator::NodeAwareReductions = 1;
+int ReproducibleSum::Enabled = 0;
 
 /////////////////////////////////
 // Grid information queries
@@ -71,6 +73,10 @@ void CartesianCommunicator::GlobalSumVector(ComplexD *c,int N)
 {
   GlobalSumVector((double *)c,2*N);
 }
+void CartesianCommunicator::GlobalSumVectorBegin(ComplexD *c,int N,CommsRequest_t &req)
+{
+  GlobalSumVectorBegin((double *)c,2*N,req);
+}
   
 NAMESPACE_END(Grid);
 
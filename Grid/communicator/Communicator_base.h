@@ -46,6 +46,7 @@ public:
   static CommunicatorPolicy_t CommunicatorPolicy;
   static void SetCommunicatorPolicy(CommunicatorPolicy_t policy ) { CommunicatorPolicy = policy; }
   static int       nCommThreads;
+  static int       NodeAwareReductions; // --comms-flat-reductions turns off
 
   ////////////////////////////////////////////
   // Communicator should know nothing of the physics grid, only processor grid.
@@ -80,6 +81,23 @@ private:
   ////////////////////////////////////////////////
   void InitFromMPICommunicator(const Coordinate &processors, Grid_MPI_Comm communicator_base);
 
+#if defined (GRID_COMMS_MPI3)
+  ////////////////////////////////////////////////
+  // Node aware reductions: sum on node through a small shared
+  // window of this communicator's node group, allreduce between
+  // the node leaders only, read the result back from the window
+  ////////////////////////////////////////////////
+  static const int    NodeReduceBytes = 64*1024;  // per rank; larger vectors go in pieces
+  int                 node_reduce;                // hierarchical path in use
+  MPI_Comm            communicator_leaders;       // ShmRank 0 of each node, else MPI_COMM_NULL
+  MPI_Win             node_reduce_win;
+  std::vector<void *> node_reduce_bufs;           // every node rank's part of the window
+  void NodeReduceInit(void);
+  void NodeReduceFree(void);
+  void NodeReduceSync(void);
+  template<class T> void NodeReduceSumVector(T *d,int N,MPI_Datatype type);
+#endif
+
 public:
   
   
@@ -129,6 +147,14 @@ public:
     scalar_type * ptr = (scalar_type *)& o;
     GlobalSumVector(ptr,words);
   }
+
+  ////////////////////////////////////////////////////////////
+  // Non-blocking reduction; the buffer must not be touched
+  // until GlobalSumWait returns. See GlobalSumHandle below.
+  ////////////////////////////////////////////////////////////
+  void GlobalSumVectorBegin(RealD *,int N,CommsRequest_t &req);
+  void GlobalSumVectorBegin(ComplexD *c,int N,CommsRequest_t &req);
+  void GlobalSumWait(CommsRequest_t &req);
   
   ////////////////////////////////////////////////////////////
   // Face exchange, buffer swap in translational invariant way
@@ -156,6 +182,20 @@ public:
   void StencilSendToRecvFromComplete(std::vector<CommsRequest_t> &waitall,int i);
   void StencilBarrier(void);
 
+  ////////////////////////////////////////////////////////////
+  // Persistent face exchange: requests are set up once for a
+  // fixed buffer pair and restarted on every halo exchange
+  ////////////////////////////////////////////////////////////
+  double StencilSendToRecvFromPersistentInit(std::vector<CommsRequest_t> &list,
+					     void *xmit,
+					     int xmit_to_rank,
+					     void *recv,
+					     int recv_from_rank,
+					     int bytes,int dir);
+  void StencilSendToRecvFromPersistentStart(std::vector<CommsRequest_t> &list,int dir);
+  void StencilSendToRecvFromPersistentComplete(std::vector<CommsRequest_t> &list,int dir);
+  static void StencilSendToRecvFromPersistentFree(std::vector<CommsRequest_t> &list);
+
   ////////////////////////////////////////////////////////////
   // Barrier
   ////////////////////////////////////////////////////////////
@@ -190,6 +230,95 @@ public:
 
 }; 
 
+////////////////////////////////////////////////////////////////////////////////
+// Batched, non-blocking global sum.
+//
+//    GlobalSumHandle sums(grid);
+//    norm2(sums,rr,r);              // queue local partial sums
+//    innerProduct(sums,pq,p,q);
+//    sums.Begin();                  // one allreduce for everything queued
+//    ... local work ...
+//    sums.Wait();                   // rr, pq now hold the global values
+//
+// Queued values are packed into one double precision buffer, so single
+// precision partial sums are reduced in double as well. Destinations are
+// written only by Wait; the handle may be reused after Wait.
+////////////////////////////////////////////////////////////////////////////////
+class GlobalSumHandle {
+public:
+  GlobalSumHandle(CartesianCommunicator *_comm) : comm(_comm), pending(0) {};
+  ~GlobalSumHandle() { if ( pending && buf.size() ) comm->GlobalSumWait(req); }; // buffer must outlive the request
+
+  void AddVector(const RealD *local,RealD *result,int N) { Queue(local,result,N,0); };
+  void AddVector(const RealF *local,RealF *result,int N) { Queue(local,result,N,1); };
+  void AddVector(const ComplexD *local,ComplexD *result,int N) { AddVector((const RealD *)local,(RealD *)result,2*N); };
+  void AddVector(const ComplexF *local,ComplexF *result,int N) { AddVector((const RealF *)local,(RealF *)result,2*N); };
+  template<class obj> void AddVector(const obj *local,obj *result,int N)
+  {
+    typedef typename obj::scalar_type scalar_type;
+    int words = N*(sizeof(obj)/sizeof(scalar_type));
+    AddVector((const scalar_type *)local,(scalar_type *)result,words);
+  }
+  template<class obj> void Add(const obj &local,obj &result)
+  {
+    AddVector(&local,&result,1);
+  }
+  int Words(void) { return buf.size(); };
+
+  void Begin(void)
+  {
+    assert(!pending);
+    pending = 1;
+    if ( buf.size() ) comm->GlobalSumVectorBegin(&buf[0],buf.size(),req);
+  }
+  void Wait(void)
+  {
+    if ( pending ) {
+      if ( buf.size() ) comm->GlobalSumWait(req);
+    } else {
+      // nothing to overlap: the blocking sum may take the node aware path
+      if ( buf.size() ) comm->GlobalSumVector(&buf[0],buf.size());
+    }
+    pending = 0;
+    for(int d=0;d<dests.size();d++){
+      const RealD *g = &buf[dests[d].offset];
+      if ( dests[d].single ) {
+	RealF *r = (RealF *)dests[d].ptr;
+	for(int w=0;w<dests[d].words;w++) r[w] = g[w];
+      } else {
+	RealD *r = (RealD *)dests[d].ptr;
+	for(int w=0;w<dests[d].words;w++) r[w] = g[w];
+      }
+    }
+    buf.resize(0);
+    dests.resize(0);
+  }
+
+private:
+  template<class real_t> void Queue(const real_t *local,real_t *result,int words,int single)
+  {
+    assert(!pending);
+    Destination dest;
+    dest.ptr    = (void *)result;
+    dest.offset = buf.size();
+    dest.words  = words;
+    dest.single = single;
+    for(int w=0;w<words;w++) buf.push_back((RealD)local[w]);
+    dests.push_back(dest);
+  }
+  struct Destination {
+    void  *ptr;
+    size_t offset;
+    int    words;
+    int    single;
+  };
+  CartesianCommunicator *comm;
+  CommsRequest_t req;
+  std::vector<RealD> buf;
+  std::vector<Destination> dests;
+  int pending;
+};
+
 NAMESPACE_END(Grid);
 
 #endif
@@ -109,6 +109,7 @@ CartesianCommunicator::CartesianCommunicator(const Coordinate &processors)
   GlobalSharedMemory::OptimalCommunicator    (processors,optimal_comm);
   InitFromMPICommunicator(processors,optimal_comm);
   SetCommunicator(optimal_comm);
+  NodeReduceInit();
   ///////////////////////////////////////////////////
   // Free the temp communicator
   ///////////////////////////////////////////////////
@@ -186,6 +187,7 @@ CartesianCommunicator::CartesianCommunicator(const Coordinate &processors,const
   // Take the right SHM buffers
   //////////////////////////////////////////////////////////////////////////////////////////////////////
   SetCommunicator(comm_split);
+  NodeReduceInit();
 
   ///////////////////////////////////////////////
   // Free the temp communicator
@@ -249,21 +251,106 @@ CartesianCommunicator::~CartesianCommunicator()
   int MPI_is_finalised;
   MPI_Finalized(&MPI_is_finalised);
   if (communicator && !MPI_is_finalised) {
+    NodeReduceFree();
     MPI_Comm_free(&communicator);
     for(int i=0;i<communicator_halo.size();i++){
       MPI_Comm_free(&communicator_halo[i]);
     }
   }
 }
+//////////////////////////////////////////////////////////////////////////////////
+// Node aware reduction. Shared memory buffers of the halo exchange are common
+// to all communicators (and device memory on GPUs), so each communicator gets
+// its own small host window over its node group; split grids reduce without
+// trampling each other.
+//////////////////////////////////////////////////////////////////////////////////
+void CartesianCommunicator::NodeReduceInit(void)
+{
+  node_reduce          = 0;
+  communicator_leaders = MPI_COMM_NULL;
+  node_reduce_win      = MPI_WIN_NULL;
+#if !defined(GRID_MPI3_SHM_NONE)
+  if ( !NodeAwareReductions ) return; // --comms-flat-reductions; no window
+
+  // Collective decision: all ranks take the same path
+  int maxshm = ShmSize;
+  MPI_Allreduce(MPI_IN_PLACE,&maxshm,1,MPI_INT,MPI_MAX,communicator);
+  if ( maxshm == 1 ) return;
+
+  int leader = (ShmRank==0) ? 0 : MPI_UNDEFINED;
+  int ierr = MPI_Comm_split(communicator,leader,_processor,&communicator_leaders);
+  assert(ierr==0);
+
+  void *base;
+  ierr = MPI_Win_allocate_shared(NodeReduceBytes,1,MPI_INFO_NULL,ShmComm,&base,&node_reduce_win);
+  assert(ierr==0);
+  node_reduce_bufs.resize(ShmSize);
+  for(int r=0;r<ShmSize;r++){
+    MPI_Aint size;
+    int disp;
+    ierr = MPI_Win_shared_query(node_reduce_win,r,&size,&disp,&node_reduce_bufs[r]);
+    assert(ierr==0);
+  }
+  MPI_Win_lock_all(MPI_MODE_NOCHECK,node_reduce_win);
+  node_reduce = 1;
+#endif
+}
+void CartesianCommunicator::NodeReduceFree(void)
+{
+  if ( node_reduce_win != MPI_WIN_NULL ) {
+    MPI_Win_unlock_all(node_reduce_win);
+    MPI_Win_free(&node_reduce_win);
+  }
+  if ( communicator_leaders != MPI_COMM_NULL ) MPI_Comm_free(&communicator_leaders);
+  node_reduce = 0;
+}
+void CartesianCommunicator::NodeReduceSync(void)
+{
+  MPI_Win_sync(node_reduce_win);
+  MPI_Barrier(ShmComm);
+  MPI_Win_sync(node_reduce_win);
+}
+////////////////////////////////////////////////////////////////////////////
+// Each rank's part of the window: [contribution | result]. Leaders sum the
+// node in fixed rank order, allreduce over leaders and publish the result.
+// A rank rewrites its contribution only after the leader has read it, and
+// the leader rewrites the result only once everyone has read the last one.
+////////////////////////////////////////////////////////////////////////////
+template<class T> void CartesianCommunicator::NodeReduceSumVector(T *d,int N,MPI_Datatype type)
+{
+  const int chunk = NodeReduceBytes/(2*sizeof(T));
+  T *mine   = (T *)node_reduce_bufs[ShmRank];
+  T *result = (T *)node_reduce_bufs[0] + chunk;
+  for(int n0=0;n0<N;n0+=chunk){
+    int n = std::min(chunk,N-n0);
+    memcpy(mine,&d[n0],n*sizeof(T));
+    NodeReduceSync();
+    if ( ShmRank == 0 ) {
+      for(int r=1;r<ShmSize;r++){
+	T *theirs = (T *)node_reduce_bufs[r];
+	for(int i=0;i<n;i++) mine[i] += theirs[i];
+      }
+      int ierr=MPI_Allreduce(MPI_IN_PLACE,mine,n,type,MPI_SUM,communicator_leaders);
+      assert(ierr==0);
+      memcpy(result,mine,n*sizeof(T));
+    }
+    NodeReduceSync();
+    memcpy(&d[n0],result,n*sizeof(T));
+  }
+}
+
 void CartesianCommunicator::GlobalSum(uint32_t &u){
   int ierr=MPI_Allreduce(MPI_IN_PLACE,&u,1,MPI_UINT32_T,MPI_SUM,communicator);
   assert(ierr==0);
 }
 void CartesianCommunicator::GlobalSum(uint64_t &u){
-  int ierr=MPI_Allreduce(MPI_IN_PLACE,&u,1,MPI_UINT64_T,MPI_SUM,communicator);
-  assert(ierr==0);
+  GlobalSumVector(&u,1);
 }
 void CartesianCommunicator::GlobalSumVector(uint64_t* u,int N){
+  if ( node_reduce && NodeAwareReductions ) {
+    NodeReduceSumVector(u,N,MPI_UINT64_T);
+    return;
+  }
   int ierr=MPI_Allreduce(MPI_IN_PLACE,u,N,MPI_UINT64_T,MPI_SUM,communicator);
   assert(ierr==0);
 }
@@ -286,24 +373,56 @@ void CartesianCommunicator::GlobalMax(double &d)
   assert(ierr==0);
 }
 void CartesianCommunicator::GlobalSum(float &f){
-  int ierr=MPI_Allreduce(MPI_IN_PLACE,&f,1,MPI_FLOAT,MPI_SUM,communicator);
-  assert(ierr==0);
+  GlobalSumVector(&f,1);
 }
 void CartesianCommunicator::GlobalSumVector(float *f,int N)
 {
+  if ( ReproducibleSum::Enabled ) {
+    std::vector<double> d(f,f+N);
+    ReproducibleSum::GlobalSumVector(this,&d[0],N);
+    for(int n=0;n<N;n++) f[n] = d[n];
+    return;
+  }
+  if ( node_reduce && NodeAwareReductions ) {
+    NodeReduceSumVector(f,N,MPI_FLOAT);
+    return;
+  }
   int ierr=MPI_Allreduce(MPI_IN_PLACE,f,N,MPI_FLOAT,MPI_SUM,communicator);
   assert(ierr==0);
 }
 void CartesianCommunicator::GlobalSum(double &d)
 {
-  int ierr = MPI_Allreduce(MPI_IN_PLACE,&d,1,MPI_DOUBLE,MPI_SUM,communicator);
-  assert(ierr==0);
+  GlobalSumVector(&d,1);
 }
 void CartesianCommunicator::GlobalSumVector(double *d,int N)
 {
+  if ( ReproducibleSum::Enabled ) {
+    ReproducibleSum::GlobalSumVector(this,d,N);
+    return;
+  }
+  if ( node_reduce && NodeAwareReductions ) {
+    NodeReduceSumVector(d,N,MPI_DOUBLE);
+    return;
+  }
   int ierr = MPI_Allreduce(MPI_IN_PLACE,d,N,MPI_DOUBLE,MPI_SUM,communicator);
   assert(ierr==0);
 }
+void CartesianCommunicator::GlobalSumVectorBegin(double *d,int N,CommsRequest_t &req)
+{
+  if ( ReproducibleSum::Enabled ) { // blocking; nothing left to overlap
+    ReproducibleSum::GlobalSumVector(this,d,N);
+    req = MPI_REQUEST_NULL;
+    return;
+  }
+  int ierr = MPI_Iallreduce(MPI_IN_PLACE,d,N,MPI_DOUBLE,MPI_SUM,communicator,&req);
+  assert(ierr==0);
+}
+void CartesianCommunicator::GlobalSumWait(CommsRequest_t &req)
+{
+  MPI_Status status;
+  int ierr = MPI_Wait(&req,&status);
+  assert(ierr==0);
+}
 // Basic Halo comms primitive
 void CartesianCommunicator::SendToRecvFrom(void *xmit,
 					   int dest,
@@ -403,6 +522,85 @@ void CartesianCommunicator::StencilSendToRecvFromComplete(std::vector<CommsReque
   assert(ierr==0);
   list.resize(0);
 }
+double CartesianCommunicator::StencilSendToRecvFromPersistentInit(std::vector<CommsRequest_t> &list,
+								  void *xmit,
+								  int dest,
+								  void *recv,
+								  int from,
+								  int bytes,int dir)
+{
+  int ncomm  =communicator_halo.size();
+  int commdir=dir%ncomm;
+
+  MPI_Request xrq;
+  MPI_Request rrq;
+
+  int ierr;
+  int gdest = ShmRanks[dest];
+  int gfrom = ShmRanks[from];
+  int gme   = ShmRanks[_processor];
+
+  assert(dest != _processor);
+  assert(from != _processor);
+  assert(gme  == ShmRank);
+  double off_node_bytes=0.0;
+  int tag;
+
+  // Same matching as StencilSendToRecvFromBegin so persistent and
+  // one shot exchanges can be mixed
+  if ( gfrom ==MPI_UNDEFINED) {
+    tag= dir+from*32;
+    ierr=MPI_Recv_init(recv, bytes, MPI_CHAR,from,tag,communicator_halo[commdir],&rrq);
+    assert(ierr==0);
+    list.push_back(rrq);
+    off_node_bytes+=bytes;
+  }
+
+  if ( gdest == MPI_UNDEFINED ) {
+    tag= dir+_processor*32;
+    ierr =MPI_Send_init(xmit, bytes, MPI_CHAR,dest,tag,communicator_halo[commdir],&xrq);
+    assert(ierr==0);
+    list.push_back(xrq);
+    off_node_bytes+=bytes;
+  }
+
+  return off_node_bytes;
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentStart(std::vector<CommsRequest_t> &list,int dir)
+{
+  int nreq=list.size();
+
+  if (nreq==0) return;
+
+  int ierr = MPI_Startall(nreq,&list[0]);
+  assert(ierr==0);
+
+  if ( CommunicatorPolicy == CommunicatorPolicySequential ) {
+    this->StencilSendToRecvFromPersistentComplete(list,dir);
+  }
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentComplete(std::vector<CommsRequest_t> &list,int dir)
+{
+  int nreq=list.size();
+
+  if (nreq==0) return;
+
+  // Waiting leaves persistent requests inactive but allocated, ready to restart
+  std::vector<MPI_Status> status(nreq);
+  int ierr = MPI_Waitall(nreq,&list[0],&status[0]);
+  assert(ierr==0);
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentFree(std::vector<CommsRequest_t> &list)
+{
+  int MPI_is_finalised;
+  MPI_Finalized(&MPI_is_finalised);
+  if ( !MPI_is_finalised ) {
+    for(int i=0;i<list.size();i++){
+      if ( list[i] != MPI_REQUEST_NULL ) MPI_Request_free(&list[i]);
+    }
+  }
+  list.resize(0);
+}
 void CartesianCommunicator::StencilBarrier(void)
 {
   MPI_Barrier  (ShmComm);
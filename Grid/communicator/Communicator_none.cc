@@ -73,6 +73,8 @@ void CartesianCommunicator::GlobalSum(float &){}
 void CartesianCommunicator::GlobalSumVector(float *,int N){}
 void CartesianCommunicator::GlobalSum(double &){}
 void CartesianCommunicator::GlobalSumVector(double *,int N){}
+void CartesianCommunicator::GlobalSumVectorBegin(double *,int N,CommsRequest_t &req){ req=0; }
+void CartesianCommunicator::GlobalSumWait(CommsRequest_t &req){}
 void CartesianCommunicator::GlobalSum(uint32_t &){}
 void CartesianCommunicator::GlobalSum(uint64_t &){}
 void CartesianCommunicator::GlobalSumVector(uint64_t *,int N){}
@@ -131,6 +133,26 @@ void CartesianCommunicator::StencilSendToRecvFromComplete(std::vector<CommsReque
 {
 }
 
+double CartesianCommunicator::StencilSendToRecvFromPersistentInit(std::vector<CommsRequest_t> &list,
+								  void *xmit,
+								  int xmit_to_rank,
+								  void *recv,
+								  int recv_from_rank,
+								  int bytes, int dir)
+{
+  return 2.0*bytes;
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentStart(std::vector<CommsRequest_t> &list,int dir)
+{
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentComplete(std::vector<CommsRequest_t> &list,int dir)
+{
+}
+void CartesianCommunicator::StencilSendToRecvFromPersistentFree(std::vector<CommsRequest_t> &list)
+{
+  list.resize(0);
+}
+
 void CartesianCommunicator::StencilBarrier(void){};
 
 NAMESPACE_END(Grid);
@@ -0,0 +1,168 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/communicator/ReproducibleSum.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <cmath>
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Exact (superaccumulator) summation of doubles.
+//
+// The accumulator is a fixed point integer wide enough for every finite
+// double: 70 bins of 32 bits, each held in an int64 so that 2^31 additions
+// fit before carries must be propagated. A double is split into (at most)
+// three 32 bit pieces added to consecutive bins. Integer addition is
+// associative, so the sum -- and the double it is finally rounded to -- is
+// bitwise independent of thread count, SIMD width, MPI layout and reduction
+// order. Accumulators of different ranks are combined by an integer
+// allreduce.
+//
+// Enabled by --reproducible-sums, the global sums of Lattice_reduction.h
+// (sum, innerProduct, norm2, axpby_norm_fast, innerProductNorm) and the
+// communicator's floating point GlobalSum take this path. Each site value
+// costs a frexp and three integer adds instead of one floating point add,
+// and each reduction moves 70 words per result through the allreduce; see
+// benchmarks/Benchmark_reduction.
+////////////////////////////////////////////////////////////////////////////////
+class ReproducibleSum {
+public:
+  static int Enabled;
+
+  static const int BinBits = 32;
+  static const int Bias    = 1152;   // bit 0 of bin 0 is 2^-Bias, below the least denormal
+  static const int Nbin    = 70;     // up to 2^(32*Nbin-Bias), above DBL_MAX with headroom
+
+  int64_t bin[Nbin];
+  int64_t count;     // additions since the last carry propagation
+  int64_t special[3];// +inf, -inf, nan counts, kept aside
+
+  ReproducibleSum() { Zero(); };
+
+  void Zero(void)
+  {
+    for(int b=0;b<Nbin;b++) bin[b]=0;
+    count   = 0;
+    for(int s=0;s<3;s++) special[s]=0;
+  }
+
+  inline void Add(double d)
+  {
+    if ( d == 0.0 ) return;
+    if ( !std::isfinite(d) ) { special[ std::isnan(d) ? 2 : (d<0) ]++; return; }
+    int e;
+    double f = std::frexp(std::fabs(d),&e);             // |d| = f 2^e, f in [0.5,1)
+    uint64_t m = (uint64_t)std::ldexp(f,53);            // exact 53 bit mantissa
+    int p  = e-53+Bias;                                 // bit position of the mantissa lsb
+    int b  = p/BinBits;
+    int sh = p%BinBits;
+    unsigned __int128 v = ((unsigned __int128)m) << sh;
+    int64_t lo = (int64_t)( v      & 0xFFFFFFFFULL);
+    int64_t mi = (int64_t)((v>>32) & 0xFFFFFFFFULL);
+    int64_t hi = (int64_t)( v>>64);
+    if ( d < 0 ) { lo=-lo; mi=-mi; hi=-hi; }
+    bin[b]  +=lo;
+    bin[b+1]+=mi;
+    bin[b+2]+=hi;
+    if ( ++count == (1LL<<30) ) Normalise();
+  }
+
+  // Propagate carries; bins below the top in [0,2^32), top bin carries the sign
+  void Normalise(void)
+  {
+    for(int b=0;b<Nbin-1;b++){
+      int64_t c = bin[b] >> BinBits;  // arithmetic shift: floor division
+      bin[b]   -= c * (1LL<<BinBits);
+      bin[b+1] += c;
+    }
+    count = 0;
+  }
+
+  void Merge(ReproducibleSum &other)
+  {
+    Normalise();
+    other.Normalise();
+    for(int b=0;b<Nbin;b++) bin[b] += other.bin[b];
+    for(int s=0;s<3;s++) special[s] += other.special[s];
+    count = 1;
+  }
+
+  // Canonical form makes the rounding a function of the exact value only
+  double Value(void)
+  {
+    if ( special[2] || (special[0] && special[1]) ) return std::nan("");
+    if ( special[0] ) return  HUGE_VAL;
+    if ( special[1] ) return -HUGE_VAL;
+    Normalise();
+    double sign = 1.0;
+    if ( bin[Nbin-1] < 0 ) {
+      for(int b=0;b<Nbin;b++) bin[b] = -bin[b];
+      Normalise();
+      sign = -1.0;
+    }
+    double r = 0.0;
+    for(int b=Nbin-1;b>=0;b--){
+      if ( bin[b] ) r += std::ldexp((double)bin[b],b*BinBits-Bias);
+    }
+    if ( sign < 0 ) {
+      for(int b=0;b<Nbin;b++) bin[b] = -bin[b];
+      Normalise();
+    }
+    return sign*r;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Sum a set of accumulators over all ranks with one integer allreduce
+  ////////////////////////////////////////////////////////////////////////////
+  static void GlobalSum(CartesianCommunicator *comm,ReproducibleSum *acc,int N)
+  {
+    const int words = Nbin+3;
+    std::vector<uint64_t> buf(N*words);
+    for(int n=0;n<N;n++){
+      acc[n].Normalise();
+      // two's complement sums wrap exactly as int64 would
+      for(int b=0;b<Nbin;b++) buf[n*words+b]      = (uint64_t)acc[n].bin[b];
+      for(int s=0;s<3;s++)    buf[n*words+Nbin+s] = (uint64_t)acc[n].special[s];
+    }
+    comm->GlobalSumVector(&buf[0],N*words);
+    for(int n=0;n<N;n++){
+      for(int b=0;b<Nbin;b++) acc[n].bin[b]     = (int64_t)buf[n*words+b];
+      for(int s=0;s<3;s++)    acc[n].special[s] = (int64_t)buf[n*words+Nbin+s];
+      acc[n].count = 1;
+    }
+  }
+
+  // Drop in for GlobalSumVector(double *) in reproducible mode
+  static void GlobalSumVector(CartesianCommunicator *comm,double *d,int N)
+  {
+    std::vector<ReproducibleSum> acc(N);
+    for(int n=0;n<N;n++) acc[n].Add(d[n]);
+    GlobalSum(comm,&acc[0],N);
+    for(int n=0;n<N;n++) d[n] = acc[n].Value();
+  }
+};
+
+NAMESPACE_END(Grid);
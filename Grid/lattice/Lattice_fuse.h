@@ -0,0 +1,244 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/lattice/Lattice_fuse.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Fused sweeps: several lattice assignments and reductions in a single pass over sites.
+//
+//    fuse( fuse_assign(p, r + b*p),
+//          fuse_assign(x, x + a*p),
+//          fuse_assign(r, r - a*q),
+//          fuse_norm2(cp, r) );
+//
+// The statements are applied in order at each site. Expressions are site local, so
+// every statement sees the values written by the earlier ones and the result is the
+// same as issuing them one after the other; each field is however streamed once.
+// All reductions in a sweep share one global sum; passing a GlobalSumHandle first
+// defers it so that it can be batched with others and overlapped with local work.
+//
+// When the sweep carries a reduction it runs one vector object per thread, as
+// axpby_norm_fast does, so that the double precision site sums are whole vectors.
+// Sweeps of pure assignments run coalesced over SIMT lanes like Lattice::operator=.
+//////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////
+// Device side kernels
+////////////////////////////////////////////
+template<class vobj,class Expr> struct FuseAssignKernel {
+  LatticeView<vobj> lhs_v;
+  Expr expr;
+  accelerator_inline void operator()(uint64_t ss) const {
+    lhs_v[ss] = vecEval(ss,expr);
+  }
+  accelerator_inline void Coalesced(uint64_t ss) const {
+    auto tmp = eval(ss,expr);
+    coalescedWrite(lhs_v[ss],tmp);
+  }
+};
+template<class inner_t,class Left,class Right> struct FuseInnerKernel {
+  inner_t *inner;
+  Left  left;
+  Right right;
+  accelerator_inline void operator()(uint64_t ss) const {
+    inner[ss] = innerProductD(vecEval(ss,left),vecEval(ss,right));
+  }
+  accelerator_inline void Coalesced(uint64_t ss) const { (*this)(ss); } // never taken
+};
+
+template<class... Kernels> struct FuseKernelList;
+template<> struct FuseKernelList<> {
+  accelerator_inline void operator()(uint64_t ss) const {};
+  accelerator_inline void Coalesced(uint64_t ss) const {};
+};
+template<class Kernel,class... Rest> struct FuseKernelList<Kernel,Rest...> {
+  Kernel                   head;
+  FuseKernelList<Rest...>  tail;
+  FuseKernelList(const Kernel &k,const Rest &... r) : head(k), tail(r...) {};
+  accelerator_inline void operator()(uint64_t ss) const { head(ss); tail(ss); };
+  accelerator_inline void Coalesced(uint64_t ss) const { head.Coalesced(ss); tail.Coalesced(ss); };
+};
+
+////////////////////////////////////////////
+// Host side statements
+////////////////////////////////////////////
+template<class vobj,class _Expr> class FuseAssign {
+public:
+  typedef typename ViewMap<_Expr>::Type Expr;
+  typedef FuseAssignKernel<vobj,Expr> Kernel;
+  enum { Nsimd = vobj::Nsimd() };
+
+  Lattice<vobj> &lhs;
+  Kernel kernel;
+
+  FuseAssign(Lattice<vobj> &_lhs,const _Expr &_expr) : lhs(_lhs), kernel{LatticeView<vobj>(_lhs),Expr(_expr)} {};
+
+  int Reductions(void) { return 0; };
+  void Open(GridBase *&grid)
+  {
+    GridBase *egrid(nullptr);
+    GridFromExpression(egrid,kernel.expr);
+    assert(egrid!=nullptr);
+    conformable(lhs.Grid(),egrid);
+    if ( grid ) conformable(grid,egrid);
+    grid = egrid;
+
+    int cb=-1;
+    CBFromExpression(cb,kernel.expr);
+    assert( (cb==Odd) || (cb==Even));
+    lhs.Checkerboard() = cb;
+
+    ExpressionViewOpen(kernel.expr);
+    kernel.lhs_v.ViewOpen(AcceleratorWrite);
+  }
+  void Close(void)
+  {
+    kernel.lhs_v.ViewClose();
+    ExpressionViewClose(kernel.expr);
+  }
+  void Queue(GlobalSumHandle &sums,uint64_t sites) {};
+};
+
+template<class _Left,class _Right> class FuseInner {
+public:
+  typedef typename ViewMap<_Left>::Type  Left;
+  typedef typename ViewMap<_Right>::Type Right;
+  typedef decltype(innerProductD(vecEval(0,std::declval<Left>()),vecEval(0,std::declval<Right>()))) inner_t;
+  typedef FuseInnerKernel<inner_t,Left,Right> Kernel;
+  enum { Nsimd = 1 };
+
+  ComplexD *ip;
+  RealD    *nrm;
+  GridBase *grid;
+  Vector<inner_t> inner_tmp;
+  Kernel kernel;
+
+  FuseInner(ComplexD *_ip,RealD *_nrm,const _Left &_left,const _Right &_right)
+    : ip(_ip), nrm(_nrm), grid(nullptr), kernel{nullptr,Left(_left),Right(_right)} {};
+
+  int Reductions(void) { return 1; };
+  void Open(GridBase *&sweep)
+  {
+    GridBase *egrid(nullptr);
+    GridFromExpression(egrid,kernel.left);
+    GridFromExpression(egrid,kernel.right);
+    assert(egrid!=nullptr);
+    if ( sweep ) conformable(sweep,egrid);
+    sweep = grid = egrid;
+
+    inner_tmp.resize(grid->oSites());
+    kernel.inner = &inner_tmp[0];
+    ExpressionViewOpen(kernel.left);
+    ExpressionViewOpen(kernel.right);
+  }
+  void Close(void)
+  {
+    ExpressionViewClose(kernel.left);
+    ExpressionViewClose(kernel.right);
+  }
+  void Queue(GlobalSumHandle &sums,uint64_t sites)
+  {
+    if ( ReproducibleSum::Enabled ) {
+      // already global; nothing goes on the handle
+      ComplexD global = TensorRemove(sumReproducible(grid,&inner_tmp[0],sites));
+      if ( ip  ) *ip  = global;
+      if ( nrm ) *nrm = real(global);
+      return;
+    }
+    ComplexD local = TensorRemove(sum(&inner_tmp[0],sites));
+    if ( ip  ) { *ip  = local;       sums.Add(*ip,*ip);   }
+    if ( nrm ) { *nrm = real(local); sums.Add(*nrm,*nrm); }
+  }
+};
+
+template<class vobj,class Expr> inline FuseAssign<vobj,Expr> fuse_assign(Lattice<vobj> &lhs,const Expr &expr)
+{
+  return FuseAssign<vobj,Expr>(lhs,expr);
+}
+template<class Left,class Right> inline FuseInner<Left,Right> fuse_innerProduct(ComplexD &ip,const Left &left,const Right &right)
+{
+  return FuseInner<Left,Right>(&ip,nullptr,left,right);
+}
+template<class Arg> inline FuseInner<Arg,Arg> fuse_norm2(RealD &nrm,const Arg &arg)
+{
+  return FuseInner<Arg,Arg>(nullptr,&nrm,arg,arg);
+}
+
+////////////////////////////////////////////
+// Run the sweep
+////////////////////////////////////////////
+template<class... Statements> inline GridBase *FuseSweep(Statements &... stmts)
+{
+  typedef FuseKernelList<typename std::decay<Statements>::type::Kernel...> KernelList;
+
+  GridBase *grid(nullptr);
+  int nred = 0;
+  int nsimd = 0;
+  int dummy[] = { 0, ( stmts.Open(grid), nred+=stmts.Reductions(), 0 )... };
+  int simd [] = { 0, ( nsimd = std::max(nsimd,(int)std::decay<Statements>::type::Nsimd), 0 )... };
+  (void)dummy; (void)simd;
+  assert(grid!=nullptr);
+
+  const uint64_t sites = grid->oSites();
+  KernelList kernels(stmts.kernel...);
+  if ( nred ) {
+    accelerator_for(ss,sites,1,{
+      kernels(ss);
+    });
+  } else {
+    accelerator_for(ss,sites,nsimd,{
+      kernels.Coalesced(ss);
+    });
+  }
+  int close[] = { 0, ( stmts.Close(), 0 )... };
+  (void)close;
+  return grid;
+}
+
+//////////////////////////////////////////////////////////////////
+// Reductions are queued on the handle and land on sums.Wait();
+// the caller issues sums.Begin() and may overlap local work
+//////////////////////////////////////////////////////////////////
+template<class... Statements> inline void fuse(GlobalSumHandle &sums,Statements &&... stmts)
+{
+  GridBase *grid = FuseSweep(stmts...);
+  const uint64_t sites = grid->oSites();
+  int queue[] = { 0, ( stmts.Queue(sums,sites), 0 )... };
+  (void)queue;
+}
+
+template<class... Statements> inline void fuse(Statements &&... stmts)
+{
+  GridBase *grid = FuseSweep(stmts...);
+  const uint64_t sites = grid->oSites();
+  GlobalSumHandle sums(grid);
+  int queue[] = { 0, ( stmts.Queue(sums,sites), 0 )... };
+  (void)queue;
+  sums.Wait();
+}
+
+NAMESPACE_END(Grid);
@@ -143,9 +143,54 @@ inline typename vobj::scalar_objectD sumD(const vobj *arg, Integer osites)
 #endif  
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reproducible mode (--reproducible-sums): every real word of every SIMD lane of every site is added
+// exactly into per thread superaccumulators, which are merged and summed over ranks. The result is the
+// global sum, bitwise independent of threads, SIMD width and MPI layout.
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+inline typename vobj::scalar_object sumReproducible(GridBase *grid,const vobj *arg, Integer osites)
+{
+  typedef typename vobj::scalar_object  sobj;
+  typedef typename vobj::scalar_type    scalar_type;
+  typedef typename GridTypeMapper<scalar_type>::Realified real_type;
+
+  const int Nsimd   = vobj::Nsimd();
+  const int words   = sizeof(sobj)/sizeof(real_type);
+  const int nthread = GridThread::GetThreads();
+
+  std::vector<std::vector<ReproducibleSum> > acc(nthread,std::vector<ReproducibleSum>(words));
+  thread_for(thr,nthread, {
+    int nwork, mywork, myoff;
+    nwork = osites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    ExtractBuffer<sobj> extracted(Nsimd);
+    for(int ss=myoff;ss<mywork+myoff; ss++){
+      extract(arg[ss],extracted);
+      for(int l=0;l<Nsimd;l++){
+	real_type *w = (real_type *)&extracted[l];
+	for(int i=0;i<words;i++) acc[thr][i].Add(w[i]);
+      }
+    }
+  });
+  for(int thr=1;thr<nthread;thr++){
+    for(int i=0;i<words;i++) acc[0][i].Merge(acc[thr][i]);
+  }
+  ReproducibleSum::GlobalSum(grid,&acc[0][0],words);
+
+  sobj ssum;
+  real_type *w = (real_type *)&ssum;
+  for(int i=0;i<words;i++) w[i] = acc[0][i].Value();
+  return ssum;
+}
+
 template<class vobj>
 inline typename vobj::scalar_object sum(const Lattice<vobj> &arg)
 {
+  if ( ReproducibleSum::Enabled ) {
+    autoView(arg_v, arg, CpuRead);
+    return sumReproducible(arg.Grid(),&arg_v[0],arg.Grid()->oSites());
+  }
 #if defined(GRID_CUDA)||defined(GRID_HIP)
   autoView( arg_v, arg, AcceleratorRead);
   Integer osites = arg.Grid()->oSites();
@@ -193,22 +238,14 @@ template<class vobj> inline RealD maxLocalNorm2(const Lattice<vobj> &arg)
   return max;
 }
 
-// Double inner product
+// Double inner product, per site
 template<class vobj>
-inline ComplexD rankInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right)
+inline void siteInnerProduct(Vector<decltype(innerProductD(vobj(),vobj()))> &inner_tmp,
+			     const Lattice<vobj> &left,const Lattice<vobj> &right)
 {
-  typedef typename vobj::scalar_type scalar_type;
-  typedef typename vobj::vector_typeD vector_type;
-  ComplexD  nrm;
-  
   GridBase *grid = left.Grid();
-
-  const uint64_t nsimd = grid->Nsimd();
   const uint64_t sites = grid->oSites();
-  
-  // Might make all code paths go this way.
-  typedef decltype(innerProductD(vobj(),vobj())) inner_t;
-  Vector<inner_t> inner_tmp(sites);
+  inner_tmp.resize(sites);
   auto inner_tmp_v = &inner_tmp[0];
     
   {
@@ -222,18 +259,63 @@ inline ComplexD rankInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &
 	inner_tmp_v[ss]=innerProductD(x_l,y_l);
     });
   }
+}
+
+template<class vobj>
+inline ComplexD rankInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right)
+{
+  ComplexD  nrm;
+  
+  typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+  Vector<inner_t> inner_tmp;
+  siteInnerProduct(inner_tmp,left,right);
 
   // This is in single precision and fails some tests
-  auto anrm = sum(inner_tmp_v,sites);  
+  auto anrm = sum(&inner_tmp[0],inner_tmp.size());  
   nrm = anrm;
   return nrm;
 }
 
+// Global and reproducible; see sumReproducible
+template<class vobj>
+inline ComplexD reproducibleInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right)
+{
+  typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+  Vector<inner_t> inner_tmp;
+  siteInnerProduct(inner_tmp,left,right);
+  return TensorRemove(sumReproducible(left.Grid(),&inner_tmp[0],inner_tmp.size()));
+}
+
+//////////////////////////////////////////////////////////////////////
+// Queue the local part on a GlobalSumHandle; result is valid after
+// sums.Wait(), so several reductions share one allreduce. Reproducible
+// sums are exact over ranks already and are not queued.
+//////////////////////////////////////////////////////////////////////
+template<class vobj>
+inline void innerProduct(GlobalSumHandle &sums,ComplexD &ip,const Lattice<vobj> &left,const Lattice<vobj> &right) {
+  if ( ReproducibleSum::Enabled ) {
+    ip = reproducibleInnerProduct(left,right);
+    return;
+  }
+  ip = rankInnerProduct(left,right);
+  sums.Add(ip,ip);
+}
+template<class vobj>
+inline void norm2(GlobalSumHandle &sums,RealD &nrm,const Lattice<vobj> &arg) {
+  if ( ReproducibleSum::Enabled ) {
+    nrm = real(reproducibleInnerProduct(arg,arg));
+    return;
+  }
+  nrm = real(rankInnerProduct(arg,arg));
+  sums.Add(nrm,nrm);
+}
+
 template<class vobj>
 inline ComplexD innerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right) {
-  GridBase *grid = left.Grid();
-  ComplexD nrm = rankInnerProduct(left,right);
-  grid->GlobalSum(nrm);
+  GlobalSumHandle sums(left.Grid());
+  ComplexD nrm;
+  innerProduct(sums,nrm,left,right);
+  sums.Wait();
   return nrm;
 }
 
@@ -280,6 +362,9 @@ axpby_norm_fast(Lattice<vobj> &z,sobj a,sobj b,const Lattice<vobj> &x,const Latt
       inner_tmp_v[ss]=innerProductD(tmp,tmp);
       z_v[ss]=tmp;
   });
+  if ( ReproducibleSum::Enabled ) {
+    return real(TensorRemove(sumReproducible(grid,inner_tmp_v,sites)));
+  }
   nrm = real(TensorRemove(sum(inner_tmp_v,sites)));
   grid->GlobalSum(nrm);
   return nrm; 
@@ -316,6 +401,11 @@ innerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Latti
       });
   }
 
+  if ( ReproducibleSum::Enabled ) {
+    ip  = TensorRemove(sumReproducible(grid,inner_tmp_v,sites));
+    nrm = real(TensorRemove(sumReproducible(grid,norm_tmp_v,sites)));
+    return;
+  }
   tmp[0] = TensorRemove(sum(inner_tmp_v,sites));
   tmp[1] = TensorRemove(sum(norm_tmp_v,sites));
 
@@ -353,16 +443,22 @@ inline auto sum(const LatticeTrinaryExpression<Op,T1,T2,T3> & expr)
 // sliceSum, sliceInnerProduct, sliceAxpy, sliceNorm etc...
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<typename vobj::scalar_object> &result,int orthogdim)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Local part of N slice sums in one sweep over the sites. kernel(ss,acc) adds the N site values of outer
+// site ss to acc[0..N-1]. Sites are split into contiguous blocks, one per thread, each accumulating into its
+// own per plane partials padded to whole cache lines; blocks and SIMD lanes are then reduced per timeslice.
+// result[n][t] holds this rank's slices and zero elsewhere, ready for a single global sum.
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<class robj,class Kernel>
+inline void sliceSumLocal(GridBase *grid,int orthogdim,int N,Kernel kernel,
+			  std::vector<std::vector<typename robj::scalar_object> > &result)
 {
   ///////////////////////////////////////////////////////
   // FIXME precision promoted summation
   // may be important for correlation functions
   // But easily avoided by using double precision fields
   ///////////////////////////////////////////////////////
-  typedef typename vobj::scalar_object sobj;
-  typedef typename vobj::scalar_object::scalar_type scalar_type;
-  GridBase  *grid = Data.Grid();
+  typedef typename robj::scalar_object sobj;
   assert(grid!=NULL);
 
   const int    Nd = grid->_ndimension;
@@ -374,149 +470,221 @@ template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<
   int fd=grid->_fdimensions[orthogdim];
   int ld=grid->_ldimensions[orthogdim];
   int rd=grid->_rdimensions[orthogdim];
+  int ostride=grid->_ostride[orthogdim];
+  uint64_t osites=grid->oSites();
+
+  // Per block partials [block][r][n]; no two blocks share a cache line
+  const uint64_t line = 64;
+  uint64_t words = rd*N;
+  while ( (words*sizeof(robj)) % line ) words++;
+  uint64_t nblock = std::min((uint64_t)thread_max(),osites);
+  Vector<robj> lvSum(nblock*words); 
+
+  thread_for( blk,nblock, {
+    robj *partial = &lvSum[blk*words];
+    for(uint64_t w=0;w<words;w++) partial[w]=Zero();
+    uint64_t s0 = (osites* blk   )/nblock;
+    uint64_t s1 = (osites*(blk+1))/nblock;
+    for(uint64_t ss=s0;ss<s1;ss++){
+      int r = (ss/ostride)%rd;
+      kernel(ss,&partial[r*N]);
+    }
+  });
 
-  Vector<vobj> lvSum(rd); // will locally sum vectors first
-  Vector<sobj> lsSum(ld,Zero());                    // sum across these down to scalars
-  ExtractBuffer<sobj> extracted(Nsimd);                  // splitting the SIMD
-
-  result.resize(fd); // And then global sum to return the same vector to every node 
-  for(int r=0;r<rd;r++){
-    lvSum[r]=Zero();
-  }
+  // Sum across blocks and simd lanes in the plane, breaking out orthog dir.
+  Vector<sobj> lsSum(ld*N,Zero());
+  ExtractBuffer<sobj> extracted(Nsimd);
+  Coordinate icoor(Nd);
+  for(int rt=0;rt<rd;rt++){
+    for(int n=0;n<N;n++){
+      robj tot = lvSum[rt*N+n];
+      for(uint64_t blk=1;blk<nblock;blk++) tot = tot + lvSum[blk*words+rt*N+n];
 
-  int e1=    grid->_slice_nblock[orthogdim];
-  int e2=    grid->_slice_block [orthogdim];
-  int stride=grid->_slice_stride[orthogdim];
+      extract(tot,extracted);
 
-  // sum over reduced dimension planes, breaking out orthog dir
-  // Parallel over orthog direction
-  autoView( Data_v, Data, CpuRead);
-  thread_for( r,rd, {
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
-	int ss= so+n*stride+b;
-	lvSum[r]=lvSum[r]+Data_v[ss];
+      for(int idx=0;idx<Nsimd;idx++){
+	grid->iCoorFromIindex(icoor,idx);
+	int ldx =rt+icoor[orthogdim]*rd;
+	lsSum[n*ld+ldx]=lsSum[n*ld+ldx]+extracted[idx];
       }
     }
-  });
-
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  Coordinate icoor(Nd);
+  }
 
-  for(int rt=0;rt<rd;rt++){
+  // This rank's planes; others zero for the global sum
+  result.resize(N);
+  for(int n=0;n<N;n++){
+    result[n].resize(fd);
+    for(int t=0;t<fd;t++){
+      int pt = t/ld; // processor plane
+      int lt = t%ld;
+      if ( pt == grid->_processor_coor[orthogdim] ) {
+	result[n][t]=lsSum[n*ld+lt];
+      } else {
+	result[n][t]=Zero();
+      }
+    }
+  }
+}
 
-    extract(lvSum[rt],extracted);
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Batched: all fields in one sweep, one allreduce for all of them (on the handle)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj> inline void sliceSum(GlobalSumHandle &sums,const std::vector<Lattice<vobj> > &Data,
+					  std::vector<std::vector<typename vobj::scalar_object> > &result,int orthogdim)
+{
+  typedef decltype(Data[0].View(CpuRead)) View;
+  int N = Data.size();
+  assert(N>0);
+  GridBase *grid = Data[0].Grid();
+
+  std::vector<View> Data_v;
+  for(int n=0;n<N;n++) {
+    conformable(grid,Data[n].Grid());
+    Data_v.push_back(Data[n].View(CpuRead));
+  }
+  sliceSumLocal<vobj>(grid,orthogdim,N,[&](uint64_t ss,vobj *acc) {
+    for(int n=0;n<N;n++) acc[n] = acc[n] + Data_v[n][ss];
+  },result);
+  for(int n=0;n<N;n++) Data_v[n].ViewClose();
 
-    for(int idx=0;idx<Nsimd;idx++){
+  for(int n=0;n<N;n++) sums.AddVector(&result[n][0],&result[n][0],result[n].size());
+}
 
-      grid->iCoorFromIindex(icoor,idx);
+template<class vobj> inline void sliceSum(const std::vector<Lattice<vobj> > &Data,
+					  std::vector<std::vector<typename vobj::scalar_object> > &result,int orthogdim)
+{
+  GlobalSumHandle sums(Data[0].Grid());
+  sliceSum(sums,Data,result,orthogdim);
+  sums.Wait();
+}
 
-      int ldx =rt+icoor[orthogdim]*rd;
+template<class vobj> inline void sliceSum(GlobalSumHandle &sums,const Lattice<vobj> &Data,std::vector<typename vobj::scalar_object> &result,int orthogdim)
+{
+  typedef typename vobj::scalar_object sobj;
+  GridBase  *grid = Data.Grid();
+  std::vector<std::vector<sobj> > lsum;
 
-      lsSum[ldx]=lsSum[ldx]+extracted[idx];
+  autoView( Data_v, Data, CpuRead);
+  sliceSumLocal<vobj>(grid,orthogdim,1,[&](uint64_t ss,vobj *acc) {
+    acc[0] = acc[0] + Data_v[ss];
+  },lsum);
 
-    }
-  }
-  
-  // sum over nodes.
-  for(int t=0;t<fd;t++){
-    int pt = t/ld; // processor plane
-    int lt = t%ld;
-    if ( pt == grid->_processor_coor[orthogdim] ) {
-      result[t]=lsSum[lt];
-    } else {
-      result[t]=Zero();
-    }
+  result = lsum[0];
+  sums.AddVector(&result[0],&result[0],result.size());
+}
 
-  }
-  scalar_type * ptr = (scalar_type *) &result[0];
-  int words = fd*sizeof(sobj)/sizeof(scalar_type);
-  grid->GlobalSumVector(ptr, words);
+template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<typename vobj::scalar_object> &result,int orthogdim)
+{
+  GlobalSumHandle sums(Data.Grid());
+  sliceSum(sums,Data,result,orthogdim);
+  sums.Wait();
 }
 
 template<class vobj>
 static void sliceInnerProductVector( std::vector<ComplexD> & result, const Lattice<vobj> &lhs,const Lattice<vobj> &rhs,int orthogdim) 
 {
   typedef typename vobj::vector_type   vector_type;
-  typedef typename vobj::scalar_type   scalar_type;
+  typedef iScalar<vector_type>         robj;
+  typedef typename robj::scalar_object sobj;
   GridBase  *grid = lhs.Grid();
-  assert(grid!=NULL);
   conformable(grid,rhs.Grid());
 
-  const int    Nd = grid->_ndimension;
-  const int Nsimd = grid->Nsimd();
-
-  assert(orthogdim >= 0);
-  assert(orthogdim < Nd);
-
-  int fd=grid->_fdimensions[orthogdim];
-  int ld=grid->_ldimensions[orthogdim];
-  int rd=grid->_rdimensions[orthogdim];
-
-  Vector<vector_type> lvSum(rd); // will locally sum vectors first
-  Vector<scalar_type > lsSum(ld,scalar_type(0.0));                    // sum across these down to scalars
-  ExtractBuffer<iScalar<scalar_type> > extracted(Nsimd);   // splitting the SIMD  
-
-  result.resize(fd); // And then global sum to return the same vector to every node for IO to file
-  for(int r=0;r<rd;r++){
-    lvSum[r]=Zero();
-  }
-
-  int e1=    grid->_slice_nblock[orthogdim];
-  int e2=    grid->_slice_block [orthogdim];
-  int stride=grid->_slice_stride[orthogdim];
-
+  std::vector<std::vector<sobj> > lsum;
   autoView( lhv, lhs, CpuRead);
   autoView( rhv, rhs, CpuRead);
-  thread_for( r,rd,{
-
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
-
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
-	int ss= so+n*stride+b;
-	vector_type vv = TensorRemove(innerProduct(lhv[ss],rhv[ss]));
-	lvSum[r]=lvSum[r]+vv;
-      }
-    }
-  });
-
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  Coordinate icoor(Nd);
-  for(int rt=0;rt<rd;rt++){
-
-    iScalar<vector_type> temp; 
-    temp._internal = lvSum[rt];
-    extract(temp,extracted);
-
-    for(int idx=0;idx<Nsimd;idx++){
-
-      grid->iCoorFromIindex(icoor,idx);
-
-      int ldx =rt+icoor[orthogdim]*rd;
+  sliceSumLocal<robj>(grid,orthogdim,1,[&](uint64_t ss,robj *acc) {
+    acc[0]._internal = acc[0]._internal + TensorRemove(innerProduct(lhv[ss],rhv[ss]));
+  },lsum);
+
+  // sum over nodes, all slices in one reduction
+  int fd = lsum[0].size();
+  result.resize(fd);
+  for(int t=0;t<fd;t++) result[t] = lsum[0][t]._internal;
+  GlobalSumHandle sums(grid);
+  sums.AddVector(&result[0],&result[0],fd);
+  sums.Wait();
+}
 
-      lsSum[ldx]=lsSum[ldx]+extracted[idx]._internal;
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Batched inner products, one sweep and one allreduce:
+//   result[n][t] = sum_{x in t} lhs[n]^dag rhs[n]
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+static void sliceInnerProductVector( std::vector<std::vector<ComplexD> > & result,
+				     const std::vector<Lattice<vobj> > &lhs,const std::vector<Lattice<vobj> > &rhs,int orthogdim) 
+{
+  typedef typename vobj::vector_type   vector_type;
+  typedef iScalar<vector_type>         robj;
+  typedef typename robj::scalar_object sobj;
+  typedef decltype(lhs[0].View(CpuRead)) View;
+  int N = lhs.size();
+  assert(N>0);
+  assert(rhs.size()==N);
+  GridBase *grid = lhs[0].Grid();
+
+  std::vector<View> lhv, rhv;
+  for(int n=0;n<N;n++) {
+    conformable(grid,lhs[n].Grid());
+    conformable(grid,rhs[n].Grid());
+    lhv.push_back(lhs[n].View(CpuRead));
+    rhv.push_back(rhs[n].View(CpuRead));
+  }
+  std::vector<std::vector<sobj> > lsum;
+  sliceSumLocal<robj>(grid,orthogdim,N,[&](uint64_t ss,robj *acc) {
+    for(int n=0;n<N;n++) acc[n]._internal = acc[n]._internal + TensorRemove(innerProduct(lhv[n][ss],rhv[n][ss]));
+  },lsum);
+  for(int n=0;n<N;n++) {
+    lhv[n].ViewClose();
+    rhv[n].ViewClose();
+  }
 
-    }
+  GlobalSumHandle sums(grid);
+  result.resize(N);
+  for(int n=0;n<N;n++){
+    int fd = lsum[n].size();
+    result[n].resize(fd);
+    for(int t=0;t<fd;t++) result[n][t] = lsum[n][t]._internal;
+    sums.AddVector(&result[n][0],&result[n][0],fd);
   }
-  
-  // sum over nodes.
-  scalar_type gsum;
-  for(int t=0;t<fd;t++){
-    int pt = t/ld; // processor plane
-    int lt = t%ld;
-    if ( pt == grid->_processor_coor[orthogdim] ) {
-      gsum=lsSum[lt];
-    } else {
-      gsum=scalar_type(0.0);
-    }
+  sums.Wait();
+}
 
-    grid->GlobalSum(gsum);
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Batched insertions, e.g. gamma matrices for meson correlators; lhs and rhs are read once per site:
+//   result[n][t] = sum_{x in t} lhs^dag (ops[n] rhs)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj,class Op>
+static void sliceInnerProductVector( std::vector<std::vector<ComplexD> > & result,
+				     const Lattice<vobj> &lhs,const std::vector<Op> &ops,const Lattice<vobj> &rhs,int orthogdim) 
+{
+  typedef typename vobj::vector_type   vector_type;
+  typedef iScalar<vector_type>         robj;
+  typedef typename robj::scalar_object sobj;
+  int N = ops.size();
+  assert(N>0);
+  GridBase *grid = lhs.Grid();
+  conformable(grid,rhs.Grid());
 
-    result[t]=gsum;
+  std::vector<std::vector<sobj> > lsum;
+  autoView( lhv, lhs, CpuRead);
+  autoView( rhv, rhs, CpuRead);
+  sliceSumLocal<robj>(grid,orthogdim,N,[&](uint64_t ss,robj *acc) {
+    vobj l = lhv[ss];
+    vobj r = rhv[ss];
+    for(int n=0;n<N;n++) acc[n]._internal = acc[n]._internal + TensorRemove(innerProduct(l,ops[n]*r));
+  },lsum);
+
+  GlobalSumHandle sums(grid);
+  result.resize(N);
+  for(int n=0;n<N;n++){
+    int fd = lsum[n].size();
+    result[n].resize(fd);
+    for(int t=0;t<fd;t++) result[n][t] = lsum[n][t]._internal;
+    sums.AddVector(&result[n][0],&result[n][0],fd);
   }
+  sums.Wait();
 }
+
 template<class vobj>
 static void sliceNorm (std::vector<RealD> &sn,const Lattice<vobj> &rhs,int Orthog) 
 {
@@ -780,6 +780,68 @@ void ExtractSliceLocal(Lattice<vobj> &lowDim,const Lattice<vobj> & higherDim,int
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Multiple right hand sides blocked in the (unvectorised, undistributed) dimension 0:
+// the block field has extent Nrhs*Ls there, each rhs owning Ls consecutive slices, and
+// single is a 5d field of extent Ls or, for Ls=1, a field of one dimension less.
+// Outer site index of the block is s + Ls*(rhs + Nrhs*site) for single index s + Ls*site.
+//////////////////////////////////////////////////////////////////////////////////////////
+inline void RHSBlockCheck(GridBase *sg,GridBase *bg,int rhs,int &Ls,int &Nrhs)
+{
+  int ns = sg->_ndimension;
+  int nb = bg->_ndimension;
+  int dd = nb-ns;
+  assert( (dd==0) || (dd==1) );
+  assert(bg->_simd_layout[0]==1);
+  assert(bg->_processors[0]==1);
+  Ls = 1;
+  if ( dd==0 ) {
+    assert(sg->_simd_layout[0]==1);
+    assert(sg->_processors[0]==1);
+    Ls = sg->_rdimensions[0];
+  }
+  for(int d=1;d<nb;d++){
+    assert(sg->_processors [d-dd] == bg->_processors[d]);
+    assert(sg->_ldimensions[d-dd] == bg->_ldimensions[d]);
+    assert(sg->_simd_layout[d-dd] == bg->_simd_layout[d]);
+  }
+  assert(bg->_rdimensions[0]%Ls==0);
+  Nrhs = bg->_rdimensions[0]/Ls;
+  assert(bg->oSites()==Nrhs*sg->oSites());
+  assert(rhs>=0);
+  assert(rhs<Nrhs);
+}
+
+template<class vobj>
+void InsertRHS(const Lattice<vobj> &single,Lattice<vobj> &block,int rhs)
+{
+  int Ls,Nrhs;
+  RHSBlockCheck(single.Grid(),block.Grid(),rhs,Ls,Nrhs);
+  block.Checkerboard() = single.Checkerboard();
+  autoView( single_v, single, AcceleratorRead);
+  autoView( block_v , block , AcceleratorWrite);
+  accelerator_for(ss,single.Grid()->oSites(),vobj::Nsimd(),{
+    uint64_t s    = ss%Ls;
+    uint64_t site = ss/Ls;
+    coalescedWrite(block_v[s+Ls*(rhs+Nrhs*site)],single_v(ss));
+  });
+}
+
+template<class vobj>
+void ExtractRHS(Lattice<vobj> &single,const Lattice<vobj> &block,int rhs)
+{
+  int Ls,Nrhs;
+  RHSBlockCheck(single.Grid(),block.Grid(),rhs,Ls,Nrhs);
+  single.Checkerboard() = block.Checkerboard();
+  autoView( single_v, single, AcceleratorWrite);
+  autoView( block_v , block , AcceleratorRead);
+  accelerator_for(ss,single.Grid()->oSites(),vobj::Nsimd(),{
+    uint64_t s    = ss%Ls;
+    uint64_t site = ss/Ls;
+    coalescedWrite(single_v[ss],block_v(s+Ls*(rhs+Nrhs*site)));
+  });
+}
+
 template<class vobj>
 void Replicate(Lattice<vobj> &coarse,Lattice<vobj> & fine)
 {
@@ -1,4 +1,52 @@
 #include <Grid/GridCore.h>
 
 int                    Grid::BinaryIO::latticeWriteMaxRetry = -1;
+int                    Grid::BinaryIO::mmapRead = 0;
 Grid::BinaryIO::IoPerf Grid::BinaryIO::lastPerf;
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////
+// Slice-by-8 tables for the reflected zlib polynomial 0xEDB88320
+////////////////////////////////////////////////////////////////
+static uint32_t crc32_tables[8][256];
+
+static struct Crc32TableInit {
+  Crc32TableInit() {
+    for(uint32_t i=0;i<256;i++){
+      uint32_t c = i;
+      for(int k=0;k<8;k++) c = (c&1) ? (c>>1)^0xEDB88320UL : (c>>1);
+      crc32_tables[0][i] = c;
+    }
+    for(uint32_t i=0;i<256;i++){
+      for(int t=1;t<8;t++){
+	uint32_t c = crc32_tables[t-1][i];
+	crc32_tables[t][i] = (c>>8) ^ crc32_tables[0][c&0xFF];
+      }
+    }
+  }
+} crc32_table_init;
+
+uint32_t BinaryIO::Crc32(uint32_t crc,const unsigned char *buf,uint64_t len)
+{
+  const uint32_t (*T)[256] = crc32_tables;
+  crc = ~crc;
+  while ( len >= 8 ) {
+    uint32_t one = crc ^ ( (uint32_t)buf[0]      | ((uint32_t)buf[1]<<8)
+			 | ((uint32_t)buf[2]<<16) | ((uint32_t)buf[3]<<24) );
+    uint32_t two =        (uint32_t)buf[4]      | ((uint32_t)buf[5]<<8)
+			 | ((uint32_t)buf[6]<<16) | ((uint32_t)buf[7]<<24);
+    crc = T[7][ one     &0xFF] ^ T[6][(one>>8 )&0xFF]
+        ^ T[5][(one>>16)&0xFF] ^ T[4][ one>>24      ]
+        ^ T[3][ two     &0xFF] ^ T[2][(two>>8 )&0xFF]
+        ^ T[1][(two>>16)&0xFF] ^ T[0][ two>>24      ];
+    buf += 8;
+    len -= 8;
+  }
+  while ( len-- ) {
+    crc = T[0][(crc ^ *buf++)&0xFF] ^ (crc>>8);
+  }
+  return ~crc;
+}
+
+NAMESPACE_END(Grid);
@@ -40,6 +40,10 @@
 
 #include <arpa/inet.h>
 #include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 NAMESPACE_BEGIN(Grid);
 
@@ -87,6 +91,37 @@ class BinaryIO {
 
   static IoPerf lastPerf;
   static int latticeWriteMaxRetry;
+  static int mmapRead;   // --io-mmap: readLatticeObject maps the file rather than reading it
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Whole buffer pwrite/pread at an offset, through short counts and EINTR.
+  // Nonzero on error, or on end of file before the buffer is filled.
+  /////////////////////////////////////////////////////////////////////////////
+  static inline int writeBytes(int fd,const char *buf,uint64_t bytes,uint64_t offset)
+  {
+    while ( bytes ) {
+      ssize_t n = ::pwrite(fd,buf,bytes,offset);
+      if ( n < 0 ) {
+	if ( errno == EINTR ) continue;
+	return 1;
+      }
+      buf += n; bytes -= n; offset += n;
+    }
+    return 0;
+  }
+  static inline int readBytes(int fd,char *buf,uint64_t bytes,uint64_t offset)
+  {
+    while ( bytes ) {
+      ssize_t n = ::pread(fd,buf,bytes,offset);
+      if ( n < 0 ) {
+	if ( errno == EINTR ) continue;
+	return 1;
+      }
+      if ( n == 0 ) return 1; // short file
+      buf += n; bytes -= n; offset += n;
+    }
+    return 0;
+  }
 
   /////////////////////////////////////////////////////////////////////////////
   // more byte manipulation helpers
@@ -178,7 +213,7 @@ class BinaryIO {
 	uint32_t gsite29   = global_site%29;
 	uint32_t gsite31   = global_site%31;
 	
-	site_crc = crc32(0,(unsigned char *)site_buf,sizeof(fobj));
+	site_crc = Crc32(0,(unsigned char *)site_buf,sizeof(fobj));
 	//	std::cout << "Site "<<local_site << " crc "<<std::hex<<site_crc<<std::dec<<std::endl;
 	//	std::cout << "Site "<<local_site << std::hex<<site_buf[0] <<site_buf[1]<<std::dec <<std::endl;
 	scidac_csuma_thr ^= site_crc<<gsite29 | site_crc>>(32-gsite29);
@@ -193,6 +228,167 @@ class BinaryIO {
     }
   }
 
+  /////////////////////////////////////////////////////////////////////////////
+  // CRC-32 of the zlib polynomial, which the SciDAC checksum is defined with,
+  // slicing eight bytes per step; same result as zlib crc32()
+  /////////////////////////////////////////////////////////////////////////////
+  static uint32_t Crc32(uint32_t crc,const unsigned char *buf,uint64_t len);
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Single pass encode/decode of a local lexicographic array.
+  //
+  // Per site, and thread parallel over sites: munge, NERSC sum (host order),
+  // conversion to/from file byte order and SciDAC CRC (file order), so the
+  // data is touched once rather than once per operation. The checksums are
+  // rank local; globalChecksums combines them.
+  /////////////////////////////////////////////////////////////////////////////
+  enum { ByteOrderIEEE32BIG=0, ByteOrderIEEE32=1, ByteOrderIEEE64BIG=2, ByteOrderIEEE64=3 };
+
+  static inline int fileByteOrder(const std::string &format)
+  {
+    int ieee32big = (format == std::string("IEEE32BIG"));
+    int ieee32    = (format == std::string("IEEE32"));
+    int ieee64big = (format == std::string("IEEE64BIG"));
+    int ieee64    = (format == std::string("IEEE64") || format == std::string("IEEE64LITTLE"));
+    assert((ieee64+ieee32+ieee64big+ieee32big)==1);
+    if ( ieee32big ) return ByteOrderIEEE32BIG;
+    if ( ieee32 )    return ByteOrderIEEE32;
+    if ( ieee64big ) return ByteOrderIEEE64BIG;
+    return ByteOrderIEEE64;
+  }
+
+  // Host <-> file order of one object; an involution, as the _v helpers below
+  static inline void swapSite(void *site,uint64_t bytes,int order)
+  {
+    if ( (order==ByteOrderIEEE32BIG) || (order==ByteOrderIEEE32) ) {
+      uint32_t *f = (uint32_t *)site;
+      uint64_t count = bytes/sizeof(uint32_t);
+      for(uint64_t i=0;i<count;i++){
+	if ( order==ByteOrderIEEE32BIG ) f[i] = ntohl(f[i]);
+	else                             f[i] = ntohl(byte_reverse32(f[i]));
+      }
+    } else {
+      uint64_t *f = (uint64_t *)site;
+      uint64_t count = bytes/sizeof(uint64_t);
+      for(uint64_t i=0;i<count;i++){
+	if ( order==ByteOrderIEEE64BIG ) f[i] = Grid_ntohll(f[i]);
+	else                             f[i] = Grid_ntohll(byte_reverse64(f[i]));
+      }
+    }
+  }
+
+  template<class fobj> static inline uint32_t nerscSite(fobj &site)
+  {
+    const uint64_t size32 = sizeof(fobj) / sizeof(uint32_t);
+    uint32_t *site_buf = (uint32_t *)&site;
+    uint32_t csum = 0;
+    for (uint64_t j = 0; j < size32; j++) csum = csum + site_buf[j];
+    return csum;
+  }
+
+  template<class fobj> static inline void scidacSite(fobj &site,uint64_t global_site,uint32_t &scidac_csuma,uint32_t &scidac_csumb)
+  {
+    uint32_t site_crc = Crc32(0,(unsigned char *)&site,sizeof(fobj));
+    uint32_t gsite29  = global_site%29;
+    uint32_t gsite31  = global_site%31;
+    scidac_csuma ^= site_crc<<gsite29 | site_crc>>(32-gsite29);
+    scidac_csumb ^= site_crc<<gsite31 | site_crc>>(32-gsite31);
+  }
+
+  static inline uint64_t globalSite(uint64_t local_site,const Coordinate &local_vol,
+				    const Coordinate &local_start,const Coordinate &global_vol)
+  {
+    uint64_t gidx = 0, stride = 1;
+    for(int d=0;d<local_vol.size();d++){
+      uint64_t lc = local_site % local_vol[d]; local_site /= local_vol[d];
+      gidx  += (lc+local_start[d])*stride;
+      stride*= global_vol[d];
+    }
+    return gidx;
+  }
+
+  template<class sobj,class fobj,class munger>
+  static inline void encodeSites(GridBase *grid,std::vector<sobj> &in,std::vector<fobj> &out,munger munge,
+				 const std::string &format,
+				 uint32_t &nersc_csum,uint32_t &scidac_csuma,uint32_t &scidac_csumb)
+  {
+    int order = fileByteOrder(format);
+    uint64_t lsites = out.size();
+    Coordinate local_vol   =grid->LocalDimensions();
+    Coordinate local_start =grid->LocalStarts();
+    Coordinate global_vol  =grid->FullDimensions();
+
+    nersc_csum=0;
+    scidac_csuma=0;
+    scidac_csumb=0;
+    thread_region
+    {
+      uint32_t nersc_csum_thr=0;
+      uint32_t scidac_csuma_thr=0;
+      uint32_t scidac_csumb_thr=0;
+      thread_for_in_region( local_site, lsites, {
+	fobj &site = out[local_site];
+	munge(in[local_site],site);
+	nersc_csum_thr += nerscSite(site);
+	swapSite((void *)&site,sizeof(fobj),order);
+	uint64_t global_site = globalSite(local_site,local_vol,local_start,global_vol);
+	scidacSite(site,global_site,scidac_csuma_thr,scidac_csumb_thr);
+      });
+      thread_critical
+      {
+	nersc_csum   += nersc_csum_thr;
+	scidac_csuma ^= scidac_csuma_thr;
+	scidac_csumb ^= scidac_csumb_thr;
+      }
+    }
+  }
+
+  // "in" is converted to host order in place
+  template<class sobj,class fobj,class munger>
+  static inline void decodeSites(GridBase *grid,std::vector<fobj> &in,std::vector<sobj> &out,munger munge,
+				 const std::string &format,
+				 uint32_t &nersc_csum,uint32_t &scidac_csuma,uint32_t &scidac_csumb)
+  {
+    int order = fileByteOrder(format);
+    uint64_t lsites = in.size();
+    Coordinate local_vol   =grid->LocalDimensions();
+    Coordinate local_start =grid->LocalStarts();
+    Coordinate global_vol  =grid->FullDimensions();
+
+    nersc_csum=0;
+    scidac_csuma=0;
+    scidac_csumb=0;
+    thread_region
+    {
+      uint32_t nersc_csum_thr=0;
+      uint32_t scidac_csuma_thr=0;
+      uint32_t scidac_csumb_thr=0;
+      thread_for_in_region( local_site, lsites, {
+	fobj &site = in[local_site];
+	uint64_t global_site = globalSite(local_site,local_vol,local_start,global_vol);
+	scidacSite(site,global_site,scidac_csuma_thr,scidac_csumb_thr);
+	swapSite((void *)&site,sizeof(fobj),order);
+	nersc_csum_thr += nerscSite(site);
+	munge(site,out[local_site]);
+      });
+      thread_critical
+      {
+	nersc_csum   += nersc_csum_thr;
+	scidac_csuma ^= scidac_csuma_thr;
+	scidac_csumb ^= scidac_csumb_thr;
+      }
+    }
+  }
+
+  static inline void globalChecksums(GridBase *grid,uint32_t &nersc_csum,uint32_t &scidac_csuma,uint32_t &scidac_csumb)
+  {
+    grid->Barrier();
+    grid->GlobalSum(nersc_csum);
+    grid->GlobalXOR(scidac_csuma);
+    grid->GlobalXOR(scidac_csumb);
+    grid->Barrier();
+  }
+
   // Network is big endian
   static inline void htobe32_v(void *file_object,uint32_t bytes){ be32toh_v(file_object,bytes);} 
   static inline void htobe64_v(void *file_object,uint32_t bytes){ be64toh_v(file_object,bytes);} 
@@ -253,6 +449,7 @@ class BinaryIO {
   // Read or Write distributed lexico array of ANY object to a specific location in file 
   //////////////////////////////////////////////////////////////////////////////////////
 
+  static const int BINARYIO_ENCODED       = 0x20; // byte order and checksums done by the caller (encodeSites/decodeSites)
   static const int BINARYIO_MASTER_APPEND = 0x10;
   static const int BINARYIO_UNORDERED     = 0x08;
   static const int BINARYIO_LEXICOGRAPHIC = 0x04;
@@ -274,9 +471,12 @@ class BinaryIO {
     GridStopWatch timer; 
     GridStopWatch bstimer;
     
-    nersc_csum=0;
-    scidac_csuma=0;
-    scidac_csumb=0;
+    int encoded = control & BINARYIO_ENCODED;
+    if ( !encoded ) {
+      nersc_csum=0;
+      scidac_csuma=0;
+      scidac_csumb=0;
+    }
 
     int ndim                 = grid->Dimensions();
     int nrank                = grid->ProcessorCount();
@@ -392,24 +592,28 @@ class BinaryIO {
       grid->Barrier();
 
       bstimer.Start();
-      ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
-      if (ieee32big) be32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee32)    le32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64big) be64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64)    le64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      NerscChecksum(grid,iodata,nersc_csum);
+      if ( !encoded ) {
+        ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
+        if (ieee32big) be32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+        if (ieee32)    le32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+        if (ieee64big) be64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+        if (ieee64)    le64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+        NerscChecksum(grid,iodata,nersc_csum);
+      }
       bstimer.Stop();
     }
     
     if ( control & BINARYIO_WRITE ) { 
 
       bstimer.Start();
-      NerscChecksum(grid,iodata,nersc_csum);
-      if (ieee32big) htobe32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee32)    htole32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64big) htobe64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64)    htole64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
+      if ( !encoded ) {
+        NerscChecksum(grid,iodata,nersc_csum);
+        if (ieee32big) htobe32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+        if (ieee32)    htole32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+        if (ieee64big) htobe64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+        if (ieee64)    htole64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
+        ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
+      }
       bstimer.Stop();
 
       grid->Barrier();
@@ -525,15 +729,160 @@ class BinaryIO {
     // Safety check
     //////////////////////////////////////////////////////////////////////////////
     // if the data size is 1 we do not want to sum over the MPI ranks
-    if (iodata.size() != 1){
-      grid->Barrier();
-      grid->GlobalSum(nersc_csum);
-      grid->GlobalXOR(scidac_csuma);
-      grid->GlobalXOR(scidac_csumb);
-      grid->Barrier();
+    if ( (iodata.size() != 1) && !encoded ){
+      globalChecksums(grid,nersc_csum,scidac_csuma,scidac_csumb);
     }
   }
 
+  /////////////////////////////////////////////////////////////////////////////
+  // Zero copy read of a lexicographic file through mmap.
+  //
+  // Each rank maps the span of the file holding its hyperslab and asks for
+  // read ahead on its own runs of sites only, so only those pages are faulted
+  // in. Sites are decoded (CRC, byte order, NERSC sum, munge) straight from
+  // the mapped pages and merged into the lattice; there is no staging array.
+  // Intended for node local or single node files. Returns false, on every
+  // rank, if any rank cannot map the file; the caller then reads as usual.
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  static inline bool readLatticeObjectMapped(Lattice<vobj> &Umu,
+					     std::string file,
+					     munger munge,
+					     uint64_t offset,
+					     const std::string &format,
+					     uint32_t &nersc_csum,
+					     uint32_t &scidac_csuma,
+					     uint32_t &scidac_csumb)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename vobj::vector_type vtype;
+
+    GridBase *grid = Umu.Grid();
+    int order = fileByteOrder(format);
+
+    const int ndim = grid->Nd();
+    constexpr int nsimd = vtype::Nsimd();
+    uint64_t lsites        = grid->lSites();
+    uint64_t row           = grid->_ldimensions[0];
+    Coordinate local_vol   = grid->LocalDimensions();
+    Coordinate local_start = grid->LocalStarts();
+    Coordinate global_vol  = grid->FullDimensions();
+
+    grid->Barrier();
+    GridStopWatch timer;
+    timer.Start();
+
+    //////////////////////////////////////////////
+    // Span of this rank's sites in the file
+    //////////////////////////////////////////////
+    uint64_t first = globalSite(0,local_vol,local_start,global_vol);
+    uint64_t last  = globalSite(lsites-1,local_vol,local_start,global_vol);
+    uint64_t begin = offset + first*sizeof(fobj);
+    uint64_t end   = offset + (last+1)*sizeof(fobj);
+    uint64_t page  = sysconf(_SC_PAGESIZE);
+    uint64_t map_begin = begin & ~(page-1);
+    uint64_t map_bytes = end - map_begin;
+
+    unsigned char *map = nullptr;
+    uint32_t failed = 0;
+    int fd = ::open(file.c_str(),O_RDONLY);
+    struct stat st;
+    if ( fd < 0 ) {
+      failed = 1;
+    } else if ( ::fstat(fd,&st) || (uint64_t)st.st_size < map_begin+map_bytes ) {
+      // Pages past EOF would fault (SIGBUS) on access; let IOobject report the short file
+      failed = 1;
+      ::close(fd);
+    } else {
+      void *p = ::mmap(nullptr,map_bytes,PROT_READ,MAP_SHARED,fd,map_begin);
+      if ( p == MAP_FAILED ) failed = 1;
+      else                   map  = (unsigned char *)p;
+      ::close(fd);
+    }
+    grid->GlobalSum(failed);
+    if ( failed ) {
+      if ( map ) ::munmap(map,map_bytes);
+      std::cout << GridLogMessage << "readLatticeObject: mmap of " << file << " failed or short on "
+		<< failed << " rank(s); reading through IOobject" << std::endl;
+      return false;
+    }
+
+    ::madvise(map,map_bytes,MADV_SEQUENTIAL);
+    for(uint64_t lidx=0;lidx<lsites;lidx+=row){
+      uint64_t b = offset + globalSite(lidx,local_vol,local_start,global_vol)*sizeof(fobj);
+      uint64_t e = b + row*sizeof(fobj);
+      b = b & ~(page-1);
+      ::madvise(map+(b-map_begin),e-b,MADV_WILLNEED);
+    }
+
+    //////////////////////////////////////////////
+    // Decode from the pages into the lattice
+    //////////////////////////////////////////////
+    std::vector<Coordinate> icoor(nsimd);
+    for(int lane=0; lane < nsimd; lane++){
+      icoor[lane].resize(ndim);
+      grid->iCoorFromIindex(icoor[lane],lane);
+    }
+
+    nersc_csum=0;
+    scidac_csuma=0;
+    scidac_csumb=0;
+    {
+      autoView( out_v , Umu, CpuWrite);
+      thread_region
+      {
+	uint32_t nersc_csum_thr=0;
+	uint32_t scidac_csuma_thr=0;
+	uint32_t scidac_csumb_thr=0;
+	thread_for_in_region( oidx, grid->oSites(), {
+	  ExtractPointerArray<sobj> ptrs(nsimd);
+	  sobj scalar[nsimd];
+	  Coordinate ocoor(ndim);
+	  Coordinate lcoor(ndim);
+	  grid->oCoorFromOindex(ocoor, oidx);
+	  for(int lane=0; lane < nsimd; lane++){
+	    for(int mu=0;mu<ndim;mu++){
+	      lcoor[mu] = ocoor[mu] + grid->_rdimensions[mu]*icoor[lane][mu];
+	    }
+	    uint64_t lex = 0, stride = 1;
+	    for(int mu=0;mu<ndim;mu++){
+	      lex   += lcoor[mu]*stride;
+	      stride*= local_vol[mu];
+	    }
+	    uint64_t global_site = globalSite(lex,local_vol,local_start,global_vol);
+	    fobj site;
+	    memcpy((void *)&site,map+(offset+global_site*sizeof(fobj)-map_begin),sizeof(fobj));
+	    scidacSite(site,global_site,scidac_csuma_thr,scidac_csumb_thr);
+	    swapSite((void *)&site,sizeof(fobj),order);
+	    nersc_csum_thr += nerscSite(site);
+	    munge(site,scalar[lane]);
+	    ptrs[lane] = &scalar[lane];
+	  }
+	  vobj vecobj;
+	  merge(vecobj, ptrs, 0);
+	  out_v[oidx] = vecobj;
+	});
+	thread_critical
+	{
+	  nersc_csum   += nersc_csum_thr;
+	  scidac_csuma ^= scidac_csuma_thr;
+	  scidac_csumb ^= scidac_csumb_thr;
+	}
+      }
+    }
+    ::munmap(map,map_bytes);
+    timer.Stop();
+
+    globalChecksums(grid,nersc_csum,scidac_csuma,scidac_csumb);
+
+    lastPerf.size            = sizeof(fobj)*grid->gSites();
+    lastPerf.time            = timer.useconds();
+    lastPerf.mbytesPerSecond = lastPerf.size/1024./1024./(lastPerf.time/1.0e6);
+    std::cout<<GridLogMessage<<"readLatticeObject: mmap read "<< file <<" "<< lastPerf.size <<" bytes in "
+	     << timer.Elapsed() <<" "<< lastPerf.mbytesPerSecond <<" MB/s "<<std::endl;
+    return true;
+  }
+
   /////////////////////////////////////////////////////////////////////////////
   // Read a Lattice of object
   //////////////////////////////////////////////////////////////////////////////////////
@@ -553,22 +902,28 @@ class BinaryIO {
     GridBase *grid = Umu.Grid();
     uint64_t lsites = grid->lSites();
 
+    if ( mmapRead ) {
+      if ( readLatticeObjectMapped<vobj,fobj>(Umu,file,munge,offset,format,
+					      nersc_csum,scidac_csuma,scidac_csumb) ) return;
+    }
+
     std::vector<sobj> scalardata(lsites); 
     std::vector<fobj>     iodata(lsites); // Munge, checksum, byte order in here
     
-    IOobject(w,grid,iodata,file,offset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
+    IOobject(w,grid,iodata,file,offset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC|BINARYIO_ENCODED,
 	     nersc_csum,scidac_csuma,scidac_csumb);
 
     GridStopWatch timer; 
     timer.Start();
 
-    thread_for(x,lsites, { munge(iodata[x], scalardata[x]); });
+    decodeSites(grid,iodata,scalardata,munge,format,nersc_csum,scidac_csuma,scidac_csumb);
+    globalChecksums(grid,nersc_csum,scidac_csuma,scidac_csumb);
 
     vectorizeFromLexOrdArray(scalardata,Umu);    
     grid->Barrier();
 
     timer.Stop();
-    std::cout<<GridLogMessage<<"readLatticeObject: vectorize overhead "<<timer.Elapsed()  <<std::endl;
+    std::cout<<GridLogMessage<<"readLatticeObject: endian, checksum, munge and vectorize overhead "<<timer.Elapsed()  <<std::endl;
   }
 
   /////////////////////////////////////////////////////////////////////////////
@@ -595,19 +950,20 @@ class BinaryIO {
     std::vector<fobj>     iodata(lsites); // Munge, checksum, byte order in here
 
     //////////////////////////////////////////////////////////////////////////////
-    // Munge [ .e.g 3rd row recon ]
+    // Munge [ .e.g 3rd row recon ], checksum and convert to file order in one pass
     //////////////////////////////////////////////////////////////////////////////
     GridStopWatch timer; timer.Start();
     unvectorizeToLexOrdArray(scalardata,Umu);    
 
-    thread_for(x, lsites, { munge(scalardata[x],iodata[x]); });
+    encodeSites(grid,scalardata,iodata,munge,format,nersc_csum,scidac_csuma,scidac_csumb);
+    globalChecksums(grid,nersc_csum,scidac_csuma,scidac_csumb);
 
     grid->Barrier();
     timer.Stop();
     while (attemptsLeft >= 0)
     {
       grid->Barrier();
-      IOobject(w,grid,iodata,file,offset,format,BINARYIO_WRITE|BINARYIO_LEXICOGRAPHIC,
+      IOobject(w,grid,iodata,file,offset,format,BINARYIO_WRITE|BINARYIO_LEXICOGRAPHIC|BINARYIO_ENCODED,
 	             nersc_csum,scidac_csuma,scidac_csumb);
       if (checkWrite)
       {
@@ -622,8 +978,7 @@ class BinaryIO {
         if ((cknersc_csum != nersc_csum) or (ckscidac_csuma != scidac_csuma) or (ckscidac_csumb != scidac_csumb))
         {
           std::cout << GridLogMessage << "writeLatticeObject: read test checksum failure, re-writing (" << attemptsLeft << " attempt(s) remaining)" << std::endl;
-          offset = offsetCopy;
-          thread_for(x,lsites, { munge(scalardata[x],iodata[x]); });
+          offset = offsetCopy; // iodata is still in file order
         }
         else
         {
@@ -635,7 +990,7 @@ class BinaryIO {
     }
     
 
-    std::cout<<GridLogMessage<<"writeLatticeObject: unvectorize overhead "<<timer.Elapsed()  <<std::endl;
+    std::cout<<GridLogMessage<<"writeLatticeObject: unvectorize, munge, checksum and endian overhead "<<timer.Elapsed()  <<std::endl;
   }
   
   /////////////////////////////////////////////////////////////////////////////
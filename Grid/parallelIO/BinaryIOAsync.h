@@ -0,0 +1,303 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/BinaryIOAsync.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#pragma once
+
+#include <thread>
+#include <functional>
+#include <memory>
+#include <fcntl.h>
+#include <unistd.h>
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Background writer for the lexicographic files of BinaryIO (checkpoints).
+//
+// Add* snapshot an object into a rank local staging array, in lexicographic
+// site order, and return. Start() hands the staged objects to a helper thread
+// which munges, byte swaps and checksums them and pwrite()s each rank's runs
+// of sites straight to their place in the file; the caller carries on with the
+// next trajectory meanwhile. No MPI call is made off the calling thread.
+//
+// Wait() joins the helper, combines the checksums over ranks, runs each file's
+// completion hook (e.g. rewriting a header that carries the checksum) and
+// reports. One snapshot is in flight at a time next to the live fields; a new
+// Add* first waits on the previous write.
+//
+// The files must exist (and any header be in place) before Start(). The
+// read back verification of writeLatticeObject is not applied.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class BinaryIOAsyncWriter {
+public:
+  typedef std::function<void(uint32_t nersc_csum,uint32_t scidac_csuma,uint32_t scidac_csumb)> Completion;
+
+private:
+  struct Item {
+    GridBase   *grid;
+    std::string file;
+    uint64_t    bytes;
+    std::function<int(uint32_t *csum)> work; // helper thread; fills csum[6], returns nonzero on I/O error
+    Completion  done;                        // calling thread, with the global checksums
+    uint32_t    csum[3];                     // rank local nersc, scidac a, scidac b
+    uint32_t    csum_serial[3];              // rank replicated part (serial RNG); not reduced
+    int         status;
+  };
+
+  std::vector<Item> items;
+  std::thread       worker;
+  bool              busy;
+  GridStopWatch     background;
+
+public:
+
+  BinaryIOAsyncWriter() : busy(false) {};
+  ~BinaryIOAsyncWriter() { Wait(); };
+
+  bool Busy(void) { return busy; };
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Snapshot of a Lattice of object, written as writeLatticeObject would
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  void AddLatticeObject(Lattice<vobj> &Umu,
+			std::string file,
+			munger munge,
+			uint64_t offset,
+			const std::string &format,
+			Completion done)
+  {
+    typedef typename vobj::scalar_object sobj;
+
+    Wait();
+
+    GridBase *grid  = Umu.Grid();
+    uint64_t lsites = grid->lSites();
+
+    std::shared_ptr<std::vector<sobj> > staged(new std::vector<sobj>(lsites));
+    unvectorizeToLexOrdArray(*staged,Umu);
+
+    Item item;
+    item.grid  = grid;
+    item.file  = file;
+    item.bytes = sizeof(fobj)*grid->gSites();
+    item.done  = done;
+    item.work  = [grid,staged,munge,file,offset,format] (uint32_t *csum) mutable {
+      std::vector<fobj> iodata(staged->size());
+      BinaryIO::encodeSites(grid,*staged,iodata,munge,format,csum[0],csum[1],csum[2]);
+      staged.reset();
+      return WriteLexicographic(grid,iodata,file,offset);
+    };
+    items.push_back(item);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Snapshot of the RNG state, written as writeRNG would: parallel state in
+  // lexicographic order followed by the serial state
+  /////////////////////////////////////////////////////////////////////////////
+  void AddRNG(GridSerialRNG &serial_rng,
+	      GridParallelRNG &parallel_rng,
+	      std::string file,
+	      uint64_t offset,
+	      Completion done)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    typedef std::array<RngStateType,RngStateCount> RNGstate;
+
+    Wait();
+
+    GridBase *grid  = parallel_rng.Grid();
+    uint64_t lsites = grid->lSites();
+    uint64_t gsites = grid->gSites();
+
+    std::shared_ptr<std::vector<RNGstate> > staged(new std::vector<RNGstate>(lsites+1));
+    thread_for(lidx,lsites,{
+      std::vector<RngStateType> tmp(RngStateCount);
+      Coordinate lcoor;
+      grid->LocalIndexToLocalCoor(lidx, lcoor);
+      int o_idx=grid->oIndex(lcoor);
+      int i_idx=grid->iIndex(lcoor);
+      int gidx=parallel_rng.generator_idx(o_idx,i_idx);
+      parallel_rng.GetState(tmp,gidx);
+      std::copy(tmp.begin(),tmp.end(),(*staged)[lidx].begin());
+    });
+    {
+      std::vector<RngStateType> tmp(RngStateCount);
+      serial_rng.GetState(tmp,0);
+      std::copy(tmp.begin(),tmp.end(),(*staged)[lsites].begin());
+    }
+
+    Item item;
+    item.grid  = grid;
+    item.file  = file;
+    item.bytes = sizeof(RNGstate)*(gsites+1);
+    item.done  = done;
+    item.work  = [grid,staged,file,offset,gsites] (uint32_t *csum) mutable {
+      const std::string format("IEEE32BIG");
+      auto copy = [](RNGstate &in,RNGstate &out) { out = in; };
+      std::vector<RNGstate> serial(1,staged->back());
+      staged->pop_back();
+      std::vector<RNGstate> iodata(staged->size());
+      BinaryIO::encodeSites(grid,*staged,iodata,copy,format,csum[0],csum[1],csum[2]);
+      staged.reset();
+      int err = WriteLexicographic(grid,iodata,file,offset);
+      // Serial state: checksummed on every rank, appended by the boss
+      BinaryIO::encodeSites(grid,serial,serial,copy,format,csum[3],csum[4],csum[5]);
+      if ( grid->IsBoss() ) err |= WriteBytes(file,(void *)&serial[0],sizeof(RNGstate),offset+gsites*sizeof(RNGstate));
+      return err;
+    };
+    items.push_back(item);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Launch the helper on everything added since the last Wait
+  /////////////////////////////////////////////////////////////////////////////
+  void Start(void)
+  {
+    assert(!busy);
+    if ( items.size() == 0 ) return;
+    busy = true;
+    background.Reset();
+    background.Start();
+    worker = std::thread([this] {
+#ifdef GRID_WORK_STEALING
+      GridThreadPool::SerialThread();
+#endif
+#ifdef GRID_OMP
+      omp_set_num_threads(1);   // leave the cores to the trajectory
+#endif
+      for(int i=0;i<items.size();i++){
+	uint32_t csum[6] = {0,0,0,0,0,0};
+	items[i].status = items[i].work(csum);
+	for(int c=0;c<3;c++) {
+	  items[i].csum[c]        = csum[c];
+	  items[i].csum_serial[c] = csum[3+c];
+	}
+      }
+    });
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Complete the write in flight, if any; collective over the grids written
+  /////////////////////////////////////////////////////////////////////////////
+  void Wait(void)
+  {
+    if ( !busy ) {
+      assert(items.size()==0 || !worker.joinable());
+      return;
+    }
+    GridStopWatch waited;
+    waited.Start();
+    worker.join();
+    background.Stop();
+    waited.Stop();
+
+    uint64_t bytes = 0;
+    for(int i=0;i<items.size();i++){
+      Item &item = items[i];
+      GridBase *grid = item.grid;
+
+      uint32_t status = item.status;
+      grid->GlobalSum(status);
+      if ( status ) {
+	std::cout << GridLogError << "BinaryIOAsyncWriter: write of " << item.file << " failed on "
+		  << status << " rank(s)" << std::endl;
+	assert(0);
+      }
+
+      grid->GlobalSum(item.csum[0]);
+      grid->GlobalXOR(item.csum[1]);
+      grid->GlobalXOR(item.csum[2]);
+      uint32_t nersc_csum   = item.csum[0] + item.csum_serial[0];
+      uint32_t scidac_csuma = item.csum[1] ^ item.csum_serial[1];
+      uint32_t scidac_csumb = item.csum[2] ^ item.csum_serial[2];
+
+      if ( item.done ) item.done(nersc_csum,scidac_csuma,scidac_csumb);
+      grid->Barrier();
+      bytes += item.bytes;
+    }
+
+    std::cout << GridLogMessage << "BinaryIOAsyncWriter: completed " << items.size() << " file(s), "
+	      << bytes << " bytes written in background in " << background.Elapsed()
+	      << "; waited " << waited.Elapsed() << std::endl;
+
+    items.resize(0);
+    busy = false;
+  }
+
+private:
+
+  static int WriteBytes(const std::string &file,void *buf,uint64_t bytes,uint64_t offset)
+  {
+    int fd = ::open(file.c_str(),O_WRONLY);
+    if ( fd < 0 ) return 1;
+    int err = BinaryIO::writeBytes(fd,(char *)buf,bytes,offset);
+    if ( ::close(fd) ) err = 1;
+    return err;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Local sites go to the global lexicographic position; runs along x, merged
+  // when consecutive in the file, are written with one pwrite each
+  /////////////////////////////////////////////////////////////////////////////
+  template<class fobj>
+  static int WriteLexicographic(GridBase *grid,std::vector<fobj> &iodata,const std::string &file,uint64_t offset)
+  {
+    int nd = grid->Dimensions();
+    Coordinate ldims  = grid->LocalDimensions();
+    Coordinate lstart = grid->LocalStarts();
+    Coordinate gdims  = grid->FullDimensions();
+    uint64_t lsites   = iodata.size();
+    uint64_t row      = ldims[0];
+
+    int fd = ::open(file.c_str(),O_WRONLY);
+    if ( fd < 0 ) return 1;
+
+    int err = 0;
+    uint64_t run_site = 0, run_len = 0, run_global = 0;
+    for(uint64_t lidx=0;lidx<lsites;lidx+=row){
+      uint64_t rem = lidx, gidx = 0, stride = 1;
+      for(int d=0;d<nd;d++){
+	uint64_t lc = rem % ldims[d]; rem /= ldims[d];
+	gidx  += (lc+lstart[d])*stride;
+	stride*= gdims[d];
+      }
+      if ( run_len && (gidx == run_global+run_len) ) {
+	run_len += row;
+      } else {
+	if ( run_len ) err |= BinaryIO::writeBytes(fd,(char *)&iodata[run_site],run_len*sizeof(fobj),offset+run_global*sizeof(fobj));
+	run_site   = lidx;
+	run_global = gidx;
+	run_len    = row;
+      }
+    }
+    if ( run_len ) err |= BinaryIO::writeBytes(fd,(char *)&iodata[run_site],run_len*sizeof(fobj),offset+run_global*sizeof(fobj));
+    if ( ::close(fd) ) err = 1;
+    return err;
+  }
+};
+
+NAMESPACE_END(Grid);
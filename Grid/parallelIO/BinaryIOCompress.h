@@ -0,0 +1,473 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/BinaryIOCompress.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Compressed lattice records.
+//
+// Methods:
+//   "none"                      raw lexicographic sites, as BinaryIO
+//   "shuffle-deflate"           lossless: byte planes of each word grouped, then deflated
+//   "truncate-shuffle-deflate"  error bounded: mantissas rounded to mantissa_bits bits
+//                               (relative error <= 2^-(mantissa_bits+1) per word), then as above
+//
+// Each rank encodes its local volume (munge, rounding, checksums, file byte order
+// as BinaryIO::encodeSites) and deflates it in blocks of block_sites sites,
+// thread parallel over blocks. The payload is the ranks' chunks back to back; a
+// chunk is a table of big endian uint64 (block count, then compressed block
+// sizes) followed by the blocks. The record describing the chunks is written
+// alongside the payload (see GridLimeWriter), so a reader on any decomposition
+// of the lattice finds and inflates only the blocks it needs.
+//
+// Checksums are those of the stored (rounded) sites in file order, identical to
+// an uncompressed record of the same data.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class BinaryIOCompressionParameters : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(BinaryIOCompressionParameters,
+				  std::string, method,
+				  int, mantissa_bits,
+				  int, level,
+				  int, block_sites);
+  BinaryIOCompressionParameters(std::string _method="none",int _mantissa_bits=0,int _level=1,int _block_sites=4096)
+    : method(_method), mantissa_bits(_mantissa_bits), level(_level), block_sites(_block_sites) {};
+};
+
+class BinaryIOCompressedChunk : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(BinaryIOCompressedChunk,
+				  uint64_t, offset,
+				  uint64_t, bytes,
+				  std::vector<int>, start,
+				  std::vector<int>, dimension);
+};
+
+class BinaryIOCompressedRecord : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(BinaryIOCompressedRecord,
+				  BinaryIOCompressionParameters, parameters,
+				  std::string, floating_point,
+				  int, site_bytes,
+				  double, error_bound,
+				  uint64_t, bytes,
+				  uint64_t, uncompressed_bytes,
+				  std::vector<BinaryIOCompressedChunk>, chunks);
+};
+
+class BinaryIOCompress {
+public:
+
+  static inline bool enabled(const BinaryIOCompressionParameters &par)
+  {
+    return (par.method != "none") && (par.method != "");
+  }
+  static inline bool lossy(const BinaryIOCompressionParameters &par)
+  {
+    return par.method == "truncate-shuffle-deflate";
+  }
+  static inline void checkParameters(const BinaryIOCompressionParameters &par,int word_bytes)
+  {
+    int mantissa = (word_bytes==4) ? 23 : 52;
+    assert( (par.method=="shuffle-deflate") || (par.method=="truncate-shuffle-deflate") );
+    assert( (par.level>=0) && (par.level<=9) );
+    assert( par.block_sites > 0 );
+    if ( lossy(par) ) assert( (par.mantissa_bits>=0) && (par.mantissa_bits<=mantissa) );
+  }
+  static inline int wordBytes(const std::string &format)
+  {
+    int order = BinaryIO::fileByteOrder(format);
+    return ( (order==BinaryIO::ByteOrderIEEE32BIG) || (order==BinaryIO::ByteOrderIEEE32) ) ? 4 : 8;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Round to nearest on mantissa_bits bits, host order; Inf/NaN untouched and
+  // a rounding carry that would overflow to Inf truncates instead
+  /////////////////////////////////////////////////////////////////////////////
+  static inline void roundMantissa(void *buf,uint64_t bytes,int word_bytes,int bits)
+  {
+    if ( word_bytes == 4 ) {
+      int drop = 23-bits;
+      if ( drop == 0 ) return;
+      const uint32_t expo = 0x7F800000U;
+      const uint32_t half = 1U<<(drop-1);
+      const uint32_t mask = ~((1U<<drop)-1);
+      uint32_t *f = (uint32_t *)buf;
+      for(uint64_t i=0;i<bytes/4;i++){
+	if ( (f[i]&expo) == expo ) continue;
+	uint32_t r = (f[i]+half)&mask;
+	f[i] = ( (r&expo) == expo ) ? (f[i]&mask) : r;
+      }
+    } else {
+      int drop = 52-bits;
+      if ( drop == 0 ) return;
+      const uint64_t expo = 0x7FF0000000000000ULL;
+      const uint64_t half = 1ULL<<(drop-1);
+      const uint64_t mask = ~((1ULL<<drop)-1);
+      uint64_t *f = (uint64_t *)buf;
+      for(uint64_t i=0;i<bytes/8;i++){
+	if ( (f[i]&expo) == expo ) continue;
+	uint64_t r = (f[i]+half)&mask;
+	f[i] = ( (r&expo) == expo ) ? (f[i]&mask) : r;
+      }
+    }
+  }
+
+  // Byte j of word i goes to plane j; exponents and high mantissa bytes then sit together
+  static inline void shuffle(const unsigned char *in,unsigned char *out,uint64_t bytes,int word_bytes)
+  {
+    uint64_t words = bytes/word_bytes;
+    for(uint64_t w=0;w<words;w++){
+      for(int b=0;b<word_bytes;b++){
+	out[b*words+w] = in[w*word_bytes+b];
+      }
+    }
+  }
+  static inline void unshuffle(const unsigned char *in,unsigned char *out,uint64_t bytes,int word_bytes)
+  {
+    uint64_t words = bytes/word_bytes;
+    for(uint64_t w=0;w<words;w++){
+      for(int b=0;b<word_bytes;b++){
+	out[w*word_bytes+b] = in[b*words+w];
+      }
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // One rank's sites (file order) <-> its compressed chunk
+  /////////////////////////////////////////////////////////////////////////////
+  template<class fobj>
+  static inline void compressChunk(std::vector<fobj> &iodata,std::vector<unsigned char> &chunk,
+				   const BinaryIOCompressionParameters &par,int word_bytes)
+  {
+    uint64_t lsites = iodata.size();
+    uint64_t bsites = par.block_sites;
+    uint64_t nblock = (lsites+bsites-1)/bsites;
+    int      level  = par.level;
+
+    std::vector<std::vector<unsigned char> > blocks(nblock);
+    thread_for(b,nblock,{
+      uint64_t s0  = b*bsites;
+      uint64_t raw = std::min(bsites,lsites-s0)*sizeof(fobj);
+      std::vector<unsigned char> planes(raw);
+      shuffle((unsigned char *)&iodata[s0],&planes[0],raw,word_bytes);
+      uLongf len = compressBound(raw);
+      blocks[b].resize(len);
+      int err = compress2(&blocks[b][0],&len,&planes[0],raw,level);
+      assert(err == Z_OK);
+      blocks[b].resize(len);
+    });
+
+    uint64_t table = (nblock+1)*sizeof(uint64_t);
+    uint64_t bytes = table;
+    for(uint64_t b=0;b<nblock;b++) bytes += blocks[b].size();
+    chunk.resize(bytes);
+    uint64_t *sizes = (uint64_t *)&chunk[0];
+    sizes[0] = Grid_ntohll(nblock);
+    uint64_t pos = table;
+    for(uint64_t b=0;b<nblock;b++){
+      sizes[1+b] = Grid_ntohll(blocks[b].size());
+      memcpy(&chunk[pos],&blocks[b][0],blocks[b].size());
+      pos += blocks[b].size();
+    }
+  }
+
+  // Inflates the blocks holding sites [first,last] of a chunk of csites sites; nonzero on corrupt data
+  template<class fobj>
+  static inline int decompressChunk(std::vector<unsigned char> &chunk,std::vector<fobj> &out,
+				    uint64_t block_sites,int word_bytes,uint64_t first,uint64_t last)
+  {
+    uint64_t csites = out.size();
+    uint64_t nblock = (csites+block_sites-1)/block_sites;
+    uint64_t table  = (nblock+1)*sizeof(uint64_t);
+    if ( chunk.size() < table ) return 1;
+    uint64_t *sizes = (uint64_t *)&chunk[0];
+    if ( Grid_ntohll(sizes[0]) != nblock ) return 1;
+
+    std::vector<uint64_t> pos(nblock+1);
+    pos[0] = table;
+    for(uint64_t b=0;b<nblock;b++) pos[b+1] = pos[b] + Grid_ntohll(sizes[1+b]);
+    if ( pos[nblock] != chunk.size() ) return 1;
+
+    uint64_t b0 = first/block_sites;
+    uint64_t nb = last/block_sites - b0 + 1;
+    std::vector<int> failed(nb,0); // per block; reduced after the loop
+    thread_for(i,nb,{
+      uint64_t b   = b0+i;
+      uint64_t s0  = b*block_sites;
+      uint64_t raw = std::min(block_sites,csites-s0)*sizeof(fobj);
+      std::vector<unsigned char> planes(raw);
+      uLongf len = raw;
+      int err = uncompress(&planes[0],&len,&chunk[pos[b]],pos[b+1]-pos[b]);
+      if ( (err != Z_OK) || (len != raw) ) {
+	failed[i] = 1;
+      } else {
+	unshuffle(&planes[0],(unsigned char *)&out[s0],raw,word_bytes);
+      }
+    });
+    for(uint64_t i=0;i<nb;i++) if ( failed[i] ) return 1;
+    return 0;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Collective: encode and compress the local volume; fills in the record,
+  // with chunk offsets relative to the start of the payload
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  static inline void encodeLatticeObject(Lattice<vobj> &Umu,
+					 munger munge,
+					 const std::string &format,
+					 const BinaryIOCompressionParameters &par,
+					 std::vector<unsigned char> &chunk,
+					 BinaryIOCompressedRecord &record,
+					 uint32_t &nersc_csum,
+					 uint32_t &scidac_csuma,
+					 uint32_t &scidac_csumb)
+  {
+    typedef typename vobj::scalar_object sobj;
+
+    GridBase *grid  = Umu.Grid();
+    int nd          = grid->Nd();
+    int nrank       = grid->ProcessorCount();
+    int myrank      = grid->ThisRank();
+    uint64_t lsites = grid->lSites();
+    int word_bytes  = wordBytes(format);
+    checkParameters(par,word_bytes);
+
+    GridStopWatch timer;
+    timer.Start();
+    std::vector<sobj> scalardata(lsites);
+    std::vector<fobj> iodata(lsites);
+    unvectorizeToLexOrdArray(scalardata,Umu);
+    if ( lossy(par) ) {
+      int bits = par.mantissa_bits;
+      auto rounded = [munge,word_bytes,bits] (sobj &in,fobj &out) mutable {
+	munge(in,out);
+	roundMantissa((void *)&out,sizeof(fobj),word_bytes,bits);
+      };
+      BinaryIO::encodeSites(grid,scalardata,iodata,rounded,format,nersc_csum,scidac_csuma,scidac_csumb);
+    } else {
+      BinaryIO::encodeSites(grid,scalardata,iodata,munge,format,nersc_csum,scidac_csuma,scidac_csumb);
+    }
+    BinaryIO::globalChecksums(grid,nersc_csum,scidac_csuma,scidac_csumb);
+    compressChunk(iodata,chunk,par,word_bytes);
+    timer.Stop();
+
+    std::vector<uint64_t> sizes(nrank,0);
+    sizes[myrank] = chunk.size();
+    grid->GlobalSumVector(&sizes[0],nrank);
+
+    record.parameters         = par;
+    record.floating_point     = format;
+    record.site_bytes         = sizeof(fobj);
+    record.error_bound        = lossy(par) ? std::ldexp(1.0,-(par.mantissa_bits+1)) : 0.0;
+    record.uncompressed_bytes = sizeof(fobj)*grid->gSites();
+    record.chunks.resize(nrank);
+    uint64_t offset = 0;
+    for(int r=0;r<nrank;r++){
+      Coordinate pcoor;
+      grid->ProcessorCoorFromRank(r,pcoor);
+      BinaryIOCompressedChunk &c = record.chunks[r];
+      c.offset = offset;
+      c.bytes  = sizes[r];
+      c.start.resize(nd);
+      c.dimension.resize(nd);
+      for(int d=0;d<nd;d++){
+	c.dimension[d] = grid->LocalDimensions()[d];
+	c.start[d]     = pcoor[d]*grid->LocalDimensions()[d];
+      }
+      offset += sizes[r];
+    }
+    record.bytes = offset;
+
+    std::cout << GridLogMessage << "BinaryIOCompress: " << par.method << " " << record.uncompressed_bytes
+	      << " -> " << record.bytes << " bytes, ratio " << (double)record.uncompressed_bytes/record.bytes
+	      << "; encode and compress " << timer.Elapsed() << std::endl;
+  }
+
+  // Collective: each rank writes its chunk at offset + its chunk offset
+  static inline void writeChunks(GridBase *grid,const std::string &file,uint64_t offset,
+				 BinaryIOCompressedRecord &record,std::vector<unsigned char> &chunk)
+  {
+    GridStopWatch timer;
+    timer.Start();
+    BinaryIOCompressedChunk &c = record.chunks[grid->ThisRank()];
+    assert(c.bytes == chunk.size());
+    uint32_t failed = 0;
+    int fd = ::open(file.c_str(),O_WRONLY);
+    if ( fd < 0 ) {
+      failed = 1;
+    } else {
+      failed = BinaryIO::writeBytes(fd,(char *)&chunk[0],c.bytes,offset+c.offset);
+      if ( ::close(fd) ) failed = 1;
+    }
+    grid->GlobalSum(failed);
+    timer.Stop();
+    if ( failed ) {
+      std::cout << GridLogError << "BinaryIOCompress: write to " << file << " failed on " << failed << " rank(s)" << std::endl;
+      assert(0);
+    }
+    auto &p = BinaryIO::lastPerf;
+    p.size            = record.bytes;
+    p.time            = timer.useconds();
+    p.mbytesPerSecond = p.size/1024./1024./(p.time/1.0e6);
+    std::cout << GridLogMessage << "BinaryIOCompress: wrote " << p.size << " bytes in " << timer.Elapsed()
+	      << " " << p.mbytesPerSecond << " MB/s" << std::endl;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Write a Lattice of object compressed at offset in file (file must exist)
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  static inline void writeLatticeObject(Lattice<vobj> &Umu,
+					std::string file,
+					munger munge,
+					uint64_t offset,
+					const std::string &format,
+					const BinaryIOCompressionParameters &par,
+					BinaryIOCompressedRecord &record,
+					uint32_t &nersc_csum,
+					uint32_t &scidac_csuma,
+					uint32_t &scidac_csumb)
+  {
+    std::vector<unsigned char> chunk;
+    encodeLatticeObject<vobj,fobj>(Umu,munge,format,par,chunk,record,nersc_csum,scidac_csuma,scidac_csumb);
+    writeChunks(Umu.Grid(),file,offset,record,chunk);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Read a compressed Lattice of object, on any decomposition of the lattice
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  static inline void readLatticeObject(Lattice<vobj> &Umu,
+				       std::string file,
+				       munger munge,
+				       uint64_t offset,
+				       BinaryIOCompressedRecord &record,
+				       uint32_t &nersc_csum,
+				       uint32_t &scidac_csuma,
+				       uint32_t &scidac_csumb)
+  {
+    typedef typename vobj::scalar_object sobj;
+
+    GridBase *grid    = Umu.Grid();
+    int nd            = grid->Nd();
+    uint64_t lsites   = grid->lSites();
+    Coordinate ldims  = grid->LocalDimensions();
+    Coordinate lstart = grid->LocalStarts();
+    std::string format= record.floating_point;
+    int word_bytes    = wordBytes(format);
+    uint64_t bsites   = record.parameters.block_sites;
+    checkParameters(record.parameters,word_bytes);
+    assert(record.site_bytes == sizeof(fobj));
+
+    GridStopWatch iotimer;
+    GridStopWatch ztimer;
+    uint64_t bytes_read = 0;
+
+    std::vector<fobj> iodata(lsites);
+    uint32_t failed = 0;
+    int fd = ::open(file.c_str(),O_RDONLY);
+    if ( fd < 0 ) failed = 1;
+
+    for(int c=0;(c<record.chunks.size()) && !failed;c++){
+      BinaryIOCompressedChunk &chunk = record.chunks[c];
+      Coordinate lo(nd), hi(nd), cdims(nd);
+      uint64_t csites = 1;
+      bool overlap = true;
+      for(int d=0;d<nd;d++){
+	cdims[d] = chunk.dimension[d];
+	csites  *= cdims[d];
+	lo[d] = std::max(lstart[d],chunk.start[d]);
+	hi[d] = std::min(lstart[d]+ldims[d],chunk.start[d]+chunk.dimension[d]);
+	if ( lo[d] >= hi[d] ) overlap = false;
+      }
+      if ( !overlap ) continue;
+
+      // Runs along x of the overlap, as (local site, chunk site)
+      Coordinate extent(nd), coor(nd);
+      uint64_t rows = 1;
+      for(int d=1;d<nd;d++) { extent[d] = hi[d]-lo[d]; rows *= extent[d]; }
+      uint64_t len = hi[0]-lo[0];
+      std::vector<std::pair<uint64_t,uint64_t> > runs(rows);
+      for(uint64_t r=0;r<rows;r++){
+	uint64_t rem = r;
+	coor[0] = lo[0];
+	for(int d=1;d<nd;d++) { coor[d] = lo[d] + rem % extent[d]; rem /= extent[d]; }
+	uint64_t local = 0, insite = 0, ls = 1, cs = 1;
+	for(int d=0;d<nd;d++){
+	  local  += (coor[d]-lstart[d])*ls;       ls *= ldims[d];
+	  insite += (coor[d]-chunk.start[d])*cs;  cs *= cdims[d];
+	}
+	runs[r] = std::make_pair(local,insite);
+      }
+
+      iotimer.Start();
+      std::vector<unsigned char> zdata(chunk.bytes);
+      failed |= BinaryIO::readBytes(fd,(char *)&zdata[0],chunk.bytes,offset+chunk.offset);
+      iotimer.Stop();
+      bytes_read += chunk.bytes;
+      if ( failed ) break;
+
+      ztimer.Start();
+      std::vector<fobj> cdata(csites);
+      uint64_t first = runs[0].second;
+      uint64_t last  = runs[rows-1].second+len-1;
+      failed |= decompressChunk(zdata,cdata,bsites,word_bytes,first,last);
+      if ( !failed ) {
+	thread_for(r,rows,{
+	  memcpy((void *)&iodata[runs[r].first],(void *)&cdata[runs[r].second],len*sizeof(fobj));
+	});
+      }
+      ztimer.Stop();
+    }
+    if ( fd >= 0 ) ::close(fd);
+    grid->GlobalSum(failed);
+    if ( failed ) {
+      std::cout << GridLogError << "BinaryIOCompress: read of " << file << " failed on " << failed << " rank(s)" << std::endl;
+      assert(0);
+    }
+
+    GridStopWatch timer;
+    timer.Start();
+    std::vector<sobj> scalardata(lsites);
+    BinaryIO::decodeSites(grid,iodata,scalardata,munge,format,nersc_csum,scidac_csuma,scidac_csumb);
+    BinaryIO::globalChecksums(grid,nersc_csum,scidac_csuma,scidac_csumb);
+    vectorizeFromLexOrdArray(scalardata,Umu);
+    timer.Stop();
+
+    auto &p = BinaryIO::lastPerf;
+    p.size            = bytes_read;
+    p.time            = iotimer.useconds();
+    p.mbytesPerSecond = p.size/1024./1024./(p.time/1.0e6);
+    std::cout << GridLogMessage << "BinaryIOCompress: read " << bytes_read << " bytes in " << iotimer.Elapsed()
+	      << " " << p.mbytesPerSecond << " MB/s; inflate " << ztimer.Elapsed()
+	      << "; checksum, munge and vectorize " << timer.Elapsed() << std::endl;
+  }
+};
+
+NAMESPACE_END(Grid);
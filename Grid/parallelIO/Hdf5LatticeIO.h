@@ -0,0 +1,326 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/Hdf5LatticeIO.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#pragma once
+
+#include <H5Cpp.h>
+#include <Grid/serialisation/Hdf5Type.h>
+
+#if defined(H5_HAVE_PARALLEL) && (defined(GRID_COMMS_MPI) || defined(GRID_COMMS_MPI3) || defined(GRID_COMMS_MPIT))
+#define GRID_HDF5_PARALLEL
+#endif
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Lattice fields as HDF5 datasets.
+//
+// A field on an nd dimensional grid is a dataset of the real scalar type of
+// shape [L_{nd-1}]...[L_1][L_0][words], row major, so the slowest index is the
+// last grid dimension (time) and the fastest the real words of one site;
+// complex numbers are (re,im) pairs. Attributes record the grid dimensions.
+//
+// The dataset is chunked, by default one chunk per timeslice, so analysis code
+// reading a single timeslice (readHyperslab) touches only that chunk.
+//
+// With a parallel HDF5 library and MPI the file is opened on the grid's
+// communicator and every rank transfers its hyperslab in one collective
+// H5Dwrite/H5Dread. Otherwise the boss holds the file and the ranks' hyperslabs
+// pass through it one rank at a time over the communicator.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Hdf5LatticeIO {
+protected:
+  GridBase    *grid;
+  std::string  fileName;
+  H5NS::H5File file;
+  bool         parallel;
+  bool         open;
+
+  Hdf5LatticeIO(GridBase *_grid,const std::string &_fileName,unsigned int flags)
+    : grid(_grid), fileName(_fileName), parallel(false), open(false)
+  {
+#ifdef GRID_HDF5_PARALLEL
+    parallel = true;
+    H5NS::FileAccPropList fapl;
+    H5Pset_fapl_mpio(fapl.getId(),grid->communicator,MPI_INFO_NULL);
+    file = H5NS::H5File(fileName.c_str(),flags,H5NS::FileCreatPropList::DEFAULT,fapl);
+    open = true;
+#else
+    if ( grid->IsBoss() ) {
+      file = H5NS::H5File(fileName.c_str(),flags);
+      open = true;
+    }
+#endif
+    grid->Barrier();
+  }
+  ~Hdf5LatticeIO()
+  {
+    if ( open ) file.close();
+    grid->Barrier();
+  }
+
+  // File space of the whole field: Grid dimensions reversed, then the words of a site
+  static inline std::vector<hsize_t> fileDims(const Coordinate &dims,hsize_t words)
+  {
+    int nd = dims.size();
+    std::vector<hsize_t> fdims(nd+1);
+    for(int d=0;d<nd;d++) fdims[nd-1-d] = dims[d];
+    fdims[nd] = words;
+    return fdims;
+  }
+
+  static inline H5NS::DataSpace selectHyperslab(H5NS::DataSet &dataSet,const Coordinate &start,const Coordinate &count,hsize_t words)
+  {
+    int nd = start.size();
+    std::vector<hsize_t> fstart(nd+1), fcount(nd+1);
+    for(int d=0;d<nd;d++) {
+      fstart[nd-1-d] = start[d];
+      fcount[nd-1-d] = count[d];
+    }
+    fstart[nd] = 0;
+    fcount[nd] = words;
+    H5NS::DataSpace space = dataSet.getSpace();
+    space.selectHyperslab(H5S_SELECT_SET,fcount.data(),fstart.data());
+    return space;
+  }
+
+  // Rank r's hyperslab
+  inline Coordinate rankStart(int r)
+  {
+    Coordinate pcoor;
+    grid->ProcessorCoorFromRank(r,pcoor);
+    Coordinate start(grid->Nd());
+    for(int d=0;d<grid->Nd();d++) start[d] = pcoor[d]*grid->LocalDimensions()[d];
+    return start;
+  }
+
+  // Boss <-> rank r, in pieces that fit the int byte count of the communicator
+  inline void exchange(void *xmit,void *recv,int r,uint64_t bytes)
+  {
+    const uint64_t piece = 1ULL<<30;
+    for(uint64_t o=0;o<bytes;o+=piece){
+      int n = std::min(piece,bytes-o);
+      int peer = grid->IsBoss() ? r : 0;
+      grid->SendToRecvFrom((char *)xmit+o,peer,(char *)recv+o,peer,n);
+    }
+  }
+
+  inline void transferProperties(H5NS::DSetMemXferPropList &xfer)
+  {
+#ifdef GRID_HDF5_PARALLEL
+    H5Pset_dxpl_mpio(xfer.getId(),H5FD_MPIO_COLLECTIVE);
+#endif
+  }
+
+public:
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Local, by any single process (no Grid needed): sites [start,start+count)
+  // in Grid dimension order, returned lexicographically (x fastest)
+  /////////////////////////////////////////////////////////////////////////////
+  template<class sobj>
+  static inline void readHyperslab(const std::string &fileName,const std::string &name,
+				   const Coordinate &start,const Coordinate &count,std::vector<sobj> &out)
+  {
+    typedef typename getPrecision<sobj>::real_scalar_type word;
+    const hsize_t words = sizeof(sobj)/sizeof(word);
+
+    H5NS::H5File  file(fileName.c_str(),H5F_ACC_RDONLY);
+    H5NS::DataSet dataSet = file.openDataSet(name);
+    assert(dataSet.getSpace().getSimpleExtentNdims() == start.size()+1);
+
+    uint64_t sites = 1;
+    for(int d=0;d<count.size();d++) sites *= count[d];
+    out.resize(sites);
+
+    H5NS::DataSpace fileSpace = selectHyperslab(dataSet,start,count,words);
+    std::vector<hsize_t> mdims(1,sites*words);
+    H5NS::DataSpace memSpace(1,mdims.data());
+    dataSet.read((void *)&out[0],Hdf5Type<word>::type(),memSpace,fileSpace);
+  }
+};
+
+class Hdf5LatticeWriter : public Hdf5LatticeIO {
+public:
+  // Collective; truncates the file
+  Hdf5LatticeWriter(GridBase *_grid,const std::string &_fileName)
+    : Hdf5LatticeIO(_grid,_fileName,H5F_ACC_TRUNC) {};
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Collective. chunk is in Grid dimension order; empty means one timeslice
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj>
+  void writeLattice(const std::string &name,Lattice<vobj> &field,Coordinate chunk=Coordinate())
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename getPrecision<vobj>::real_scalar_type word;
+    const hsize_t words = sizeof(sobj)/sizeof(word);
+
+    assert(field.Grid() == grid);
+    int nd            = grid->Nd();
+    uint64_t lsites   = grid->lSites();
+    Coordinate ldims  = grid->LocalDimensions();
+    Coordinate gdims  = grid->FullDimensions();
+
+    if ( chunk.size() == 0 ) {
+      chunk = gdims;
+      chunk[nd-1] = 1;
+    }
+    assert(chunk.size() == nd);
+    uint64_t chunk_bytes = sizeof(sobj);
+    for(int d=0;d<nd;d++) {
+      assert( (chunk[d] > 0) && (chunk[d] <= gdims[d]) );
+      chunk_bytes *= chunk[d];
+    }
+    assert(chunk_bytes < 0x100000000ULL); // HDF5 chunks are limited to 4GB
+
+    GridStopWatch timer;
+    timer.Start();
+    std::vector<sobj> iodata(lsites);
+    unvectorizeToLexOrdArray(iodata,field);
+
+    H5NS::DataSet dataSet;
+    if ( open ) {
+      std::vector<hsize_t> fdims = fileDims(gdims,words);
+      std::vector<hsize_t> cdims = fileDims(chunk,words);
+      H5NS::DataSpace dataSpace(nd+1,fdims.data());
+      H5NS::DSetCreatPropList plist;
+      plist.setChunk(nd+1,cdims.data());
+      dataSet = file.createDataSet(name,Hdf5Type<word>::type(),dataSpace,plist);
+
+      std::vector<hsize_t> adim(1,nd);
+      H5NS::DataSpace attrSpace(1,adim.data());
+      std::vector<int> dims(gdims.begin(),gdims.end());
+      H5NS::Attribute attribute = dataSet.createAttribute("grid_dimensions",Hdf5Type<int>::type(),attrSpace);
+      attribute.write(Hdf5Type<int>::type(),dims.data());
+    }
+
+    std::vector<hsize_t> mdims(1,lsites*words);
+    H5NS::DataSpace memSpace(1,mdims.data());
+    H5NS::DSetMemXferPropList xfer;
+    transferProperties(xfer);
+
+    if ( parallel ) {
+      H5NS::DataSpace fileSpace = selectHyperslab(dataSet,grid->LocalStarts(),ldims,words);
+      dataSet.write((void *)&iodata[0],Hdf5Type<word>::type(),memSpace,fileSpace,xfer);
+    } else {
+      std::vector<sobj> recv;
+      if ( grid->ProcessorCount() > 1 ) recv.resize(lsites);
+      for(int r=0;r<grid->ProcessorCount();r++){
+	sobj *slab = &iodata[0];
+	if ( r != 0 ) {
+	  if ( grid->IsBoss() || (grid->ThisRank()==r) ) {
+	    exchange((void *)&iodata[0],(void *)&recv[0],r,lsites*sizeof(sobj));
+	  }
+	  slab = &recv[0];
+	}
+	if ( grid->IsBoss() ) {
+	  H5NS::DataSpace fileSpace = selectHyperslab(dataSet,rankStart(r),ldims,words);
+	  dataSet.write((void *)slab,Hdf5Type<word>::type(),memSpace,fileSpace,xfer);
+	}
+      }
+    }
+    grid->Barrier();
+    timer.Stop();
+
+    uint64_t bytes = sizeof(sobj)*grid->gSites();
+    std::cout << GridLogMessage << "Hdf5LatticeWriter: " << fileName << ":" << name << " " << bytes << " bytes in "
+	      << timer.Elapsed() << " " << bytes/1024./1024./(timer.useconds()/1.0e6) << " MB/s"
+	      << (parallel ? " (collective)" : " (through boss)") << std::endl;
+  }
+};
+
+class Hdf5LatticeReader : public Hdf5LatticeIO {
+public:
+  // Collective
+  Hdf5LatticeReader(GridBase *_grid,const std::string &_fileName)
+    : Hdf5LatticeIO(_grid,_fileName,H5F_ACC_RDONLY) {};
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Collective; the dataset must match the grid
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj>
+  void readLattice(const std::string &name,Lattice<vobj> &field)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename getPrecision<vobj>::real_scalar_type word;
+    const hsize_t words = sizeof(sobj)/sizeof(word);
+
+    assert(field.Grid() == grid);
+    int nd            = grid->Nd();
+    uint64_t lsites   = grid->lSites();
+    Coordinate ldims  = grid->LocalDimensions();
+    Coordinate gdims  = grid->FullDimensions();
+
+    GridStopWatch timer;
+    timer.Start();
+    H5NS::DataSet dataSet;
+    if ( open ) {
+      dataSet = file.openDataSet(name);
+      H5NS::DataSpace space = dataSet.getSpace();
+      assert(space.getSimpleExtentNdims() == nd+1);
+      std::vector<hsize_t> fdims(nd+1);
+      space.getSimpleExtentDims(fdims.data());
+      assert(fdims == fileDims(gdims,words));
+    }
+
+    std::vector<sobj> iodata(lsites);
+    std::vector<hsize_t> mdims(1,lsites*words);
+    H5NS::DataSpace memSpace(1,mdims.data());
+    H5NS::DSetMemXferPropList xfer;
+    transferProperties(xfer);
+
+    if ( parallel ) {
+      H5NS::DataSpace fileSpace = selectHyperslab(dataSet,grid->LocalStarts(),ldims,words);
+      dataSet.read((void *)&iodata[0],Hdf5Type<word>::type(),memSpace,fileSpace,xfer);
+    } else {
+      // The swap leaves rank r's stale buffer in the boss's iodata, so the boss's own slab is read last
+      std::vector<sobj> slab;
+      if ( grid->ProcessorCount() > 1 ) slab.resize(lsites);
+      for(int r=grid->ProcessorCount()-1;r>=0;r--){
+	sobj *dest = (r==0) ? &iodata[0] : &slab[0];
+	if ( grid->IsBoss() ) {
+	  H5NS::DataSpace fileSpace = selectHyperslab(dataSet,rankStart(r),ldims,words);
+	  dataSet.read((void *)dest,Hdf5Type<word>::type(),memSpace,fileSpace,xfer);
+	}
+	if ( r != 0 ) {
+	  if ( grid->IsBoss() || (grid->ThisRank()==r) ) {
+	    exchange((void *)&slab[0],(void *)&iodata[0],r,lsites*sizeof(sobj));
+	  }
+	}
+      }
+    }
+    vectorizeFromLexOrdArray(iodata,field);
+    grid->Barrier();
+    timer.Stop();
+
+    uint64_t bytes = sizeof(sobj)*grid->gSites();
+    std::cout << GridLogMessage << "Hdf5LatticeReader: " << fileName << ":" << name << " " << bytes << " bytes in "
+	      << timer.Elapsed() << " " << bytes/1024./1024./(timer.useconds()/1.0e6) << " MB/s"
+	      << (parallel ? " (collective)" : " (through boss)") << std::endl;
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -213,11 +213,27 @@ class GridLimeReader : public BinaryIO {
     uint32_t nersc_csum,scidac_csuma,scidac_csumb;
 
     std::string format = getFormatString<vobj>();
+    BinaryIOCompressedRecord compressed;
+    bool is_compressed = false;
+    std::string compression_str(GRID_COMPRESSION);
 
     while ( limeReaderNextRecord(LimeR) == LIME_SUCCESS ) { 
 
       uint64_t file_bytes =limeReaderBytes(LimeR);
 
+      /////////////////////////////////////////////
+      // A compression record precedes a compressed payload
+      /////////////////////////////////////////////
+      if ( !strncmp(limeReaderType(LimeR), compression_str.c_str(),strlen(compression_str.c_str()) )  ) {
+	std::vector<char> xmlc(file_bytes+1,'\0');
+	limeReaderReadData((void *)&xmlc[0], &file_bytes, LimeR);
+	std::string xmlstring = std::string(&xmlc[0]);
+	XmlReader RD(xmlstring, true, "");
+	read(RD,compressed.SerialisableClassName(),compressed);
+	is_compressed = true;
+	continue;
+      }
+
       //      std::cout << GridLogMessage << limeReaderType(LimeR) << " "<< file_bytes <<" bytes "<<std::endl;
       //      std::cout << GridLogMessage<< " readLimeObject seeking "<<  record_name <<" found record :" <<limeReaderType(LimeR) <<std::endl;
 
@@ -226,6 +242,7 @@ class GridLimeReader : public BinaryIO {
 	//	std::cout << GridLogMessage<< " readLimeLatticeBinaryObject matches ! " <<std::endl;
 
 	uint64_t PayloadSize = sizeof(sobj) * field.Grid()->_gsites;
+	if ( is_compressed ) PayloadSize = compressed.bytes;
 
 	//	std::cout << "R sizeof(sobj)= " <<sizeof(sobj)<<std::endl;
 	//	std::cout << "R Gsites " <<field.Grid()->_gsites<<std::endl;
@@ -237,7 +254,12 @@ class GridLimeReader : public BinaryIO {
 	uint64_t offset= ftello(File);
 	//	std::cout << " ReadLatticeObject from offset "<<offset << std::endl;
 	BinarySimpleMunger<sobj,sobj> munge;
-	BinaryIO::readLatticeObject< vobj, sobj >(field, filename, munge, offset, format,nersc_csum,scidac_csuma,scidac_csumb);
+	if ( is_compressed ) {
+	  assert(compressed.floating_point == format);
+	  BinaryIOCompress::readLatticeObject< vobj, sobj >(field, filename, munge, offset, compressed,nersc_csum,scidac_csuma,scidac_csumb);
+	} else {
+	  BinaryIO::readLatticeObject< vobj, sobj >(field, filename, munge, offset, format,nersc_csum,scidac_csuma,scidac_csumb);
+	}
 	std::cout << GridLogMessage << "SciDAC checksum A " << std::hex << scidac_csuma << std::dec << std::endl;
 	std::cout << GridLogMessage << "SciDAC checksum B " << std::hex << scidac_csumb << std::dec << std::endl;
 	/////////////////////////////////////////////
@@ -258,6 +280,9 @@ class GridLimeReader : public BinaryIO {
 	// find out if next field is a GridFieldNorm
 	return;
       }
+
+      // A compression record describes the record after it, and no other
+      is_compressed = false;
     }
   }
   void readScidacChecksum(scidacChecksum     &scidacChecksum_,
@@ -334,6 +359,7 @@ class GridLimeWriter : public BinaryIO
    LimeWriter *LimeW;
    std::string filename;
    bool        boss_node;
+   BinaryIOCompressionParameters compression; // lattice payloads; "none" keeps the SciDAC layout
    GridLimeWriter( bool isboss = true) {
      boss_node = isboss;
    }
@@ -428,6 +454,11 @@ class GridLimeWriter : public BinaryIO
 
     FieldNormMetaData FNMD; FNMD.norm2 = norm2(field);
 
+    if ( BinaryIOCompress::enabled(compression) ) {
+      writeLimeLatticeCompressedObject(field,record_name,FNMD);
+      return;
+    }
+
     ////////////////////////////////////////////
     // Create record header
     ////////////////////////////////////////////
@@ -480,6 +511,10 @@ class GridLimeWriter : public BinaryIO
     // Write checksum element, propagaing forward from the BinaryIO
     // Always pair a checksum with a binary object, and close message
     ////////////////////////////////////////
+    writeLimeChecksum(FNMD,scidac_csuma,scidac_csumb);
+  }
+  void writeLimeChecksum(FieldNormMetaData &FNMD,uint32_t scidac_csuma,uint32_t scidac_csumb)
+  {
     scidacChecksum checksum;
     std::stringstream streama; streama << std::hex << scidac_csuma;
     std::stringstream streamb; streamb << std::hex << scidac_csumb;
@@ -490,6 +525,48 @@ class GridLimeWriter : public BinaryIO
       writeLimeObject(0,1,checksum,std::string("scidacChecksum"),std::string(SCIDAC_CHECKSUM));
     }
   }
+  ////////////////////////////////////////////////////
+  // Compressed payload: a grid-compression record describing
+  // the chunks, then the binary record, then the checksums as
+  // for the raw payload. Collective.
+  ////////////////////////////////////////////////////
+  template<class vobj>
+  void writeLimeLatticeCompressedObject(Lattice<vobj> &field,std::string record_name,FieldNormMetaData &FNMD)
+  {
+    typedef typename vobj::scalar_object sobj;
+    GridBase *grid = field.Grid();
+    int err;
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+
+    std::string format = getFormatString<vobj>();
+    BinarySimpleMunger<sobj,sobj> munge;
+    BinaryIOCompressedRecord record;
+    std::vector<unsigned char> chunk;
+    BinaryIOCompress::encodeLatticeObject<vobj,sobj>(field,munge,format,compression,chunk,record,
+						     nersc_csum,scidac_csuma,scidac_csumb);
+
+    // Rounded data no longer has the norm of the field; the checksums cover it
+    if ( BinaryIOCompress::lossy(compression) ) FNMD.norm2 = 0.0;
+
+    uint64_t offset1;
+    if ( boss_node ) {
+      writeLimeObject(0,0,record,record.SerialisableClassName(),std::string(GRID_COMPRESSION));
+      createLimeRecordHeader(record_name, 0, 0, record.bytes);
+      fflush(File);
+      offset1 = ftello(File);
+    }
+    grid->Broadcast(0,(void *)&offset1,sizeof(offset1));
+
+    BinaryIOCompress::writeChunks(grid,filename,offset1,record,chunk);
+
+    if ( boss_node ) {
+      fseek(File,0,SEEK_END);
+      uint64_t offset2 = ftello(File);
+      assert( (offset2-offset1) == record.bytes);
+      err=limeWriterCloseRecord(LimeW);  assert(err>=0);
+    }
+    writeLimeChecksum(FNMD,scidac_csuma,scidac_csumb);
+  }
 };
 
 class ScidacWriter : public GridLimeWriter {
@@ -654,6 +731,9 @@ class IldgWriter : public ScidacWriter {
     ildgFormat ildgfmt ;
     ildgfmt.field     = std::string("su3gauge");
 
+    // ILDG files are read by other codes; compression is for SciDAC records only
+    assert(!BinaryIOCompress::enabled(this->compression));
+
     if ( format == std::string("IEEE32BIG") ) { 
       ildgfmt.precision = 32;
     } else { 
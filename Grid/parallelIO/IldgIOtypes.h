@@ -39,6 +39,7 @@ NAMESPACE_BEGIN(Grid);
 /////////////////////////////////////////////////////////////////////////////////
 
 #define GRID_FORMAT      "grid-format"
+#define GRID_COMPRESSION "grid-compression"
 #define ILDG_FORMAT      "ildg-format"
 #define ILDG_BINARY_DATA "ildg-binary-data"
 #define ILDG_DATA_LFN    "ildg-data-lfn"
@@ -206,15 +206,8 @@ public:
   }
 
   template<class GaugeStats=PeriodicGaugeStatistics>
-  static inline void writeConfiguration(Lattice<vLorentzColourMatrixD > &Umu,
-					std::string file, 
-					int two_row,
-					int bits32)
+  static inline void configurationHeader(Lattice<vLorentzColourMatrixD > &Umu,FieldMetaData &header)
   {
-    typedef vLorentzColourMatrixD vobj;
-    typedef typename vobj::scalar_object sobj;
-
-    FieldMetaData header;
     ///////////////////////////////////////////
     // Following should become arguments
     ///////////////////////////////////////////
@@ -222,9 +215,6 @@ public:
     header.ensemble_id     = "UKQCD";
     header.ensemble_label  = "DWF";
 
-    typedef LorentzColourMatrixD fobj3D;
-    typedef LorentzColour2x3D    fobj2D;
-  
     GridBase *grid = Umu.Grid();
 
     GridMetaData(grid,header);
@@ -232,11 +222,31 @@ public:
     GaugeStats Stats; Stats(Umu,header);
     MachineCharacteristics(header);
 
-	uint64_t offset;
-
     // Sod it -- always write 3x3 double
     header.floating_point = std::string("IEEE64BIG");
     header.data_type      = std::string("4D_SU3_GAUGE_3x3");
+  }
+
+  template<class GaugeStats=PeriodicGaugeStatistics>
+  static inline void writeConfiguration(Lattice<vLorentzColourMatrixD > &Umu,
+					std::string file, 
+					int two_row,
+					int bits32)
+  {
+    typedef vLorentzColourMatrixD vobj;
+    typedef typename vobj::scalar_object sobj;
+
+    FieldMetaData header;
+
+    typedef LorentzColourMatrixD fobj3D;
+    typedef LorentzColour2x3D    fobj2D;
+  
+    GridBase *grid = Umu.Grid();
+
+    configurationHeader<GaugeStats>(Umu,header);
+
+	uint64_t offset;
+
     GaugeSimpleUnmunger<fobj3D,sobj> munge;
     if ( grid->IsBoss() ) { 
       truncate(file);
@@ -257,29 +267,65 @@ public:
 	     <<std::dec<<" plaq "<< header.plaquette <<std::endl;
 
   }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Background write: header statistics are taken and a provisional header
+  // laid down now; the payload follows on the writer's helper thread and the
+  // header is rewritten with the checksum when the writer completes. The
+  // header is fixed width so the payload offset does not move.
+  ////////////////////////////////////////////////////////////////////////////
+  template<class GaugeStats=PeriodicGaugeStatistics>
+  static inline void writeConfiguration(BinaryIOAsyncWriter &writer,
+					Lattice<vLorentzColourMatrixD > &Umu,
+					std::string file)
+  {
+    typedef vLorentzColourMatrixD vobj;
+    typedef typename vobj::scalar_object sobj;
+    typedef LorentzColourMatrixD fobj3D;
+
+    writer.Wait();
+
+    FieldMetaData header;
+    GridBase *grid = Umu.Grid();
+
+    configurationHeader<GaugeStats>(Umu,header);
+
+    uint64_t offset;
+    if ( grid->IsBoss() ) { 
+      truncate(file);
+      offset = writeHeader(header,file);
+    }
+    grid->Broadcast(0,(void *)&offset,sizeof(offset));
+
+    GaugeSimpleUnmunger<fobj3D,sobj> munge;
+    writer.AddLatticeObject<vobj,fobj3D>(Umu,file,munge,offset,header.floating_point,
+					 [grid,header,file](uint32_t nersc_csum,uint32_t scidac_csuma,uint32_t scidac_csumb) mutable {
+      header.checksum = nersc_csum;
+      if ( grid->IsBoss() ) { 
+	writeHeader(header,file);
+      }
+      std::cout<<GridLogMessage <<"Written NERSC Configuration on "<< file << " checksum "
+	       <<std::hex<<header.checksum
+	       <<std::dec<<" plaq "<< header.plaquette <<std::endl;
+    });
+  }
+
   ///////////////////////////////
   // RNG state
   ///////////////////////////////
-  static inline void writeRNGState(GridSerialRNG &serial,GridParallelRNG &parallel,std::string file)
+  static inline void rngHeader(GridBase *grid,FieldMetaData &header)
   {
-    typedef typename GridParallelRNG::RngStateType RngStateType;
-
     // Following should become arguments
-    FieldMetaData header;
     header.sequence_number = 1;
     header.ensemble_id     = "UKQCD";
     header.ensemble_label  = "DWF";
 
-    GridBase *grid = parallel.Grid();
-
     GridMetaData(grid,header);
     assert(header.nd==4);
     header.link_trace=0.0;
     header.plaquette=0.0;
     MachineCharacteristics(header);
 
-	uint64_t offset;
-  
 #ifdef RNG_RANLUX
     header.floating_point = std::string("UINT64");
     header.data_type      = std::string("RANLUX48");
@@ -292,7 +338,20 @@ public:
     header.floating_point = std::string("UINT64");
     header.data_type      = std::string("SITMO");
 #endif
+  }
+
+  static inline void writeRNGState(GridSerialRNG &serial,GridParallelRNG &parallel,std::string file)
+  {
+    typedef typename GridParallelRNG::RngStateType RngStateType;
 
+    FieldMetaData header;
+
+    GridBase *grid = parallel.Grid();
+
+    rngHeader(grid,header);
+
+	uint64_t offset;
+  
 	if ( grid->IsBoss() ) { 
     truncate(file);
     offset = writeHeader(header,file);
@@ -312,6 +371,37 @@ public:
 	     <<std::dec<<std::endl;
 
   }
+
+  // Background write of the RNG state; as for writeConfiguration above
+  static inline void writeRNGState(BinaryIOAsyncWriter &writer,GridSerialRNG &serial,GridParallelRNG &parallel,std::string file)
+  {
+    writer.Wait();
+
+    FieldMetaData header;
+
+    GridBase *grid = parallel.Grid();
+
+    rngHeader(grid,header);
+
+    uint64_t offset;
+    if ( grid->IsBoss() ) { 
+      truncate(file);
+      offset = writeHeader(header,file);
+    }
+    grid->Broadcast(0,(void *)&offset,sizeof(offset));
+
+    writer.AddRNG(serial,parallel,file,offset,
+		  [grid,header,file](uint32_t nersc_csum,uint32_t scidac_csuma,uint32_t scidac_csumb) mutable {
+      header.checksum = nersc_csum;
+      if ( grid->IsBoss() ) { 
+	writeHeader(header,file);
+      }
+      std::cout<<GridLogMessage 
+	       <<"Written NERSC RNG STATE "<<file<< " checksum "
+	       <<std::hex<<header.checksum
+	       <<std::dec<<std::endl;
+    });
+  }
     
   static inline void readRNGState(GridSerialRNG &serial,GridParallelRNG & parallel,FieldMetaData& header,std::string file)
   {
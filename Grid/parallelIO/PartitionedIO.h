@@ -0,0 +1,389 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/PartitionedIO.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#pragma once
+
+#include <sys/stat.h>
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Partitioned lattice files: a directory holding one data file per I/O group
+// of ranks and an XML manifest.
+//
+//   <path>/manifest.xml   global layout, format and per chunk checksums
+//   <path>/part.<group>   the chunks of ranks group*ranksPerFile ... , back to back
+//
+// A chunk is one writer's local volume in local lexicographic order, in file
+// byte order. Each rank pwrite()s its own chunk; there is no shared file and no
+// collective MPI-IO, so bandwidth grows with the number of groups.
+//
+// Reading works on any decomposition of the same global lattice: each rank
+// intersects its hyperslab with the chunks and reads the overlapping runs of
+// sites from the files holding them. The NERSC sum and SciDAC checksums are
+// independent of the decomposition and are checked globally; when a rank's
+// volume coincides with a chunk, the chunk's own checksums are checked too.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class PartitionedIOChunk : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(PartitionedIOChunk,
+				  std::string, file,
+				  uint64_t, offset,
+				  std::vector<int>, start,
+				  std::vector<int>, dimension,
+				  uint32_t, checksum,
+				  uint32_t, scidac_checksuma,
+				  uint32_t, scidac_checksumb);
+};
+
+class PartitionedIOManifest : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(PartitionedIOManifest,
+				  std::string, data_type,
+				  std::string, floating_point,
+				  int, site_bytes,
+				  std::vector<int>, dimension,
+				  std::vector<int>, processors,
+				  int, ranks_per_file,
+				  uint32_t, checksum,
+				  uint32_t, scidac_checksuma,
+				  uint32_t, scidac_checksumb,
+				  std::vector<PartitionedIOChunk>, chunks);
+};
+
+class PartitionedIO {
+public:
+
+  static inline std::string manifestFile(const std::string &path) { return path + "/manifest.xml"; }
+  static inline std::string partFile(int group) { return "part." + std::to_string(group); }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Write a Lattice of object
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  static inline void writeLatticeObject(Lattice<vobj> &Umu,
+					std::string path,
+					munger munge,
+					const std::string &format,
+					const std::string &data_type,
+					int ranksPerFile,
+					uint32_t &nersc_csum,
+					uint32_t &scidac_csuma,
+					uint32_t &scidac_csumb)
+  {
+    typedef typename vobj::scalar_object sobj;
+
+    GridBase *grid = Umu.Grid();
+    int nd         = grid->Nd();
+    int nrank      = grid->ProcessorCount();
+    int myrank     = grid->ThisRank();
+    uint64_t lsites= grid->lSites();
+    assert(ranksPerFile>=1);
+
+    int group  = myrank / ranksPerFile;
+    int member = myrank % ranksPerFile;
+    std::string file   = path + "/" + partFile(group);
+    uint64_t    offset = member * lsites * sizeof(fobj);
+
+    GridStopWatch timer;
+    GridStopWatch bstimer;
+
+    //////////////////////////////////////////////
+    // Directory, then the group files
+    //////////////////////////////////////////////
+    if ( grid->IsBoss() ) {
+      ::mkdir(path.c_str(),0755);
+    }
+    grid->Barrier();
+    uint32_t failed = 0;
+    if ( member == 0 ) {
+      int fd = ::open(file.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+      if ( fd < 0 ) failed = 1;
+      else          ::close(fd);
+    }
+    grid->GlobalSum(failed);
+    if ( failed ) {
+      std::cout << GridLogError << "PartitionedIO: cannot create files in " << path << std::endl;
+      assert(0);
+    }
+
+    //////////////////////////////////////////////
+    // Munge, checksum, byte order; then write
+    //////////////////////////////////////////////
+    bstimer.Start();
+    std::vector<sobj> scalardata(lsites);
+    std::vector<fobj> iodata(lsites);
+    unvectorizeToLexOrdArray(scalardata,Umu);
+    BinaryIO::encodeSites(grid,scalardata,iodata,munge,format,nersc_csum,scidac_csuma,scidac_csumb);
+    bstimer.Stop();
+
+    timer.Start();
+    int fd = ::open(file.c_str(),O_WRONLY);
+    if ( fd < 0 ) {
+      failed = 1;
+    } else {
+      failed = BinaryIO::writeBytes(fd,(char *)&iodata[0],lsites*sizeof(fobj),offset);
+      if ( ::close(fd) ) failed = 1;
+    }
+    timer.Stop();
+    grid->GlobalSum(failed);
+    if ( failed ) {
+      std::cout << GridLogError << "PartitionedIO: write to " << path << " failed on " << failed << " rank(s)" << std::endl;
+      assert(0);
+    }
+
+    //////////////////////////////////////////////
+    // Chunk checksums to the boss, and the totals
+    //////////////////////////////////////////////
+    std::vector<uint64_t> chunk_csum(3*nrank,0);
+    chunk_csum[3*myrank+0] = nersc_csum;
+    chunk_csum[3*myrank+1] = scidac_csuma;
+    chunk_csum[3*myrank+2] = scidac_csumb;
+    grid->GlobalSumVector(&chunk_csum[0],3*nrank);
+    BinaryIO::globalChecksums(grid,nersc_csum,scidac_csuma,scidac_csumb);
+
+    if ( grid->IsBoss() ) {
+      PartitionedIOManifest manifest;
+      manifest.data_type        = data_type;
+      manifest.floating_point   = format;
+      manifest.site_bytes       = sizeof(fobj);
+      manifest.ranks_per_file   = ranksPerFile;
+      manifest.checksum         = nersc_csum;
+      manifest.scidac_checksuma = scidac_csuma;
+      manifest.scidac_checksumb = scidac_csumb;
+      manifest.dimension.resize(nd);
+      manifest.processors.resize(nd);
+      for(int d=0;d<nd;d++){
+	manifest.dimension[d]  = grid->FullDimensions()[d];
+	manifest.processors[d] = grid->ProcessorGrid()[d];
+      }
+      manifest.chunks.resize(nrank);
+      for(int r=0;r<nrank;r++){
+	Coordinate pcoor;
+	grid->ProcessorCoorFromRank(r,pcoor);
+	PartitionedIOChunk &chunk = manifest.chunks[r];
+	chunk.file   = partFile(r/ranksPerFile);
+	chunk.offset = (r%ranksPerFile)*lsites*sizeof(fobj);
+	chunk.start.resize(nd);
+	chunk.dimension.resize(nd);
+	for(int d=0;d<nd;d++){
+	  chunk.dimension[d] = grid->LocalDimensions()[d];
+	  chunk.start[d]     = pcoor[d]*grid->LocalDimensions()[d];
+	}
+	chunk.checksum         = chunk_csum[3*r+0];
+	chunk.scidac_checksuma = chunk_csum[3*r+1];
+	chunk.scidac_checksumb = chunk_csum[3*r+2];
+      }
+      XmlWriter WR(manifestFile(path));
+      write(WR,"PartitionedIOManifest",manifest);
+    }
+    grid->Barrier();
+
+    auto &p = BinaryIO::lastPerf;
+    p.size            = sizeof(fobj)*grid->gSites();
+    p.time            = timer.useconds();
+    p.mbytesPerSecond = p.size/1024./1024./(p.time/1.0e6);
+    std::cout << GridLogMessage << "PartitionedIO: wrote " << path << " in " << (nrank+ranksPerFile-1)/ranksPerFile
+	      << " file(s), " << p.size << " bytes in " << timer.Elapsed() << " " << p.mbytesPerSecond << " MB/s"
+	      << "; munge and checksum " << bstimer.Elapsed() << std::endl;
+    std::cout << GridLogMessage << "PartitionedIO: checksums " << std::hex << nersc_csum << "/"
+	      << scidac_csuma << "/" << scidac_csumb << std::dec << std::endl;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Read a Lattice of object, on any decomposition of the same lattice
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  static inline void readLatticeObject(Lattice<vobj> &Umu,
+				       std::string path,
+				       munger munge,
+				       uint32_t &nersc_csum,
+				       uint32_t &scidac_csuma,
+				       uint32_t &scidac_csumb)
+  {
+    typedef typename vobj::scalar_object sobj;
+
+    GridBase *grid  = Umu.Grid();
+    int nd          = grid->Nd();
+    uint64_t lsites = grid->lSites();
+    Coordinate ldims  = grid->LocalDimensions();
+    Coordinate lstart = grid->LocalStarts();
+
+    PartitionedIOManifest manifest;
+    readManifest(grid,path,manifest);
+
+    assert(manifest.site_bytes == sizeof(fobj));
+    assert(manifest.dimension.size() == nd);
+    for(int d=0;d<nd;d++) assert(manifest.dimension[d] == grid->FullDimensions()[d]);
+
+    GridStopWatch timer;
+    GridStopWatch bstimer;
+
+    //////////////////////////////////////////////
+    // Overlapping runs of every chunk
+    //////////////////////////////////////////////
+    timer.Start();
+    std::vector<fobj> iodata(lsites);
+    uint32_t failed = 0;
+    int      mychunk = -1;
+    for(int c=0;c<manifest.chunks.size();c++){
+      PartitionedIOChunk &chunk = manifest.chunks[c];
+      Coordinate lo(nd), hi(nd);
+      bool overlap = true;
+      bool same    = true;
+      for(int d=0;d<nd;d++){
+	lo[d] = std::max(lstart[d],chunk.start[d]);
+	hi[d] = std::min(lstart[d]+ldims[d],chunk.start[d]+chunk.dimension[d]);
+	if ( lo[d] >= hi[d] ) overlap = false;
+	if ( (lstart[d]!=chunk.start[d]) || (ldims[d]!=chunk.dimension[d]) ) same = false;
+      }
+      if ( !overlap ) continue;
+      if ( same ) mychunk = c;
+
+      int fd = ::open((path+"/"+chunk.file).c_str(),O_RDONLY);
+      if ( fd < 0 ) { failed = 1; continue; }
+
+      // Runs along x; merged while contiguous both in the file and locally
+      Coordinate extent(nd), coor(nd);
+      uint64_t rows = 1;
+      for(int d=1;d<nd;d++) { extent[d] = hi[d]-lo[d]; rows *= extent[d]; }
+      uint64_t len = hi[0]-lo[0];
+      uint64_t run_local = 0, run_file = 0, run_len = 0;
+      for(uint64_t r=0;r<rows;r++){
+	uint64_t rem = r;
+	coor[0] = lo[0];
+	for(int d=1;d<nd;d++) { coor[d] = lo[d] + rem % extent[d]; rem /= extent[d]; }
+	uint64_t local = 0, infile = 0, ls = 1, fs = 1;
+	for(int d=0;d<nd;d++){
+	  local  += (coor[d]-lstart[d])*ls;        ls *= ldims[d];
+	  infile += (coor[d]-chunk.start[d])*fs;   fs *= chunk.dimension[d];
+	}
+	if ( run_len && (local == run_local+run_len) && (infile == run_file+run_len) ) {
+	  run_len += len;
+	} else {
+	  if ( run_len ) failed |= BinaryIO::readBytes(fd,(char *)&iodata[run_local],run_len*sizeof(fobj),chunk.offset+run_file*sizeof(fobj));
+	  run_local = local;
+	  run_file  = infile;
+	  run_len   = len;
+	}
+      }
+      if ( run_len ) failed |= BinaryIO::readBytes(fd,(char *)&iodata[run_local],run_len*sizeof(fobj),chunk.offset+run_file*sizeof(fobj));
+      ::close(fd);
+    }
+    timer.Stop();
+    grid->GlobalSum(failed);
+    if ( failed ) {
+      std::cout << GridLogError << "PartitionedIO: read of " << path << " failed on " << failed << " rank(s)" << std::endl;
+      assert(0);
+    }
+
+    //////////////////////////////////////////////
+    // Checksum, byte order, munge
+    //////////////////////////////////////////////
+    bstimer.Start();
+    std::vector<sobj> scalardata(lsites);
+    BinaryIO::decodeSites(grid,iodata,scalardata,munge,manifest.floating_point,nersc_csum,scidac_csuma,scidac_csumb);
+
+    uint32_t badchunks = 0;
+    if ( mychunk >= 0 ) {
+      PartitionedIOChunk &chunk = manifest.chunks[mychunk];
+      if ( (chunk.checksum != nersc_csum) || (chunk.scidac_checksuma != scidac_csuma) || (chunk.scidac_checksumb != scidac_csumb) ) {
+	badchunks = 1;
+      }
+    }
+    grid->GlobalSum(badchunks);
+    BinaryIO::globalChecksums(grid,nersc_csum,scidac_csuma,scidac_csumb);
+
+    vectorizeFromLexOrdArray(scalardata,Umu);
+    bstimer.Stop();
+
+    auto &p = BinaryIO::lastPerf;
+    p.size            = manifest.site_bytes*grid->gSites();
+    p.time            = timer.useconds();
+    p.mbytesPerSecond = p.size/1024./1024./(p.time/1.0e6);
+    std::cout << GridLogMessage << "PartitionedIO: read " << path << " " << p.size << " bytes in "
+	      << timer.Elapsed() << " " << p.mbytesPerSecond << " MB/s"
+	      << "; munge, checksum and vectorize " << bstimer.Elapsed() << std::endl;
+
+    if ( badchunks ) {
+      std::cout << GridLogError << "PartitionedIO: " << badchunks << " chunk checksum(s) of " << path << " disagree" << std::endl;
+    }
+    if ( (nersc_csum != manifest.checksum) || (scidac_csuma != manifest.scidac_checksuma) || (scidac_csumb != manifest.scidac_checksumb) ) {
+      std::cout << GridLogError << "PartitionedIO: checksums " << std::hex << nersc_csum << "/" << scidac_csuma << "/" << scidac_csumb
+		<< " manifest " << manifest.checksum << "/" << manifest.scidac_checksuma << "/" << manifest.scidac_checksumb
+		<< std::dec << std::endl;
+    }
+    assert(badchunks == 0);
+    assert(nersc_csum   == manifest.checksum);
+    assert(scidac_csuma == manifest.scidac_checksuma);
+    assert(scidac_csumb == manifest.scidac_checksumb);
+    std::cout << GridLogMessage << "PartitionedIO: " << path << " checksums agree with the manifest" << std::endl;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Gauge configurations, always 3x3 double as NerscIO
+  /////////////////////////////////////////////////////////////////////////////
+  static inline void writeConfiguration(Lattice<vLorentzColourMatrixD> &Umu,std::string path,int ranksPerFile=1)
+  {
+    typedef LorentzColourMatrixD sobj;
+    GaugeSimpleUnmunger<sobj,sobj> munge;
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    writeLatticeObject<vLorentzColourMatrixD,sobj>(Umu,path,munge,"IEEE64BIG","4D_SU3_GAUGE_3x3",ranksPerFile,
+						   nersc_csum,scidac_csuma,scidac_csumb);
+  }
+  static inline void readConfiguration(Lattice<vLorentzColourMatrixD> &Umu,std::string path)
+  {
+    typedef LorentzColourMatrixD sobj;
+    GaugeSimpleMunger<sobj,sobj> munge;
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    readLatticeObject<vLorentzColourMatrixD,sobj>(Umu,path,munge,nersc_csum,scidac_csuma,scidac_csumb);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // The boss reads the manifest and broadcasts it
+  /////////////////////////////////////////////////////////////////////////////
+  static inline void readManifest(GridBase *grid,const std::string &path,PartitionedIOManifest &manifest)
+  {
+    std::string xml;
+    uint64_t bytes = 0;
+    if ( grid->IsBoss() ) {
+      std::ifstream fin(manifestFile(path));
+      if ( !fin.good() ) {
+	std::cout << GridLogError << "PartitionedIO: no manifest " << manifestFile(path) << std::endl;
+	assert(0);
+      }
+      std::stringstream ss; ss << fin.rdbuf();
+      xml   = ss.str();
+      bytes = xml.size();
+    }
+    grid->Broadcast(0,(void *)&bytes,sizeof(bytes));
+    xml.resize(bytes);
+    grid->Broadcast(0,(void *)&xml[0],bytes);
+    XmlReader RD(xml,true);
+    read(RD,"PartitionedIOManifest",manifest);
+  }
+};
+
+NAMESPACE_END(Grid);
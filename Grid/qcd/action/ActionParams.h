@@ -35,26 +35,30 @@ directory
 NAMESPACE_BEGIN(Grid);
 
 // These can move into a params header and be given MacroMagic serialisation
+// commsPrecision is a CommsPrecisionPolicy for the halo exchange of Dhop
 struct GparityWilsonImplParams {
   Coordinate twists;
-  GparityWilsonImplParams() : twists(Nd, 0) {};
+  int commsPrecision;
+  GparityWilsonImplParams() : twists(Nd, 0), commsPrecision(CommsPrecisionNative) {};
 };
   
 struct WilsonImplParams {
   bool overlapCommsCompute;
+  int  commsPrecision;
   AcceleratorVector<Real,Nd> twist_n_2pi_L;
   AcceleratorVector<Complex,Nd> boundary_phases;
-  WilsonImplParams()  {
+  WilsonImplParams() : commsPrecision(CommsPrecisionNative) {
     boundary_phases.resize(Nd, 1.0);
       twist_n_2pi_L.resize(Nd, 0.0);
   };
-  WilsonImplParams(const AcceleratorVector<Complex,Nd> phi) : boundary_phases(phi), overlapCommsCompute(false) {
+  WilsonImplParams(const AcceleratorVector<Complex,Nd> phi) : boundary_phases(phi), overlapCommsCompute(false), commsPrecision(CommsPrecisionNative) {
     twist_n_2pi_L.resize(Nd, 0.0);
   }
 };
 
 struct StaggeredImplParams {
-  StaggeredImplParams()  {};
+  int commsPrecision;
+  StaggeredImplParams() : commsPrecision(CommsPrecisionNative) {};
 };
   
   struct OneFlavourRationalParams : Serializable {
@@ -86,6 +90,20 @@ struct StaggeredImplParams {
         BoundsCheckFreq(_BoundsCheckFreq){};
   };
   
+  // Chronological initial guesses for the two flavour force solves.
+  // history = 0 keeps the zero guess; tolerance_factor < 1 tightens the
+  // (ConjugateGradient) derivative solver while a history is in use, so the
+  // MD remains reversible to the precision of the solve.
+  struct ChronoForecastParams : Serializable {
+    GRID_SERIALIZABLE_CLASS_MEMBERS(ChronoForecastParams,
+				    int,   history,
+				    RealD, tolerance_factor);
+
+  ChronoForecastParams(int _history = 0, RealD _tolerance_factor = 1.0)
+      : history(_history),
+	tolerance_factor(_tolerance_factor){};
+  };
+
 NAMESPACE_END(Grid);
 
 #endif
@@ -75,6 +75,17 @@ public:
     this->DhopDerivEO(mat, U, V, dag);
   };
 
+  // MooeeInv and M5D carry the EOFA shift terms, which the fused Cayley
+  // kernel does not know about; keep the separate passes
+  virtual void MooeeInvMeooe(const FermionField& in, FermionField& out, FermionField& tmp){
+    this->Meooe(in, tmp);
+    this->MooeeInv(tmp, out);
+  };
+  virtual void MooeeInvDagMeooeDag(const FermionField& in, FermionField& out, FermionField& tmp){
+    this->MeooeDag(in, tmp);
+    this->MooeeInvDag(tmp, out);
+  };
+
   // Recompute 5D coefficients for different value of shift constant
   // (needed for heatbath loop over poles)
   virtual void RefreshShiftCoefficients(RealD new_shift) = 0;
@@ -0,0 +1,144 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/fermion/CayleyColumnHelpers.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+/*  END LEGAL */
+
+
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Fifth dimension matrices of the Cayley form fermions acting on one Ls column,
+// the Ls consecutive 5d sites ss..ss+Ls-1 above a single 4d site.
+//
+// Shared by the CayleyFermion5D passes over the whole field and by the fused
+// hopping kernel, which applies them to each column as soon as its 4d hop is
+// complete. Both in-place safe: chi may be the same view as psi.
+////////////////////////////////////////////////////////////////////////////////
+class CayleyColumnHelpers {
+public:
+
+  // chi = M5^dag chi; lower/diag/upper as passed to CayleyFermion5D::M5Ddag.
+  // Two spinors are carried so no element is read after it is overwritten.
+  template<class View,class Coeff>
+  static accelerator_inline void M5DdagInPlace(const View &chi,uint64_t ss,int Ls,
+					       const Coeff *plower,const Coeff *pdiag,const Coeff *pupper)
+  {
+    typedef decltype(coalescedRead(chi[0])) spinor;
+    spinor first, prev, cur, next, tmp1, tmp2;
+    first = chi(ss);
+    prev  = chi(ss+Ls-1);
+    cur   = first;
+    for(int s=0;s<Ls;s++){
+      if ( s==Ls-1 ) next = first;
+      else           next = chi(ss+s+1);
+      spProj5p(tmp1,next);
+      spProj5m(tmp2,prev);
+      coalescedWrite(chi[ss+s],pdiag[s]*cur+pupper[s]*tmp1+plower[s]*tmp2);
+      prev = cur;
+      cur  = next;
+    }
+  }
+
+  // chi = Mooee^{-1} psi from the LDU factorisation
+  template<class View,class Coeff>
+  static accelerator_inline void MooeeInv(const View &psi,const View &chi,uint64_t ss,int Ls,
+					  const Coeff *plee,const Coeff *pdee,const Coeff *puee,
+					  const Coeff *pleem,const Coeff *pueem)
+  {
+    typedef decltype(coalescedRead(psi[0])) spinor;
+    spinor tmp, acc, res;
+
+    // X = Nc*Ns
+    // flops = 2X + (Ls-2)(4X + 4X) + 6X + 1 + 2X + (Ls-1)(10X + 1) = -16X + Ls(1+18X) = -192 + 217*Ls flops
+    // Apply (L^{\prime})^{-1} L_m^{-1}
+    res = psi(ss);
+    spProj5m(tmp,res);
+    acc = pleem[0]*tmp;
+    spProj5p(tmp,res);
+    coalescedWrite(chi[ss],res);
+
+    for(int s=1;s<Ls-1;s++){
+      res = psi(ss+s);
+      res -= plee[s-1]*tmp;
+      spProj5m(tmp,res);
+      acc += pleem[s]*tmp;
+      spProj5p(tmp,res);
+      coalescedWrite(chi[ss+s],res);
+    }
+    res = psi(ss+Ls-1) - plee[Ls-2]*tmp - acc;
+
+    // Apply U_m^{-1} D^{-1} U^{-1}
+    res = (1.0/pdee[Ls-1])*res;
+    coalescedWrite(chi[ss+Ls-1],res);
+    spProj5p(acc,res);
+    spProj5m(tmp,res);
+    for (int s=Ls-2;s>=0;s--){
+      res = (1.0/pdee[s])*chi(ss+s) - puee[s]*tmp - pueem[s]*acc;
+      spProj5m(tmp,res);
+      coalescedWrite(chi[ss+s],res);
+    }
+  }
+
+  // chi = Mooee^{-dag} psi from the same factorisation
+  template<class View,class Coeff>
+  static accelerator_inline void MooeeInvDag(const View &psi,const View &chi,uint64_t ss,int Ls,
+					     const Coeff *plee,const Coeff *pdee,const Coeff *puee,
+					     const Coeff *pleem,const Coeff *pueem)
+  {
+    typedef decltype(coalescedRead(psi[0])) spinor;
+    spinor tmp, acc, res;
+
+    // Apply (U^{\prime})^{-dagger} U_m^{-\dagger}
+    res = psi(ss);
+    spProj5p(tmp,res);
+    acc = conjugate(pueem[0])*tmp;
+    spProj5m(tmp,res);
+    coalescedWrite(chi[ss],res);
+
+    for(int s=1;s<Ls-1;s++){
+      res = psi(ss+s);
+      res -= conjugate(puee[s-1])*tmp;
+      spProj5p(tmp,res);
+      acc += conjugate(pueem[s])*tmp;
+      spProj5m(tmp,res);
+      coalescedWrite(chi[ss+s],res);
+    }
+    res = psi(ss+Ls-1) - conjugate(puee[Ls-2])*tmp - acc;
+
+    // Apply L_m^{-\dagger} D^{-dagger} L^{-dagger}
+    res = conjugate(1.0/pdee[Ls-1])*res;
+    coalescedWrite(chi[ss+Ls-1],res);
+    spProj5m(acc,res);
+    spProj5p(tmp,res);
+    for (int s=Ls-2;s>=0;s--){
+      res = conjugate(1.0/pdee[s])*chi(ss+s) - conjugate(plee[s])*tmp - conjugate(pleem[s])*acc;
+      spProj5p(tmp,res);
+      coalescedWrite(chi[ss+s],res);
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
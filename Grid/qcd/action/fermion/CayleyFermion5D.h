@@ -52,6 +52,10 @@ public:
   virtual void   MooeeInvDag (const FermionField &in, FermionField &out);
   virtual void   Meo5D (const FermionField &psi, FermionField &chi);
 
+  // Schur operator building blocks; fused into the hopping kernel with --dslash-fuse-cayley
+  virtual void   MooeeInvMeooe       (const FermionField &in, FermionField &out, FermionField &tmp);
+  virtual void   MooeeInvDagMeooeDag (const FermionField &in, FermionField &out, FermionField &tmp);
+
   virtual void   M5D   (const FermionField &psi, FermionField &chi);
   virtual void   M5Ddag(const FermionField &psi, FermionField &chi);
 
@@ -106,6 +110,8 @@ public:
 
   void   Meooe5D       (const FermionField &in, FermionField &out);
   void   MeooeDag5D    (const FermionField &in, FermionField &out);
+  void   MeooeDag5DCoefficients(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+  void   MooeeInvMeooeInternal (const FermionField &in, FermionField &out, FermionField &tmp, int dag);
 
   //    protected:
   RealD mass;
@@ -173,7 +179,7 @@ public:
 		  GridRedBlackCartesian &FiveDimRedBlackGrid,
 		  GridCartesian         &FourDimGrid,
 		  GridRedBlackCartesian &FourDimRedBlackGrid,
-		  RealD _mass,RealD _M5,const ImplParams &p= ImplParams());
+		  RealD _mass,RealD _M5,const ImplParams &p= ImplParams(),int _Nrhs=1);
 
   void CayleyReport(void);
   void CayleyZeroCounters(void);
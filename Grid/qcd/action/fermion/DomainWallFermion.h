@@ -110,14 +110,14 @@ public:
 		    GridRedBlackCartesian &FiveDimRedBlackGrid,
 		    GridCartesian         &FourDimGrid,
 		    GridRedBlackCartesian &FourDimRedBlackGrid,
-		    RealD _mass,RealD _M5,const ImplParams &p= ImplParams()) : 
+		    RealD _mass,RealD _M5,const ImplParams &p= ImplParams(),int _Nrhs=1) : 
 
 
     CayleyFermion5D<Impl>(_Umu,
 			  FiveDimGrid,
 			  FiveDimRedBlackGrid,
 			  FourDimGrid,
-			  FourDimRedBlackGrid,_mass,_M5,p)
+			  FourDimRedBlackGrid,_mass,_M5,p,_Nrhs)
 
   {
     RealD eps = 1.0;
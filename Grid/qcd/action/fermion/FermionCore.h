@@ -41,6 +41,8 @@ NAMESPACE_CHECK(Compressor);
 NAMESPACE_CHECK(FermionOperatorImpl);
 #include <Grid/qcd/action/fermion/FermionOperator.h>
 NAMESPACE_CHECK(FermionOperator);
+#include <Grid/qcd/action/fermion/PackedCloverHelpers.h>  //used by clover and the fused wilson kernels
+#include <Grid/qcd/action/fermion/CayleyColumnHelpers.h>  //used by cayley fermions and the fused wilson kernels
 #include <Grid/qcd/action/fermion/WilsonKernels.h>        //used by all wilson type fermions
 #include <Grid/qcd/action/fermion/StaggeredKernels.h>        //used by all wilson type fermions
 NAMESPACE_CHECK(Kernels);
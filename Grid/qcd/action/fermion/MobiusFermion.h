@@ -48,13 +48,13 @@ public:
 		GridCartesian         &FourDimGrid,
 		GridRedBlackCartesian &FourDimRedBlackGrid,
 		RealD _mass,RealD _M5,
-		RealD b, RealD c,const ImplParams &p= ImplParams()) : 
+		RealD b, RealD c,const ImplParams &p= ImplParams(),int _Nrhs=1) : 
       
     CayleyFermion5D<Impl>(_Umu,
 			  FiveDimGrid,
 			  FiveDimRedBlackGrid,
 			  FourDimGrid,
-			  FourDimRedBlackGrid,_mass,_M5,p)
+			  FourDimRedBlackGrid,_mass,_M5,p,_Nrhs)
 
   {
     RealD eps = 1.0;
@@ -0,0 +1,241 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/fermion/PackedCloverHelpers.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+/*  END LEGAL */
+
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Packed clover term.
+//
+// In the chiral basis sigma_{mu nu} is block diagonal in spin, so the clover
+// term and its inverse are two Hermitian blocks of size Nblock = Ns/2 x Dimension:
+// upper spins {0,1} and lower spins {2,3}. Each block keeps its diagonal and
+// its strictly lower triangle (row major); the upper triangle is the conjugate.
+//
+//   Diagonal : 2 x Nblock                complex
+//   Triangle : 2 x Nblock (Nblock-1)/2   complex
+//
+// For Nc=3 this is 42 complex numbers per site against 144 for the 12x12
+// matrix. Row index within a block is (spin%2)*Dimension + colour.
+////////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+class PackedCloverHelpers {
+public:
+  INHERIT_IMPL_TYPES(Impl);
+
+  static const int Dimension = Impl::Dimension;
+  static const int Nblock    = (Ns/2)*Dimension;
+  static const int Ntri      = Nblock*(Nblock-1)/2;
+
+  template <typename vtype> using iImplClover         = iScalar<iMatrix<iMatrix<vtype, Dimension>, Ns>>;
+  template <typename vtype> using iImplCloverDiagonal = iScalar<iVector<iVector<vtype, Nblock>, 2>>;
+  template <typename vtype> using iImplCloverTriangle = iScalar<iVector<iVector<vtype, Ntri>, 2>>;
+
+  typedef Lattice<iImplClover<Simd>>         CloverField;
+  typedef Lattice<iImplCloverDiagonal<Simd>> CloverDiagonalField;
+  typedef Lattice<iImplCloverTriangle<Simd>> CloverTriangleField;
+
+  // Element (i,j), i>j, of the strictly lower triangle
+  static accelerator_inline int TriangleIndex(int i, int j) { return i*(i-1)/2 + j; }
+
+  ////////////////////////////////////////////////////////
+  // Full <-> packed. Only the lower triangle of a full
+  // matrix is read; it is assumed Hermitian.
+  ////////////////////////////////////////////////////////
+  static void Pack(const CloverField &full, CloverDiagonalField &diag, CloverTriangleField &tri)
+  {
+    conformable(full.Grid(), diag.Grid());
+    conformable(full.Grid(), tri.Grid());
+    diag.Checkerboard() = full.Checkerboard();
+    tri.Checkerboard()  = full.Checkerboard();
+
+    autoView(full_v, full, AcceleratorRead);
+    autoView(diag_v, diag, AcceleratorWrite);
+    autoView(tri_v , tri , AcceleratorWrite);
+    accelerator_for(ss, full.Grid()->oSites(), 1, {
+      for(int b=0;b<2;b++){
+	for(int i=0;i<Nblock;i++){
+	  int si = 2*b+i/Dimension, ci = i%Dimension;
+	  diag_v[ss]()(b)(i) = full_v[ss]()(si,si)(ci,ci);
+	  for(int j=0;j<i;j++){
+	    int sj = 2*b+j/Dimension, cj = j%Dimension;
+	    tri_v[ss]()(b)(TriangleIndex(i,j)) = full_v[ss]()(si,sj)(ci,cj);
+	  }
+	}
+      }
+    });
+  }
+
+  static void Unpack(const CloverDiagonalField &diag, const CloverTriangleField &tri, CloverField &full)
+  {
+    conformable(full.Grid(), diag.Grid());
+    conformable(full.Grid(), tri.Grid());
+    full.Checkerboard() = diag.Checkerboard();
+    full = Zero();
+
+    autoView(full_v, full, AcceleratorWrite);
+    autoView(diag_v, diag, AcceleratorRead);
+    autoView(tri_v , tri , AcceleratorRead);
+    accelerator_for(ss, full.Grid()->oSites(), 1, {
+      for(int b=0;b<2;b++){
+	for(int i=0;i<Nblock;i++){
+	  int si = 2*b+i/Dimension, ci = i%Dimension;
+	  full_v[ss]()(si,si)(ci,ci) = diag_v[ss]()(b)(i);
+	  for(int j=0;j<i;j++){
+	    int sj = 2*b+j/Dimension, cj = j%Dimension;
+	    full_v[ss]()(si,sj)(ci,cj) = tri_v[ss]()(b)(TriangleIndex(i,j));
+	    full_v[ss]()(sj,si)(cj,ci) = conjugate(tri_v[ss]()(b)(TriangleIndex(i,j)));
+	  }
+	}
+      }
+    });
+  }
+
+  ////////////////////////////////////////////////////////
+  // Invert both blocks of every site; done once per gauge
+  // field, on the host
+  ////////////////////////////////////////////////////////
+  static void Invert(const CloverDiagonalField &diag, const CloverTriangleField &tri,
+		     CloverDiagonalField &diagInv, CloverTriangleField &triInv)
+  {
+    GridBase *grid = diag.Grid();
+    conformable(grid, tri.Grid());
+    conformable(grid, diagInv.Grid());
+    conformable(grid, triInv.Grid());
+    diagInv.Checkerboard() = diag.Checkerboard();
+    triInv.Checkerboard()  = diag.Checkerboard();
+
+    autoView(diag_v   , diag   , CpuRead);
+    autoView(tri_v    , tri    , CpuRead);
+    autoView(diagInv_v, diagInv, CpuWrite);
+    autoView(triInv_v , triInv , CpuWrite);
+    thread_for(site, grid->lSites(), {
+      Coordinate lcoor;
+      grid->LocalIndexToLocalCoor(site, lcoor);
+      typename iImplCloverDiagonal<Simd>::scalar_object d, dinv;
+      typename iImplCloverTriangle<Simd>::scalar_object t, tinv;
+      peekLocalSite(d, diag_v, lcoor);
+      peekLocalSite(t, tri_v , lcoor);
+      Eigen::MatrixXcd block = Eigen::MatrixXcd::Zero(Nblock, Nblock);
+      for(int b=0;b<2;b++){
+	for(int i=0;i<Nblock;i++){
+	  block(i,i) = std::complex<double>(d()(b)(i));
+	  for(int j=0;j<i;j++){
+	    block(i,j) = std::complex<double>(t()(b)(TriangleIndex(i,j)));
+	    block(j,i) = std::conj(block(i,j));
+	  }
+	}
+	Eigen::MatrixXcd blockInv = block.inverse();
+	for(int i=0;i<Nblock;i++){
+	  dinv()(b)(i) = blockInv(i,i);
+	  for(int j=0;j<i;j++) tinv()(b)(TriangleIndex(i,j)) = blockInv(i,j);
+	}
+      }
+      pokeLocalSite(dinv, diagInv_v, lcoor);
+      pokeLocalSite(tinv, triInv_v , lcoor);
+    });
+  }
+
+  ////////////////////////////////////////////////////////
+  // Site multiply, unrolled over the packed blocks. The
+  // arithmetic is on whole SIMD words (or on the lane of a
+  // SIMT thread for the coalesced scalar types).
+  ////////////////////////////////////////////////////////
+  template<class vtype>
+  static accelerator_inline void MultSite(const iImplCloverDiagonal<vtype> &d,
+					  const iImplCloverTriangle<vtype> &t,
+					  const iVector<iVector<vtype, Dimension>, Ns> &in,
+					  iVector<iVector<vtype, Dimension>, Ns> &out)
+  {
+    for(int b=0;b<2;b++){
+      for(int i=0;i<Nblock;i++){
+	int si = 2*b+i/Dimension, ci = i%Dimension;
+	vtype r = d()(b)(i)*in(si)(ci);
+	for(int j=0;j<i;j++){
+	  r = r + t()(b)(TriangleIndex(i,j))*in(2*b+j/Dimension)(j%Dimension);
+	}
+	for(int j=i+1;j<Nblock;j++){
+	  r = r + conjugate(t()(b)(TriangleIndex(j,i)))*in(2*b+j/Dimension)(j%Dimension);
+	}
+	out(si)(ci) = r;
+      }
+    }
+  }
+  template<class vtype>
+  static accelerator_inline void MultSite(const iImplCloverDiagonal<vtype> &d,
+					  const iImplCloverTriangle<vtype> &t,
+					  const iScalar<iVector<iVector<vtype, Dimension>, Ns> > &in,
+					  iScalar<iVector<iVector<vtype, Dimension>, Ns> > &out)
+  {
+    MultSite(d, t, in(), out());
+  }
+  // Flavoured spinors (G-parity) share the clover term between flavours
+  template<class vtype, int Nf>
+  static accelerator_inline void MultSite(const iImplCloverDiagonal<vtype> &d,
+					  const iImplCloverTriangle<vtype> &t,
+					  const iVector<iVector<iVector<vtype, Dimension>, Ns>, Nf> &in,
+					  iVector<iVector<iVector<vtype, Dimension>, Ns>, Nf> &out)
+  {
+    for(int f=0;f<Nf;f++) MultSite(d, t, in(f), out(f));
+  }
+
+  // In place on site ss of an open view, as the fused kernels need
+  template<class DiagView, class TriView, class FermView>
+  static accelerator_inline void MultSiteInPlace(const DiagView &diag_v, const TriView &tri_v,
+						 const FermView &f_v, int ss)
+  {
+    auto in = coalescedRead(f_v[ss]);
+    decltype(in) out;
+    MultSite(coalescedRead(diag_v[ss]), coalescedRead(tri_v[ss]), in, out);
+    coalescedWrite(f_v[ss], out);
+  }
+
+  ////////////////////////////////////////////////////////
+  // out = C in, C a packed clover field; in place is fine
+  ////////////////////////////////////////////////////////
+  static void Mult(const CloverDiagonalField &diag, const CloverTriangleField &tri,
+		   const FermionField &in, FermionField &out)
+  {
+    conformable(in.Grid(), diag.Grid());
+    conformable(in.Grid(), tri.Grid());
+    conformable(in.Grid(), out.Grid());
+    out.Checkerboard() = in.Checkerboard();
+
+    autoView(diag_v, diag, AcceleratorRead);
+    autoView(tri_v , tri , AcceleratorRead);
+    autoView(in_v  , in  , AcceleratorRead);
+    autoView(out_v , out , AcceleratorWrite);
+    typedef decltype(coalescedRead(in_v[0])) calcSpinor;
+    accelerator_for(ss, in.Grid()->oSites(), Simd::Nsimd(), {
+      calcSpinor res;
+      MultSite(coalescedRead(diag_v[ss]), coalescedRead(tri_v[ss]), coalescedRead(in_v[ss]), res);
+      coalescedWrite(out_v[ss], res);
+    });
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -55,10 +55,13 @@ class WilsonCloverFermion : public WilsonFermion<Impl>
 public:
   // Types definitions
   INHERIT_IMPL_TYPES(Impl);
+  typedef PackedCloverHelpers<Impl> Packed;
   template <typename vtype>
   using iImplClover = iScalar<iMatrix<iMatrix<vtype, Impl::Dimension>, Ns>>;
   typedef iImplClover<Simd> SiteCloverType;
   typedef Lattice<SiteCloverType> CloverFieldType;
+  typedef typename Packed::CloverDiagonalField CloverDiagonalField;
+  typedef typename Packed::CloverTriangleField CloverTriangleField;
 
 public:
   typedef WilsonFermion<Impl> WilsonBase;
@@ -76,16 +79,14 @@ public:
                                                                                      Fgrid,
                                                                                      Hgrid,
                                                                                      _mass, impl_p, clover_anisotropy),
-                                                                 CloverTerm(&Fgrid),
-                                                                 CloverTermInv(&Fgrid),
-                                                                 CloverTermEven(&Hgrid),
-                                                                 CloverTermOdd(&Hgrid),
-                                                                 CloverTermInvEven(&Hgrid),
-                                                                 CloverTermInvOdd(&Hgrid),
-                                                                 CloverTermDagEven(&Hgrid),
-                                                                 CloverTermDagOdd(&Hgrid),
-                                                                 CloverTermInvDagEven(&Hgrid),
-                                                                 CloverTermInvDagOdd(&Hgrid)
+                                                                 CloverDiagonalEven(&Hgrid),
+                                                                 CloverDiagonalOdd(&Hgrid),
+                                                                 CloverTriangleEven(&Hgrid),
+                                                                 CloverTriangleOdd(&Hgrid),
+                                                                 CloverInvDiagonalEven(&Hgrid),
+                                                                 CloverInvDiagonalOdd(&Hgrid),
+                                                                 CloverInvTriangleEven(&Hgrid),
+                                                                 CloverInvTriangleOdd(&Hgrid)
   {
     assert(Nd == 4); // require 4 dimensions
 
@@ -117,6 +118,12 @@ public:
   virtual void MooeeInvDag(const FermionField &in, FermionField &out);
   virtual void MooeeInternal(const FermionField &in, FermionField &out, int dag, int inv);
 
+  // Schur operator building block, fused into one kernel when
+  // WilsonKernelsStatic::FuseClover is set and comms are not overlapped
+  virtual void MooeeInvMeooe(const FermionField &in, FermionField &out, FermionField &tmp);
+  virtual void MooeeInvDagMeooeDag(const FermionField &in, FermionField &out, FermionField &tmp);
+  void MooeeInvMeooeInternal(const FermionField &in, FermionField &out, FermionField &tmp, int dag);
+
   //virtual void MDeriv(GaugeField &mat, const FermionField &U, const FermionField &V, int dag);
   virtual void MooDeriv(GaugeField &mat, const FermionField &U, const FermionField &V, int dag);
   virtual void MeeDeriv(GaugeField &mat, const FermionField &U, const FermionField &V, int dag);
@@ -251,22 +258,27 @@ protected:
   RealD csw_r;                                               // Clover coefficient - spatial
   RealD csw_t;                                               // Clover coefficient - temporal
   RealD diag_mass;                                           // Mass term
-  CloverFieldType CloverTerm, CloverTermInv;                 // Clover term
-  CloverFieldType CloverTermEven, CloverTermOdd;             // Clover term EO
-  CloverFieldType CloverTermInvEven, CloverTermInvOdd;       // Clover term Inv EO
-  CloverFieldType CloverTermDagEven, CloverTermDagOdd;       // Clover term Dag EO
-  CloverFieldType CloverTermInvDagEven, CloverTermInvDagOdd; // Clover term Inv Dag EO
+
+  // Clover term and its inverse, packed chiral blocks (PackedCloverHelpers).
+  // Both are Hermitian, so the daggered operators share them.
+  CloverDiagonalField CloverDiagonalEven, CloverDiagonalOdd;       // Clover term EO
+  CloverTriangleField CloverTriangleEven, CloverTriangleOdd;
+  CloverDiagonalField CloverInvDiagonalEven, CloverInvDiagonalOdd; // Clover term Inv EO
+  CloverTriangleField CloverInvTriangleEven, CloverInvTriangleOdd;
 
  public:
-  // eventually these can be compressed into 6x6 blocks instead of the 12x12
-  // using the DeGrand-Rossi basis for the gamma matrices
+  // Full 12x12 matrices rebuilt from the packed blocks, for tests and diagnostics
+  CloverFieldType CloverTermFull(void);
+  CloverFieldType CloverTermInvFull(void);
+
+  // The chiral basis makes each of these block diagonal in spin
   CloverFieldType fillCloverYZ(const GaugeLinkField &F)
   {
     CloverFieldType T(F.Grid());
     T = Zero();
     autoView(T_v,T,AcceleratorWrite);
     autoView(F_v,F,AcceleratorRead);
-    accelerator_for(i, CloverTerm.Grid()->oSites(),1,
+    accelerator_for(i, F.Grid()->oSites(),1,
     {
       T_v[i]()(0, 1) = timesMinusI(F_v[i]()());
       T_v[i]()(1, 0) = timesMinusI(F_v[i]()());
@@ -284,7 +296,7 @@ protected:
     
     autoView(T_v, T,AcceleratorWrite);
     autoView(F_v, F,AcceleratorRead);
-    accelerator_for(i, CloverTerm.Grid()->oSites(),1,
+    accelerator_for(i, F.Grid()->oSites(),1,
     {
       T_v[i]()(0, 1) = -F_v[i]()();
       T_v[i]()(1, 0) = F_v[i]()();
@@ -302,7 +314,7 @@ protected:
 
     autoView(T_v,T,AcceleratorWrite);
     autoView(F_v,F,AcceleratorRead);
-    accelerator_for(i, CloverTerm.Grid()->oSites(),1,
+    accelerator_for(i, F.Grid()->oSites(),1,
     {
       T_v[i]()(0, 0) = timesMinusI(F_v[i]()());
       T_v[i]()(1, 1) = timesI(F_v[i]()());
@@ -320,7 +332,7 @@ protected:
 
     autoView( T_v , T, AcceleratorWrite);
     autoView( F_v , F, AcceleratorRead);
-    accelerator_for(i, CloverTerm.Grid()->oSites(),1,
+    accelerator_for(i, F.Grid()->oSites(),1,
     {
       T_v[i]()(0, 1) = timesI(F_v[i]()());
       T_v[i]()(1, 0) = timesI(F_v[i]()());
@@ -338,7 +350,7 @@ protected:
     
     autoView( T_v ,T,AcceleratorWrite);
     autoView( F_v ,F,AcceleratorRead);
-    accelerator_for(i, CloverTerm.Grid()->oSites(),1,
+    accelerator_for(i, F.Grid()->oSites(),1,
     {
       T_v[i]()(0, 1) = -(F_v[i]()());
       T_v[i]()(1, 0) = (F_v[i]()());
@@ -357,7 +369,7 @@ protected:
 
     autoView( T_v , T,AcceleratorWrite);
     autoView( F_v , F,AcceleratorRead);
-    accelerator_for(i, CloverTerm.Grid()->oSites(),1,
+    accelerator_for(i, F.Grid()->oSites(),1,
     {
       T_v[i]()(0, 0) = timesI(F_v[i]()());
       T_v[i]()(1, 1) = timesMinusI(F_v[i]()());
@@ -47,11 +47,13 @@ class WilsonCompressorTemplate< _HCspinor, _Hspinor, _Spinor, projector,
 public:
   
   int mu,dag;  
+  int precision; // CommsPrecisionPolicy; run time reduction of the halo
 
   void Point(int p) { mu=p; };
 
-  WilsonCompressorTemplate(int _dag=0){
+  WilsonCompressorTemplate(int _dag=0,int _precision=CommsPrecisionNative){
     dag = _dag;
+    precision = CommsPrecisionSelect<_Hspinor>(_precision);
   }
 
   typedef _Spinor         SiteSpinor;
@@ -62,7 +64,7 @@ public:
   constexpr static int Nw=sizeof(SiteHalfSpinor)/sizeof(vComplexHigh);
 
   accelerator_inline int CommDatumSize(void) {
-    return sizeof(SiteHalfCommSpinor);
+    return CommsDatumBytes<SiteHalfCommSpinor>(precision);
   }
 
   /*****************************************************/
@@ -72,7 +74,8 @@ public:
   accelerator_inline void Compress(_SiteHalfSpinor *buf,Integer o,const _SiteSpinor &in) {
     _SiteHalfSpinor tmp;
     projector::Proj(tmp,in,mu,dag);
-    vstream(buf[o],tmp);
+    if ( precision==CommsPrecisionNative ) vstream(buf[o],tmp);
+    else CommsPack(precision,(void *)buf,o,tmp);
   }
 
   /*****************************************************/
@@ -84,7 +87,14 @@ public:
 				   Integer type,Integer o){
     SiteHalfSpinor tmp1;
     SiteHalfSpinor tmp2;
-    exchange(tmp1,tmp2,vp0[o],vp1[o],type);
+    if ( precision==CommsPrecisionNative ) {
+      exchange(tmp1,tmp2,vp0[o],vp1[o],type);
+    } else {
+      SiteHalfSpinor vt0,vt1;
+      CommsUnpack(precision,vt0,(const void *)vp0,o);
+      CommsUnpack(precision,vt1,(const void *)vp1,o);
+      exchange(tmp1,tmp2,vt0,vt1,type);
+    }
     vstream(mp[2*o  ],tmp1);
     vstream(mp[2*o+1],tmp2);
   }
@@ -94,7 +104,8 @@ public:
   /*****************************************************/
   accelerator_inline void Decompress(SiteHalfSpinor * __restrict__ out,
 				     SiteHalfSpinor * __restrict__ in, Integer o) {    
-    assert(0);
+    assert(precision!=CommsPrecisionNative);
+    CommsUnpack(precision,out[o],(const void *)in,o);
   }
 
   /*****************************************************/
@@ -110,14 +121,19 @@ public:
     projector::Proj(temp1,in[k],mu,dag);
     projector::Proj(temp2,in[m],mu,dag);
     exchange(temp3,temp4,temp1,temp2,type);
-    vstream(out0[j],temp3);
-    vstream(out1[j],temp4);
+    if ( precision==CommsPrecisionNative ) {
+      vstream(out0[j],temp3);
+      vstream(out1[j],temp4);
+    } else {
+      CommsPack(precision,(void *)out0,j,temp3);
+      CommsPack(precision,(void *)out1,j,temp4);
+    }
   }
 
   /*****************************************************/
   /* Pass the info to the stencil */
   /*****************************************************/
-  accelerator_inline bool DecompressionStep(void) { return false; }
+  accelerator_inline bool DecompressionStep(void) { return precision!=CommsPrecisionNative; }
 
 };
 
@@ -128,11 +144,13 @@ class WilsonCompressorTemplate< _HCspinor, _Hspinor, _Spinor, projector,
 public:
   
   int mu,dag;  
+  int precision; // comms precision is fixed by the Impl type; run time policy ignored
 
   void Point(int p) { mu=p; };
 
-  WilsonCompressorTemplate(int _dag=0){
+  WilsonCompressorTemplate(int _dag=0,int _precision=CommsPrecisionNative){
     dag = _dag;
+    precision = CommsPrecisionNative;
   }
 
   typedef _Spinor         SiteSpinor;
@@ -361,16 +379,18 @@ public:
     
     this->u_comm_offset=0;
       
-    WilsonXpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> XpCompress; 
-    WilsonYpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> YpCompress; 
-    WilsonZpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> ZpCompress; 
-    WilsonTpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> TpCompress;
-    WilsonXmCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> XmCompress; 
-    WilsonYmCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> YmCompress; 
-    WilsonZmCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> ZmCompress; 
-    WilsonTmCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> TmCompress;
-
     int dag = compress.dag;
+    int precision = compress.precision;
+
+    WilsonXpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> XpCompress(0,precision); 
+    WilsonYpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> YpCompress(0,precision); 
+    WilsonZpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> ZpCompress(0,precision); 
+    WilsonTpCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> TpCompress(0,precision);
+    WilsonXmCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> XmCompress(0,precision); 
+    WilsonYmCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> YmCompress(0,precision); 
+    WilsonZmCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> ZmCompress(0,precision); 
+    WilsonTmCompressor<SiteHalfCommSpinor,SiteHalfSpinor,SiteSpinor> TmCompress(0,precision);
+
     int face_idx=0;
     if ( dag ) { 
       assert(this->same_node[Xp]==this->HaloGatherDir(source,XpCompress,Xp,face_idx));
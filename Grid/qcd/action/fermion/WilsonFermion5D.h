@@ -54,6 +54,14 @@ NAMESPACE_BEGIN(Grid);
 // i.e. even even contains fifth dim hopping term.
 //
 // [DIFFERS from original CPS red black implementation parity = (x+y+z+t+s)|2 ]
+//
+// Multiple right hand sides: with Nrhs>1 the fifth dimension of the grids is
+// Nrhs*Ls and holds Nrhs independent Ls-blocks, s fastest then rhs, so the
+// 5d site index is s + Ls*(rhs + Nrhs*site4d). The hopping term treats the
+// whole Nrhs*Ls extent as one s-loop: each link is loaded once for all
+// right hand sides and there is one halo message per direction. Ls is the
+// per-rhs extent; operators acting in s work within each block. Use
+// InsertRHS/ExtractRHS to move single fields in and out of the block.
 ////////////////////////////////////////////////////////////////////////////////
 
 class WilsonFermion5DStatic { 
@@ -172,7 +180,7 @@ public:
 		  GridRedBlackCartesian &FiveDimRedBlackGrid,
 		  GridCartesian         &FourDimGrid,
 		  GridRedBlackCartesian &FourDimRedBlackGrid,
-		  double _M5,const ImplParams &p= ImplParams());
+		  double _M5,const ImplParams &p= ImplParams(),int _Nrhs=1);
     
   // Constructors
   /*
@@ -199,7 +207,8 @@ public:
   GridBase *_FiveDimRedBlackGrid;
     
   double                        M5;
-  int Ls;
+  int Ls;   // per right hand side
+  int Nrhs; // Ls-blocks in the fifth dimension
     
   //Defines the stencils for even and odd
   StencilImpl Stencil; 
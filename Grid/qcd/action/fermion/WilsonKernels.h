@@ -42,6 +42,8 @@ public:
   enum { CommsAndCompute, CommsThenCompute };
   static int Opt;  
   static int Comms;
+  static int FuseClover; // Schur operators apply the inverse clover term inside the hopping kernel
+  static int FuseCayley; // Schur operators apply the Cayley fifth dimension matrices inside the hopping kernel
 };
  
 template<class Impl> class WilsonKernels : public FermionOperator<Impl> , public WilsonKernelsStatic { 
@@ -49,6 +51,8 @@ public:
 
   INHERIT_IMPL_TYPES(Impl);
   typedef FermionOperator<Impl> Base;
+  typedef typename PackedCloverHelpers<Impl>::CloverDiagonalField CloverDiagonalField;
+  typedef typename PackedCloverHelpers<Impl>::CloverTriangleField CloverTriangleField;
    
 public:
 
@@ -60,6 +64,23 @@ public:
 			    int Ls, int Nsite, const FermionField &in, FermionField &out,
 			    int interior=1,int exterior=1) ;
 
+  // out = C Dhop in, the packed clover C applied to each site as it is produced.
+  // Four dimensional (Ls=1) and with all halos already exchanged.
+  static void DhopCloverKernel(int Opt,StencilImpl &st,  DoubledGaugeField &U, SiteHalfSpinor * buf,
+			       int Nsite, const FermionField &in, FermionField &out,
+			       const CloverDiagonalField &diag, const CloverTriangleField &tri, int dag) ;
+
+  // Cayley form 5d fermions, s fastest in Ls columns with LLs = Nrhs*Ls sites per 4d site:
+  //   dag=0 : out = Mooee^{-1} Dhop in
+  //   dag=1 : out = Mooee^{-dag} M5^dag Dhop^dag in, with lower/diag/upper the M5^dag coefficients
+  // The 5th dimension matrices act on each column straight after its hopping term.
+  // All halos must already be exchanged.
+  static void DhopCayleyKernel(int Opt,StencilImpl &st,  DoubledGaugeField &U, SiteHalfSpinor * buf,
+			       int LLs, int Ls, int Nsite, const FermionField &in, FermionField &out,
+			       const Coeff_t *lower, const Coeff_t *diag, const Coeff_t *upper,
+			       const Coeff_t *lee, const Coeff_t *dee, const Coeff_t *uee,
+			       const Coeff_t *leem, const Coeff_t *ueem, int dag) ;
+
   static void DhopDirAll( StencilImpl &st, DoubledGaugeField &U,SiteHalfSpinor *buf, int Ls,
 			  int Nsite, const FermionField &in, std::vector<FermionField> &out) ;
 
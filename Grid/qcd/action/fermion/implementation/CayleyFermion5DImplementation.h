@@ -41,12 +41,12 @@ CayleyFermion5D<Impl>::CayleyFermion5D(GaugeField &_Umu,
 				       GridRedBlackCartesian &FiveDimRedBlackGrid,
 				       GridCartesian         &FourDimGrid,
 				       GridRedBlackCartesian &FourDimRedBlackGrid,
-				       RealD _mass,RealD _M5,const ImplParams &p) :
+				       RealD _mass,RealD _M5,const ImplParams &p,int _Nrhs) :
   WilsonFermion5D<Impl>(_Umu,
 			FiveDimGrid,
 			FiveDimRedBlackGrid,
 			FourDimGrid,
-			FourDimRedBlackGrid,_M5,p),
+			FourDimRedBlackGrid,_M5,p,_Nrhs),
   mass(_mass)
 { 
 }
@@ -58,6 +58,7 @@ template<class Impl>
 void CayleyFermion5D<Impl>::ExportPhysicalFermionSolution(const FermionField &solution5d,FermionField &exported4d)
 {
   int Ls = this->Ls;
+  assert(this->Nrhs==1); // 4d fields, single right hand side only
   FermionField tmp(this->FermionGrid());
   tmp = solution5d;
   conformable(solution5d.Grid(),this->FermionGrid());
@@ -71,9 +72,10 @@ void CayleyFermion5D<Impl>::P(const FermionField &psi, FermionField &chi)
 {
   int Ls= this->Ls;
   chi=Zero();
-  for(int s=0;s<Ls;s++){
+  for(int s=0;s<Ls*this->Nrhs;s++){
+    int b = s-s%Ls; // rhs block
     axpby_ssp_pminus(chi,1.0,chi,1.0,psi,s,s);
-    axpby_ssp_pplus (chi,1.0,chi,1.0,psi,s,(s+1)%Ls);
+    axpby_ssp_pplus (chi,1.0,chi,1.0,psi,s,b+(s-b+1)%Ls);
   }
 }
 template<class Impl>  
@@ -81,15 +83,17 @@ void CayleyFermion5D<Impl>::Pdag(const FermionField &psi, FermionField &chi)
 {
   int Ls= this->Ls;
   chi=Zero();
-  for(int s=0;s<Ls;s++){
+  for(int s=0;s<Ls*this->Nrhs;s++){
+    int b = s-s%Ls; // rhs block
     axpby_ssp_pminus(chi,1.0,chi,1.0,psi,s,s);
-    axpby_ssp_pplus (chi,1.0,chi,1.0,psi,s,(s-1+Ls)%Ls);
+    axpby_ssp_pplus (chi,1.0,chi,1.0,psi,s,b+(s-b-1+Ls)%Ls);
   }
 }
 template<class Impl>  
 void CayleyFermion5D<Impl>::ExportPhysicalFermionSource(const FermionField &solution5d,FermionField &exported4d)
 {
   int Ls = this->Ls;
+  assert(this->Nrhs==1); // 4d fields, single right hand side only
   FermionField tmp(this->FermionGrid());
   tmp = solution5d;
   conformable(solution5d.Grid(),this->FermionGrid());
@@ -102,6 +106,7 @@ template<class Impl>
 void CayleyFermion5D<Impl>::ImportUnphysicalFermion(const FermionField &input4d,FermionField &imported5d)
 {
   int Ls = this->Ls;
+  assert(this->Nrhs==1); // 4d fields, single right hand side only
   FermionField tmp(this->FermionGrid());
   conformable(imported5d.Grid(),this->FermionGrid());
   conformable(input4d.Grid()   ,this->GaugeGrid());
@@ -117,6 +122,7 @@ template<class Impl>
 void CayleyFermion5D<Impl>::ImportPhysicalFermionSource(const FermionField &input4d,FermionField &imported5d)
 {
   int Ls = this->Ls;
+  assert(this->Nrhs==1); // 4d fields, single right hand side only
   FermionField tmp(this->FermionGrid());
   conformable(imported5d.Grid(),this->FermionGrid());
   conformable(input4d.Grid()   ,this->GaugeGrid());
@@ -135,8 +141,8 @@ void CayleyFermion5D<Impl>::Dminus(const FermionField &psi, FermionField &chi)
   FermionField tmp_f(this->FermionGrid());
   this->DW(psi,tmp_f,DaggerNo);
 
-  for(int s=0;s<Ls;s++){
-    axpby_ssp(chi,Coeff_t(1.0),psi,-cs[s],tmp_f,s,s);// chi = (1-c[s] D_W) psi
+  for(int s=0;s<Ls*this->Nrhs;s++){
+    axpby_ssp(chi,Coeff_t(1.0),psi,-cs[s%Ls],tmp_f,s,s);// chi = (1-c[s] D_W) psi
   }
 }
 template<class Impl>  
@@ -147,8 +153,8 @@ void CayleyFermion5D<Impl>::DminusDag(const FermionField &psi, FermionField &chi
   FermionField tmp_f(this->FermionGrid());
   this->DW(psi,tmp_f,DaggerYes);
 
-  for(int s=0;s<Ls;s++){
-    axpby_ssp(chi,Coeff_t(1.0),psi,conjugate(-cs[s]),tmp_f,s,s);// chi = (1-c[s] D_W) psi
+  for(int s=0;s<Ls*this->Nrhs;s++){
+    axpby_ssp(chi,Coeff_t(1.0),psi,conjugate(-cs[s%Ls]),tmp_f,s,s);// chi = (1-c[s] D_W) psi
   }
 }
 
@@ -298,11 +304,20 @@ void CayleyFermion5D<Impl>::M5Ddag (const FermionField &psi, FermionField &chi)
 
 template<class Impl>
 void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField &Din)
+{
+  Vector<Coeff_t> diag;
+  Vector<Coeff_t> upper;
+  Vector<Coeff_t> lower;
+  MeooeDag5DCoefficients(lower,diag,upper);
+  M5Ddag(psi,psi,Din,lower,diag,upper);
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::MeooeDag5DCoefficients(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag =bs;
-  Vector<Coeff_t> upper=cs;
-  Vector<Coeff_t> lower=cs; 
+  diag =bs;
+  upper=cs;
+  lower=cs; 
 
   for (int s=0;s<Ls;s++){
     if ( s== 0 ) {
@@ -319,7 +334,6 @@ void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField
     lower[s] = conjugate(lower[s]);
     diag[s]  = conjugate(diag[s]);
   }
-  M5Ddag(psi,psi,Din,lower,diag,upper);
 }
 
 template<class Impl>
@@ -380,6 +394,84 @@ void CayleyFermion5D<Impl>::MeooeDag    (const FermionField &psi, FermionField &
   MeooeDag5D(this->tmp(),chi); 
 }
 
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeInvMeooe      (const FermionField &psi, FermionField &chi, FermionField &tmp)
+{
+  MooeeInvMeooeInternal(psi,chi,tmp,DaggerNo);
+}
+
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeInvDagMeooeDag(const FermionField &psi, FermionField &chi, FermionField &tmp)
+{
+  MooeeInvMeooeInternal(psi,chi,tmp,DaggerYes);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Mooee^{-1} Meooe = Mooee^{-1} Dhop M5      (Meooe5D, then fused kernel)
+// Mooee^{-dag} Meooe^dag = Mooee^{-dag} M5^dag Dhop^dag    (one fused kernel)
+// The 4d hop and the 5th dimension matrices act on one Ls column at a time;
+// M5 cannot follow the hop on the input side as every column is read by
+// eight neighbours, so it remains a separate pass for dag=0.
+////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeInvMeooeInternal(const FermionField &psi, FermionField &chi, FermionField &tmp, int dag)
+{
+  int Ls  = this->Ls;
+  int LLs = psi.Grid()->_rdimensions[0];
+
+  // The fused kernel needs every halo before the first column is computed,
+  // and whole Ls columns in one SIMD lane
+  if ( (!WilsonKernelsStatic::FuseCayley)
+       || (WilsonKernelsStatic::Comms == WilsonKernelsStatic::CommsAndCompute)
+       || (LLs%Ls != 0) ) {
+    if ( dag ) {
+      MeooeDag(psi,tmp);
+      MooeeInvDag(tmp,chi);
+    } else {
+      Meooe(psi,tmp);
+      MooeeInv(tmp,chi);
+    }
+    return;
+  }
+
+  conformable(psi.Grid(),this->FermionRedBlackGrid());    // verifies half grid
+  conformable(psi.Grid(),chi.Grid());
+  assert(psi.Checkerboard()==Odd || psi.Checkerboard()==Even);
+
+  Vector<Coeff_t> diag;
+  Vector<Coeff_t> upper;
+  Vector<Coeff_t> lower;
+  if ( dag ) MeooeDag5DCoefficients(lower,diag,upper);
+  else       Meooe5D(psi,tmp);  // M5 before the hop
+  const FermionField &in = dag ? psi : tmp;
+
+  int odd = (psi.Checkerboard()==Odd);
+  StencilImpl       &st = odd ? this->StencilOdd : this->StencilEven;
+  DoubledGaugeField &U  = odd ? this->UmuEven    : this->UmuOdd;
+  chi.Checkerboard() = odd ? Even : Odd;
+
+  const Coeff_t *plower = dag ? &lower[0] : nullptr;
+  const Coeff_t *pdiag  = dag ? &diag[0]  : nullptr;
+  const Coeff_t *pupper = dag ? &upper[0] : nullptr;
+
+  this->DhopCalls++;
+  MooeeInvCalls++;
+  if ( dag ) M5Dcalls++;
+
+  this->DhopTotalTime-=usecond();
+  Compressor compressor(dag,this->Params.commsPrecision);
+  this->DhopCommTime-=usecond();
+  st.HaloExchangeOpt(in,compressor);
+  this->DhopCommTime+=usecond();
+
+  this->DhopComputeTime-=usecond();
+  WilsonKernels<Impl>::DhopCayleyKernel(WilsonKernelsStatic::Opt,st,U,st.CommBuf(),LLs,Ls,U.oSites(),in,chi,
+					plower,pdiag,pupper,
+					&lee[0],&dee[0],&uee[0],&leem[0],&ueem[0],dag);
+  this->DhopComputeTime+=usecond();
+  this->DhopTotalTime+=usecond();
+}
+
 template<class Impl>
 void  CayleyFermion5D<Impl>::Mdir (const FermionField &psi, FermionField &chi,int dir,int disp)
 {
@@ -590,6 +682,7 @@ void CayleyFermion5D<Impl>::SetCoefficientsInternal(RealD zolo_hi,Vector<Coeff_t
 template <class Impl>
 void CayleyFermion5D<Impl>::ContractJ5q(FermionField &q_in,ComplexField &J5q)
 {
+  assert(this->Nrhs==1); // 4d fields, single right hand side only
   conformable(this->GaugeGrid(), J5q.Grid());
   conformable(q_in.Grid(), this->FermionGrid());
   Gamma G5(Gamma::Algebra::Gamma5);
@@ -611,6 +704,7 @@ void CayleyFermion5D<Impl>::ContractJ5q(FermionField &q_in,ComplexField &J5q)
 template <class Impl>
 void CayleyFermion5D<Impl>::ContractJ5q(PropagatorField &q_in,ComplexField &J5q)
 {
+  assert(this->Nrhs==1); // 4d fields, single right hand side only
   conformable(this->GaugeGrid(), J5q.Grid());
   conformable(q_in.Grid(), this->FermionGrid());
   Gamma G5(Gamma::Algebra::Gamma5);
@@ -642,6 +736,7 @@ void CayleyFermion5D<Impl>::ContractConservedCurrent( PropagatorField &q_in_1,
 						      Current curr_type,
 						      unsigned int mu)
 {
+  assert(this->Nrhs==1); // 4d fields, single right hand side only
 #if (!defined(GRID_HIP))
   Gamma::Algebra Gmu [] = {
     Gamma::Algebra::GammaX,
@@ -774,6 +869,7 @@ void CayleyFermion5D<Impl>::SeqConservedCurrent(PropagatorField &q_in,
                                                 unsigned int tmax,
 						ComplexField &ph)// Complex phase factor
 {
+  assert(this->Nrhs==1); // 4d fields, single right hand side only
   assert(mu>=0);
   assert(mu<Nd);
 
@@ -219,7 +219,7 @@ void ImprovedStaggeredFermion5D<Impl>::DhopDir(const FermionField &in, FermionFi
   int dir = dir5-1; // Maps to the ordering above in "directions" that is passed to stencil
                     // we drop off the innermost fifth dimension
 
-  Compressor compressor;
+  Compressor compressor(this->Params.commsPrecision);
   Stencil.HaloExchange(in,compressor);
   autoView( Umu_v   ,   Umu, CpuRead);
   autoView( UUUmu_v , UUUmu, CpuRead);
@@ -293,7 +293,7 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl &
 								   const FermionField &in, FermionField &out,int dag)
 {
   //  assert((dag==DaggerNo) ||(dag==DaggerYes));
-  Compressor compressor; 
+  Compressor compressor(this->Params.commsPrecision);
 
   int LLs = in.Grid()->_rdimensions[0];
   int len =  U.Grid()->oSites();
@@ -304,8 +304,7 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl &
   DhopFaceTime+=usecond();
 
   DhopCommTime -=usecond();
-  std::vector<std::vector<CommsRequest_t> > requests;
-  st.CommunicateBegin(requests);
+  st.CommunicatePersistentBegin();
 
   //  st.HaloExchangeOptGather(in,compressor); // Wilson compressor
   DhopFaceTime-=usecond();
@@ -323,13 +322,13 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl &
   }
   DhopComputeTime+=usecond();
 
+  st.CommunicatePersistentComplete();
+  DhopCommTime +=usecond();
+
   DhopFaceTime-=usecond();
   st.CommsMerge(compressor);
   DhopFaceTime+=usecond();
 
-  st.CommunicateComplete(requests);
-  DhopCommTime +=usecond();
-
   DhopComputeTime2-=usecond();
   {
     int interior=0;
@@ -344,7 +343,7 @@ void ImprovedStaggeredFermion5D<Impl>::DhopInternalSerialComms(StencilImpl & st,
 						    DoubledGaugeField & U,DoubledGaugeField & UUU,
 						    const FermionField &in, FermionField &out,int dag)
 {
-  Compressor compressor;
+  Compressor compressor(this->Params.commsPrecision);
   int LLs = in.Grid()->_rdimensions[0];
 
  //double t1=usecond();
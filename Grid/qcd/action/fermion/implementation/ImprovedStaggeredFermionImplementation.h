@@ -245,7 +245,7 @@ void ImprovedStaggeredFermion<Impl>::DerivInternal(StencilImpl &st, DoubledGauge
 {
   assert((dag == DaggerNo) || (dag == DaggerYes));
 
-  Compressor compressor;
+  Compressor compressor(this->Params.commsPrecision);
 
   FermionField Btilde(B.Grid());
   FermionField Atilde(B.Grid());
@@ -384,7 +384,7 @@ template <class Impl>
 void ImprovedStaggeredFermion<Impl>::DhopDir(const FermionField &in, FermionField &out, int dir, int disp) 
 {
 
-  Compressor compressor;
+  Compressor compressor(this->Params.commsPrecision);
   Stencil.HaloExchange(in, compressor);
   autoView( Umu_v   ,   Umu, CpuRead);
   autoView( UUUmu_v , UUUmu, CpuRead);
@@ -415,7 +415,7 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st
 								 const FermionField &in,
 								 FermionField &out, int dag) 
 {
-  Compressor compressor; 
+  Compressor compressor(this->Params.commsPrecision);
   int len =  U.Grid()->oSites();
 
   DhopTotalTime   -= usecond();
@@ -426,8 +426,7 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st
   DhopFaceTime    += usecond();
 
   DhopCommTime -=usecond();
-  std::vector<std::vector<CommsRequest_t> > requests;
-  st.CommunicateBegin(requests);
+  st.CommunicatePersistentBegin();
 
   DhopFaceTime-=usecond();
   st.CommsMergeSHM(compressor);
@@ -444,7 +443,7 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st
   }
   DhopComputeTime    += usecond();
 
-  st.CommunicateComplete(requests);
+  st.CommunicatePersistentComplete();
   DhopCommTime +=usecond();
 
   // First to enter, last to leave timing
@@ -474,7 +473,7 @@ void ImprovedStaggeredFermion<Impl>::DhopInternalSerialComms(StencilImpl &st, Le
   DhopTotalTime   -= usecond();
 
   DhopCommTime    -= usecond();
-  Compressor compressor;
+  Compressor compressor(this->Params.commsPrecision);
   st.HaloExchange(in, compressor);
   DhopCommTime    += usecond();
 
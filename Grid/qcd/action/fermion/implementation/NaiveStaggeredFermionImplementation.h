@@ -195,7 +195,7 @@ void NaiveStaggeredFermion<Impl>::DerivInternal(StencilImpl &st, DoubledGaugeFie
 {
   assert((dag == DaggerNo) || (dag == DaggerYes));
 
-  Compressor compressor;
+  Compressor compressor(this->Params.commsPrecision);
 
   FermionField Btilde(B.Grid());
   FermionField Atilde(B.Grid());
@@ -313,7 +313,7 @@ template <class Impl>
 void NaiveStaggeredFermion<Impl>::DhopDir(const FermionField &in, FermionField &out, int dir, int disp) 
 {
 
-  Compressor compressor;
+  Compressor compressor(this->Params.commsPrecision);
   Stencil.HaloExchange(in, compressor);
   autoView( Umu_v   ,  Umu, CpuRead);
   autoView( in_v    ,  in, CpuRead);
@@ -342,7 +342,7 @@ void NaiveStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, L
 							      const FermionField &in,
 							      FermionField &out, int dag) 
 {
-  Compressor compressor; 
+  Compressor compressor(this->Params.commsPrecision);
   int len =  U.Grid()->oSites();
 
   DhopTotalTime   -= usecond();
@@ -353,8 +353,7 @@ void NaiveStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, L
   DhopFaceTime    += usecond();
 
   DhopCommTime -=usecond();
-  std::vector<std::vector<CommsRequest_t> > requests;
-  st.CommunicateBegin(requests);
+  st.CommunicatePersistentBegin();
 
   DhopFaceTime-=usecond();
   st.CommsMergeSHM(compressor);
@@ -371,7 +370,7 @@ void NaiveStaggeredFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, L
   }
   DhopComputeTime    += usecond();
 
-  st.CommunicateComplete(requests);
+  st.CommunicatePersistentComplete();
   DhopCommTime +=usecond();
 
   // First to enter, last to leave timing
@@ -399,7 +398,7 @@ void NaiveStaggeredFermion<Impl>::DhopInternalSerialComms(StencilImpl &st, Lebes
   DhopTotalTime   -= usecond();
 
   DhopCommTime    -= usecond();
-  Compressor compressor;
+  Compressor compressor(this->Params.commsPrecision);
   st.HaloExchange(in, compressor);
   DhopCommTime    += usecond();
 
@@ -81,6 +81,7 @@ void WilsonCloverFermion<Impl>::ImportGauge(const GaugeField &_Umu)
 
   // Compute the Clover Operator acting on Colour and Spin
   // multiply here by the clover coefficients for the anisotropy
+  CloverFieldType CloverTerm(grid);
   CloverTerm  = fillCloverYZ(Bx) * csw_r;
   CloverTerm += fillCloverXZ(By) * csw_r;
   CloverTerm += fillCloverXY(Bz) * csw_r;
@@ -89,54 +90,40 @@ void WilsonCloverFermion<Impl>::ImportGauge(const GaugeField &_Umu)
   CloverTerm += fillCloverZT(Ez) * csw_t;
   CloverTerm += diag_mass;
 
-  int lvol = _Umu.Grid()->lSites();
-  int DimRep = Impl::Dimension;
-
-  {
-    autoView(CTv,CloverTerm,CpuRead);
-    autoView(CTIv,CloverTermInv,CpuWrite);
-    thread_for(site, lvol, {
-      Coordinate lcoor;
-      grid->LocalIndexToLocalCoor(site, lcoor);
-      Eigen::MatrixXcd EigenCloverOp = Eigen::MatrixXcd::Zero(Ns * DimRep, Ns * DimRep);
-      Eigen::MatrixXcd EigenInvCloverOp = Eigen::MatrixXcd::Zero(Ns * DimRep, Ns * DimRep);
-      typename SiteCloverType::scalar_object Qx = Zero(), Qxinv = Zero();
-      peekLocalSite(Qx, CTv, lcoor);
-      //if (csw!=0){
-      for (int j = 0; j < Ns; j++)
-	for (int k = 0; k < Ns; k++)
-	  for (int a = 0; a < DimRep; a++)
-	    for (int b = 0; b < DimRep; b++){
-	      auto zz =  Qx()(j, k)(a, b);
-	      EigenCloverOp(a + j * DimRep, b + k * DimRep) = std::complex<double>(zz);
-	    }
-      //   if (site==0) std::cout << "site =" << site << "\n" << EigenCloverOp << std::endl;
-      
-      EigenInvCloverOp = EigenCloverOp.inverse();
-      //std::cout << EigenInvCloverOp << std::endl;
-      for (int j = 0; j < Ns; j++)
-	for (int k = 0; k < Ns; k++)
-	  for (int a = 0; a < DimRep; a++)
-	    for (int b = 0; b < DimRep; b++)
-	      Qxinv()(j, k)(a, b) = EigenInvCloverOp(a + j * DimRep, b + k * DimRep);
-      //    if (site==0) std::cout << "site =" << site << "\n" << EigenInvCloverOp << std::endl;
-      //  }
-      pokeLocalSite(Qxinv, CTIv, lcoor);
-    });
-  }
+  // Keep only the two Hermitian chiral blocks and invert them block by block
+  CloverDiagonalField Diagonal(grid), InvDiagonal(grid);
+  CloverTriangleField Triangle(grid), InvTriangle(grid);
+  Packed::Pack(CloverTerm, Diagonal, Triangle);
+  Packed::Invert(Diagonal, Triangle, InvDiagonal, InvTriangle);
 
   // Separate the even and odd parts
-  pickCheckerboard(Even, CloverTermEven, CloverTerm);
-  pickCheckerboard(Odd, CloverTermOdd, CloverTerm);
-
-  pickCheckerboard(Even, CloverTermDagEven, adj(CloverTerm));
-  pickCheckerboard(Odd, CloverTermDagOdd, adj(CloverTerm));
+  pickCheckerboard(Even, CloverDiagonalEven, Diagonal);
+  pickCheckerboard(Odd,  CloverDiagonalOdd,  Diagonal);
+  pickCheckerboard(Even, CloverTriangleEven, Triangle);
+  pickCheckerboard(Odd,  CloverTriangleOdd,  Triangle);
+
+  pickCheckerboard(Even, CloverInvDiagonalEven, InvDiagonal);
+  pickCheckerboard(Odd,  CloverInvDiagonalOdd,  InvDiagonal);
+  pickCheckerboard(Even, CloverInvTriangleEven, InvTriangle);
+  pickCheckerboard(Odd,  CloverInvTriangleOdd,  InvTriangle);
+}
 
-  pickCheckerboard(Even, CloverTermInvEven, CloverTermInv);
-  pickCheckerboard(Odd, CloverTermInvOdd, CloverTermInv);
+template <class Impl>
+typename WilsonCloverFermion<Impl>::CloverFieldType WilsonCloverFermion<Impl>::CloverTermFull(void)
+{
+  CloverFieldType full(this->_grid), cb(this->_cbgrid);
+  Packed::Unpack(CloverDiagonalEven, CloverTriangleEven, cb); setCheckerboard(full, cb);
+  Packed::Unpack(CloverDiagonalOdd , CloverTriangleOdd , cb); setCheckerboard(full, cb);
+  return full;
+}
 
-  pickCheckerboard(Even, CloverTermInvDagEven, adj(CloverTermInv));
-  pickCheckerboard(Odd, CloverTermInvDagOdd, adj(CloverTermInv));
+template <class Impl>
+typename WilsonCloverFermion<Impl>::CloverFieldType WilsonCloverFermion<Impl>::CloverTermInvFull(void)
+{
+  CloverFieldType full(this->_grid), cb(this->_cbgrid);
+  Packed::Unpack(CloverInvDiagonalEven, CloverInvTriangleEven, cb); setCheckerboard(full, cb);
+  Packed::Unpack(CloverInvDiagonalOdd , CloverInvTriangleOdd , cb); setCheckerboard(full, cb);
+  return full;
 }
 
 template <class Impl>
@@ -166,57 +153,85 @@ void WilsonCloverFermion<Impl>::MooeeInvDag(const FermionField &in, FermionField
 template <class Impl>
 void WilsonCloverFermion<Impl>::MooeeInternal(const FermionField &in, FermionField &out, int dag, int inv)
 {
+  // The clover term and its inverse are Hermitian: dag changes nothing
   out.Checkerboard() = in.Checkerboard();
-  CloverFieldType *Clover;
   assert(in.Checkerboard() == Odd || in.Checkerboard() == Even);
 
-  if (dag)
+  if (in.Grid()->_isCheckerBoarded)
   {
-    if (in.Grid()->_isCheckerBoarded)
+    if (in.Checkerboard() == Odd)
     {
-      if (in.Checkerboard() == Odd)
-      {
-        Clover = (inv) ? &CloverTermInvDagOdd : &CloverTermDagOdd;
-      }
-      else
-      {
-        Clover = (inv) ? &CloverTermInvDagEven : &CloverTermDagEven;
-      }
-      out = *Clover * in;
+      if (inv) Packed::Mult(CloverInvDiagonalOdd, CloverInvTriangleOdd, in, out);
+      else     Packed::Mult(CloverDiagonalOdd   , CloverTriangleOdd   , in, out);
     }
     else
     {
-      Clover = (inv) ? &CloverTermInv : &CloverTerm;
-      out = adj(*Clover) * in;
+      if (inv) Packed::Mult(CloverInvDiagonalEven, CloverInvTriangleEven, in, out);
+      else     Packed::Mult(CloverDiagonalEven   , CloverTriangleEven   , in, out);
     }
   }
   else
   {
-    if (in.Grid()->_isCheckerBoarded)
-    {
+    FermionField in_cb(this->_cbgrid), out_cb(this->_cbgrid);
+    pickCheckerboard(Even, in_cb, in);
+    MooeeInternal(in_cb, out_cb, dag, inv);
+    setCheckerboard(out, out_cb);
+    pickCheckerboard(Odd, in_cb, in);
+    MooeeInternal(in_cb, out_cb, dag, inv);
+    setCheckerboard(out, out_cb);
+  }
+} // MooeeInternal
 
-      if (in.Checkerboard() == Odd)
-      {
-        //  std::cout << "Calling clover term Odd" << std::endl;
-        Clover = (inv) ? &CloverTermInvOdd : &CloverTermOdd;
-      }
-      else
-      {
-        //  std::cout << "Calling clover term Even" << std::endl;
-        Clover = (inv) ? &CloverTermInvEven : &CloverTermEven;
-      }
-      out = *Clover * in;
-      //  std::cout << GridLogMessage << "*Clover.Checkerboard() "  << (*Clover).Checkerboard() << std::endl;
-    }
-    else
-    {
-      Clover = (inv) ? &CloverTermInv : &CloverTerm;
-      out = *Clover * in;
+template <class Impl>
+void WilsonCloverFermion<Impl>::MooeeInvMeooe(const FermionField &in, FermionField &out, FermionField &tmp)
+{
+  MooeeInvMeooeInternal(in, out, tmp, DaggerNo);
+}
+
+template <class Impl>
+void WilsonCloverFermion<Impl>::MooeeInvDagMeooeDag(const FermionField &in, FermionField &out, FermionField &tmp)
+{
+  MooeeInvMeooeInternal(in, out, tmp, DaggerYes);
+}
+
+template <class Impl>
+void WilsonCloverFermion<Impl>::MooeeInvMeooeInternal(const FermionField &in, FermionField &out, FermionField &tmp, int dag)
+{
+  // The fused kernel needs every halo before the first site is computed
+  if ( (!WilsonKernelsStatic::FuseClover) || (WilsonKernelsStatic::Comms == WilsonKernelsStatic::CommsAndCompute) ) {
+    if ( dag ) {
+      this->MeooeDag(in, tmp);
+      MooeeInvDag(tmp, out);
+    } else {
+      this->Meooe(in, tmp);
+      MooeeInv(tmp, out);
     }
+    return;
   }
 
-} // MooeeInternal
+  conformable(in.Grid(), this->_cbgrid);   // verifies half grid
+  conformable(in.Grid(), out.Grid());
+  assert(in.Checkerboard() == Odd || in.Checkerboard() == Even);
 
+  int odd = (in.Checkerboard() == Odd);
+  StencilImpl         &st   = odd ? this->StencilOdd : this->StencilEven;
+  DoubledGaugeField   &U    = odd ? this->UmuEven    : this->UmuOdd;
+  CloverDiagonalField &diag = odd ? CloverInvDiagonalEven : CloverInvDiagonalOdd;
+  CloverTriangleField &tri  = odd ? CloverInvTriangleEven : CloverInvTriangleOdd;
+  out.Checkerboard() = odd ? Even : Odd;
+
+  this->DhopCalls++;
+  this->DhopTotalTime -= usecond();
+  Compressor compressor(dag, this->Params.commsPrecision);
+  this->DhopCommTime -= usecond();
+  st.HaloExchange(in, compressor);
+  this->DhopCommTime += usecond();
+
+  this->DhopComputeTime -= usecond();
+  WilsonKernels<Impl>::DhopCloverKernel(WilsonKernelsStatic::Opt, st, U, st.CommBuf(), U.oSites(), in, out, diag, tri, dag);
+  this->DhopComputeTime += usecond();
+  this->DhopTotalTime += usecond();
+}
 
 // Derivative parts
 template <class Impl>
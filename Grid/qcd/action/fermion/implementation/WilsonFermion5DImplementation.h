@@ -45,7 +45,7 @@ WilsonFermion5D<Impl>::WilsonFermion5D(GaugeField &_Umu,
                GridRedBlackCartesian &FiveDimRedBlackGrid,
                GridCartesian         &FourDimGrid,
                GridRedBlackCartesian &FourDimRedBlackGrid,
-               RealD _M5,const ImplParams &p) :
+               RealD _M5,const ImplParams &p,int _Nrhs) :
   Kernels(p),
   _FiveDimGrid        (&FiveDimGrid),
   _FiveDimRedBlackGrid(&FiveDimRedBlackGrid),
@@ -55,6 +55,7 @@ WilsonFermion5D<Impl>::WilsonFermion5D(GaugeField &_Umu,
   StencilEven(_FiveDimRedBlackGrid,npoint,Even,directions,displacements,p), // source is Even
   StencilOdd (_FiveDimRedBlackGrid,npoint,Odd ,directions,displacements,p), // source is Odd
   M5(_M5),
+  Nrhs(_Nrhs),
   Umu(_FourDimGrid),
   UmuEven(_FourDimRedBlackGrid),
   UmuOdd (_FourDimRedBlackGrid),
@@ -70,8 +71,10 @@ WilsonFermion5D<Impl>::WilsonFermion5D(GaugeField &_Umu,
   assert(FiveDimRedBlackGrid._checker_dim==1); // Don't checker the s direction
 
   // extent of fifth dim and not spread out
-  Ls=FiveDimGrid._fdimensions[0];
-  assert(FiveDimRedBlackGrid._fdimensions[0]==Ls);
+  assert(Nrhs>=1);
+  assert(FiveDimGrid._fdimensions[0]%Nrhs==0);
+  Ls=FiveDimGrid._fdimensions[0]/Nrhs;
+  assert(FiveDimRedBlackGrid._fdimensions[0]==Ls*Nrhs);
   assert(FiveDimGrid._processors[0]         ==1);
   assert(FiveDimRedBlackGrid._processors[0] ==1);
 
@@ -94,6 +97,7 @@ WilsonFermion5D<Impl>::WilsonFermion5D(GaugeField &_Umu,
   if (Impl::LsVectorised) { 
 
     int nsimd = Simd::Nsimd();
+    assert(Nrhs==1); // rhs blocks would straddle SIMD lanes
     
     // Dimension zero of the five-d is the Ls direction
     assert(FiveDimGrid._simd_layout[0]        ==nsimd);
@@ -135,7 +139,7 @@ void WilsonFermion5D<Impl>::Report(void)
 {
   RealD NP     = _FourDimGrid->_Nprocessors;
   RealD NN     = _FourDimGrid->NodeCount();
-  RealD volume = Ls;  
+  RealD volume = Ls*Nrhs;  
   Coordinate latt = _FourDimGrid->GlobalDimensions();
   for(int mu=0;mu<Nd;mu++) volume=volume*latt[mu];
 
@@ -234,20 +238,20 @@ void WilsonFermion5D<Impl>::DhopDir(const FermionField &in, FermionField &out,in
   int dirdisp = dir+skip*4;
   int gamma   = dir+(1-skip)*4;
 
-  Compressor compressor(DaggerNo);
+  Compressor compressor(DaggerNo,this->Params.commsPrecision);
   Stencil.HaloExchange(in,compressor);
   
   uint64_t Nsite = Umu.Grid()->oSites();
-  Kernels::DhopDirKernel(Stencil,Umu,Stencil.CommBuf(),Ls,Nsite,in,out,dirdisp,gamma);
+  Kernels::DhopDirKernel(Stencil,Umu,Stencil.CommBuf(),Ls*Nrhs,Nsite,in,out,dirdisp,gamma);
 
 };
 template<class Impl>
 void WilsonFermion5D<Impl>::DhopDirAll(const FermionField &in, std::vector<FermionField> &out)
 {
-  Compressor compressor(DaggerNo);
+  Compressor compressor(DaggerNo,this->Params.commsPrecision);
   Stencil.HaloExchange(in,compressor);
   uint64_t Nsite = Umu.Grid()->oSites();
-  Kernels::DhopDirAll(Stencil,Umu,Stencil.CommBuf(),Ls,Nsite,in,out);
+  Kernels::DhopDirAll(Stencil,Umu,Stencil.CommBuf(),Ls*Nrhs,Nsite,in,out);
 };
 
 
@@ -265,7 +269,7 @@ void WilsonFermion5D<Impl>::DerivInternal(StencilImpl & st,
   conformable(st.Grid(),A.Grid());
   conformable(st.Grid(),B.Grid());
 
-  Compressor compressor(dag);
+  Compressor compressor(dag,this->Params.commsPrecision);
   
   FermionField Btilde(B.Grid());
   FermionField Atilde(B.Grid());
@@ -294,7 +298,7 @@ void WilsonFermion5D<Impl>::DerivInternal(StencilImpl & st,
 
     int Usites = U.Grid()->oSites();
 
-    Kernels::DhopDirKernel(st, U, st.CommBuf(), Ls, Usites, B, Btilde, mu,gamma);
+    Kernels::DhopDirKernel(st, U, st.CommBuf(), Ls*Nrhs, Usites, B, Btilde, mu,gamma);
 
     ////////////////////////////
     // spin trace outer product
@@ -374,7 +378,7 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
 							DoubledGaugeField & U,
 							const FermionField &in, FermionField &out,int dag)
 {
-  Compressor compressor(dag);
+  Compressor compressor(dag,this->Params.commsPrecision);
 
   int LLs = in.Grid()->_rdimensions[0];
   int len =  U.Grid()->oSites();
@@ -387,8 +391,7 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
   DhopFaceTime+=usecond();
 
   DhopCommTime -=usecond();
-  std::vector<std::vector<CommsRequest_t> > requests;
-  st.CommunicateBegin(requests);
+  st.CommunicatePersistentBegin();
 
   /////////////////////////////
   // Overlap with comms
@@ -412,7 +415,7 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
   /////////////////////////////
   // Complete comms
   /////////////////////////////
-  st.CommunicateComplete(requests);
+  st.CommunicatePersistentComplete();
   DhopCommTime   +=usecond();
 
   /////////////////////////////
@@ -438,7 +441,7 @@ void WilsonFermion5D<Impl>::DhopInternalSerialComms(StencilImpl & st, LebesgueOr
 						    const FermionField &in, 
 						    FermionField &out,int dag)
 {
-  Compressor compressor(dag);
+  Compressor compressor(dag,this->Params.commsPrecision);
 
   int LLs = in.Grid()->_rdimensions[0];
   
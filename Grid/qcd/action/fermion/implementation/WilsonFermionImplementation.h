@@ -322,7 +322,7 @@ void WilsonFermion<Impl>::DerivInternal(StencilImpl &st, DoubledGaugeField &U,
   DerivCalls++;
   assert((dag == DaggerNo) || (dag == DaggerYes));
 
-  Compressor compressor(dag);
+  Compressor compressor(dag,this->Params.commsPrecision);
 
   FermionField Btilde(B.Grid());
   FermionField Atilde(B.Grid());
@@ -446,7 +446,7 @@ void WilsonFermion<Impl>::MdirAll(const FermionField &in, std::vector<FermionFie
 template <class Impl>
 void WilsonFermion<Impl>::DhopDir(const FermionField &in, FermionField &out, int dir, int disp)
 {
-  Compressor compressor(DaggerNo);
+  Compressor compressor(DaggerNo,this->Params.commsPrecision);
   Stencil.HaloExchange(in, compressor);
 
   int skip = (disp == 1) ? 0 : 1;
@@ -458,7 +458,7 @@ void WilsonFermion<Impl>::DhopDir(const FermionField &in, FermionField &out, int
 template <class Impl>
 void WilsonFermion<Impl>::DhopDirAll(const FermionField &in, std::vector<FermionField> &out)
 {
-  Compressor compressor(DaggerNo);
+  Compressor compressor(DaggerNo,this->Params.commsPrecision);
   Stencil.HaloExchange(in, compressor);
 
   assert((out.size()==8)||(out.size()==9));
@@ -505,20 +505,19 @@ void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueO
 {
   assert((dag == DaggerNo) || (dag == DaggerYes));
 
-  Compressor compressor(dag);
+  Compressor compressor(dag,this->Params.commsPrecision);
   int len =  U.Grid()->oSites();
 
   /////////////////////////////
   // Start comms  // Gather intranode and extra node differentiated??
   /////////////////////////////
-  std::vector<std::vector<CommsRequest_t> > requests;
   st.Prepare();
   DhopFaceTime-=usecond();
   st.HaloGather(in,compressor);
   DhopFaceTime+=usecond();
 
   DhopCommTime -=usecond();
-  st.CommunicateBegin(requests);
+  st.CommunicatePersistentBegin();
 
   /////////////////////////////
   // Overlap with comms
@@ -542,7 +541,7 @@ void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueO
   /////////////////////////////
   // Complete comms
   /////////////////////////////
-  st.CommunicateComplete(requests);
+  st.CommunicatePersistentComplete();
   DhopCommTime   +=usecond();
 
   DhopFaceTime-=usecond();
@@ -570,7 +569,7 @@ void WilsonFermion<Impl>::DhopInternalSerial(StencilImpl &st, LebesgueOrder &lo,
                                        FermionField &out, int dag)
 {
   assert((dag == DaggerNo) || (dag == DaggerYes));
-  Compressor compressor(dag);
+  Compressor compressor(dag,this->Params.commsPrecision);
   DhopCommTime-=usecond();
   st.HaloExchange(in, compressor);
   DhopCommTime+=usecond();
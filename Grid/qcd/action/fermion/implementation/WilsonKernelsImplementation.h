@@ -496,6 +496,118 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
    assert(0 && " Kernel optimisation case not covered ");
   }
 
+////////////////////////////////////////////////////////////////////
+// Hopping term fused with the packed clover multiply; the output
+// site is multiplied while still in registers/cache rather than in
+// a second sweep over the field
+////////////////////////////////////////////////////////////////////
+#define CLOVER_KERNEL_CALL(A)						\
+  accelerator_for( ss, Nsite, Simd::Nsimd(), {				\
+      WilsonKernels<Impl>::A(st_v,U_v,buf,ss,ss,in_v,out_v);		\
+      PackedCloverHelpers<Impl>::MultSiteInPlace(diag_v,tri_v,out_v,ss); \
+  });
+
+#define CLOVER_ASM_CALL(A)						\
+  thread_for( ss, Nsite, {						\
+    WilsonKernels<Impl>::A(st_v,U_v,buf,ss,ss,1,1,in_v,out_v);		\
+    PackedCloverHelpers<Impl>::MultSiteInPlace(diag_v,tri_v,out_v,ss);	\
+  });
+
+template <class Impl>
+void WilsonKernels<Impl>::DhopCloverKernel(int Opt,StencilImpl &st,  DoubledGaugeField &U, SiteHalfSpinor * buf,
+					   int Nsite, const FermionField &in, FermionField &out,
+					   const CloverDiagonalField &diag, const CloverTriangleField &tri, int dag)
+{
+  autoView(U_v   , U   ,AcceleratorRead);
+  autoView(in_v  , in  ,AcceleratorRead);
+  autoView(out_v , out ,AcceleratorWrite);
+  autoView(st_v  , st  ,AcceleratorRead);
+  autoView(diag_v, diag,AcceleratorRead);
+  autoView(tri_v , tri ,AcceleratorRead);
+
+  if (dag == DaggerYes) {
+    if (Opt == WilsonKernelsStatic::OptGeneric    ) { CLOVER_KERNEL_CALL(GenericDhopSiteDag); return;}
+#ifndef GRID_CUDA
+    if (Opt == WilsonKernelsStatic::OptHandUnroll ) { CLOVER_KERNEL_CALL(HandDhopSiteDag);    return;}
+    if (Opt == WilsonKernelsStatic::OptInlineAsm  ) { CLOVER_ASM_CALL(AsmDhopSiteDag);        return;}
+#endif
+  } else {
+    if (Opt == WilsonKernelsStatic::OptGeneric    ) { CLOVER_KERNEL_CALL(GenericDhopSite); return;}
+#ifndef GRID_CUDA
+    if (Opt == WilsonKernelsStatic::OptHandUnroll ) { CLOVER_KERNEL_CALL(HandDhopSite);    return;}
+    if (Opt == WilsonKernelsStatic::OptInlineAsm  ) { CLOVER_ASM_CALL(AsmDhopSite);        return;}
+#endif
+  }
+  assert(0 && " Kernel optimisation case not covered ");
+}
+
+////////////////////////////////////////////////////////////////////
+// Hopping term fused with the Cayley fifth dimension matrices; one
+// thread takes a whole Ls column, so the tridiagonal M5^dag and the
+// LDU solve read back sites that were just written and are in cache
+////////////////////////////////////////////////////////////////////
+#define CAYLEY_COLUMN							\
+  if ( dag ) {								\
+    CayleyColumnHelpers::M5DdagInPlace(out_v,sF,Ls,lower,diag,upper);	\
+    CayleyColumnHelpers::MooeeInvDag(out_v,out_v,sF,Ls,lee,dee,uee,leem,ueem); \
+  } else {								\
+    CayleyColumnHelpers::MooeeInv(out_v,out_v,sF,Ls,lee,dee,uee,leem,ueem); \
+  }
+
+#define CAYLEY_KERNEL_CALL(A)						\
+  accelerator_for( sc, Ncol, Simd::Nsimd(), {				\
+      uint64_t sF = sc*Ls;						\
+      int sU = sF/LLs;							\
+      for(int s=0;s<Ls;s++){						\
+	WilsonKernels<Impl>::A(st_v,U_v,buf,sF+s,sU,in_v,out_v);	\
+      }									\
+      CAYLEY_COLUMN;							\
+  });
+
+#define CAYLEY_ASM_CALL(A)						\
+  thread_for( sc, Ncol, {						\
+    uint64_t sF = sc*Ls;						\
+    int sU = sF/LLs;							\
+    WilsonKernels<Impl>::A(st_v,U_v,buf,sF,sU,Ls,1,in_v,out_v);	\
+    CAYLEY_COLUMN;							\
+  });
+
+template <class Impl>
+void WilsonKernels<Impl>::DhopCayleyKernel(int Opt,StencilImpl &st,  DoubledGaugeField &U, SiteHalfSpinor * buf,
+					   int LLs, int Ls, int Nsite, const FermionField &in, FermionField &out,
+					   const Coeff_t *lower, const Coeff_t *diag, const Coeff_t *upper,
+					   const Coeff_t *lee, const Coeff_t *dee, const Coeff_t *uee,
+					   const Coeff_t *leem, const Coeff_t *ueem, int dag)
+{
+  assert( (LLs%Ls)==0 );
+  uint64_t Ncol = (uint64_t)Nsite*(LLs/Ls);
+
+  autoView(U_v   , U   ,AcceleratorRead);
+  autoView(in_v  , in  ,AcceleratorRead);
+  autoView(out_v , out ,AcceleratorWrite);
+  autoView(st_v  , st  ,AcceleratorRead);
+
+  if (dag == DaggerYes) {
+    if (Opt == WilsonKernelsStatic::OptGeneric    ) { CAYLEY_KERNEL_CALL(GenericDhopSiteDag); return;}
+#ifndef GRID_CUDA
+    if (Opt == WilsonKernelsStatic::OptHandUnroll ) { CAYLEY_KERNEL_CALL(HandDhopSiteDag);    return;}
+    if (Opt == WilsonKernelsStatic::OptInlineAsm  ) { CAYLEY_ASM_CALL(AsmDhopSiteDag);        return;}
+#endif
+  } else {
+    if (Opt == WilsonKernelsStatic::OptGeneric    ) { CAYLEY_KERNEL_CALL(GenericDhopSite); return;}
+#ifndef GRID_CUDA
+    if (Opt == WilsonKernelsStatic::OptHandUnroll ) { CAYLEY_KERNEL_CALL(HandDhopSite);    return;}
+    if (Opt == WilsonKernelsStatic::OptInlineAsm  ) { CAYLEY_ASM_CALL(AsmDhopSite);        return;}
+#endif
+  }
+  assert(0 && " Kernel optimisation case not covered ");
+}
+
+#undef CAYLEY_COLUMN
+#undef CAYLEY_KERNEL_CALL
+#undef CAYLEY_ASM_CALL
+#undef CLOVER_KERNEL_CALL
+#undef CLOVER_ASM_CALL
 #undef KERNEL_CALLNB
 #undef KERNEL_CALL
 #undef ASM_CALL
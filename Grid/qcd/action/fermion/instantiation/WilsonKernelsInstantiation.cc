@@ -35,6 +35,8 @@ NAMESPACE_BEGIN(Grid);
 // Move these
 int WilsonKernelsStatic::Opt   = WilsonKernelsStatic::OptGeneric;
 int WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
+int WilsonKernelsStatic::FuseClover = 0;
+int WilsonKernelsStatic::FuseCayley = 0;
 
 NAMESPACE_END(Grid);
 
@@ -0,0 +1,99 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/pseudofermion/ChronologicalGuess.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#ifndef QCD_PSEUDOFERMION_CHRONOLOGICAL_GUESS_H
+#define QCD_PSEUDOFERMION_CHRONOLOGICAL_GUESS_H
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////
+// Chronological inverter (Brower et al, hep-lat/9509012) for the MD
+// force solves of a pseudofermion action.
+//
+// Keeps the last Params.history solutions and starts each solve from the
+// minimal residual extrapolation over them. Only the force solves go
+// through here; the action and heatbath solves keep the zero guess so the
+// Metropolis step is unchanged. The history depends on the path, so
+// reversibility holds to the solver tolerance only: tolerance_factor < 1
+// tightens a ConjugateGradient while a guess is in use. The history is
+// dropped when the pseudofermion is refreshed.
+////////////////////////////////////////////////////////////////////////
+template<class Field>
+class ChronologicalGuess {
+private:
+  ChronoForecastParams Params;
+  std::vector<Field> history; // newest first
+  ChronoHermForecast<Field> Forecast;
+
+public:
+  ChronologicalGuess(const ChronoForecastParams &p = ChronoForecastParams()) : Params(p) {};
+
+  void SetParams(const ChronoForecastParams &p) { Params = p; Reset(); }
+  const ChronoForecastParams &GetParams(void) const { return Params; }
+
+  void Reset(void) { history.clear(); }
+
+  int Enabled(void) const { return Params.history > 0; }
+
+  std::string LogParameters(const std::string &name){
+    std::stringstream sstream;
+    if ( Enabled() ) {
+      sstream << GridLogMessage << "["<<name<<"] Chronological history   : " << Params.history << std::endl;
+      sstream << GridLogMessage << "["<<name<<"] Chrono tolerance factor : " << Params.tolerance_factor << std::endl;
+    }
+    return sstream.str();
+  }
+
+  // sol = (HermOp)^-1 src
+  void operator()(OperatorFunction<Field> &Solver, LinearOperatorBase<Field> &HermOp, const Field &src, Field &sol)
+  {
+    if ( !Enabled() ) {
+      sol = Zero();
+      Solver(HermOp,src,sol);
+      return;
+    }
+
+    sol = Forecast(HermOp,src,history);
+
+    ConjugateGradient<Field> *CG = dynamic_cast<ConjugateGradient<Field> *>(&Solver);
+    RealD tol = 0.0;
+    if ( CG && history.size() ) {
+      tol = CG->Tolerance;
+      CG->Tolerance = tol*Params.tolerance_factor;
+    }
+
+    Solver(HermOp,src,sol);
+
+    if ( CG && history.size() ) CG->Tolerance = tol;
+
+    if ( (int)history.size() == Params.history ) history.pop_back();
+    history.insert(history.begin(),sol);
+  }
+};
+
+NAMESPACE_END(Grid);
+
+#endif
@@ -66,6 +66,22 @@ private:
   FermionField PhiEven;  // the pseudo fermion field for this trajectory
   FermionField PhiOdd;   // the pseudo fermion field for this trajectory
 
+protected:
+  //////////////////////////////////////////////////////
+  // Multi-shift solves on Mpc, after FermOp has imported the gauge field.
+  // A derived class may substitute the solver.
+  //////////////////////////////////////////////////////
+  virtual void multiShiftInverse(MultiShiftFunction &approx, const FermionField &in, FermionField &out) {
+    SchurDifferentiableOperator<Impl> Mpc(FermOp);
+    ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter, approx);
+    msCG(Mpc, in, out);
+  }
+  virtual void multiShiftInverse(MultiShiftFunction &approx, const FermionField &in, std::vector<FermionField> &out_k) {
+    SchurDifferentiableOperator<Impl> Mpc(FermOp);
+    ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter, approx);
+    msCG(Mpc, in, out_k);
+  }
+
 public:
   OneFlavourEvenOddRationalPseudoFermionAction(FermionOperator<Impl> &Op,
                                                Params &p)
@@ -129,9 +145,7 @@ public:
     FermOp.ImportGauge(U);
 
     // mutishift CG
-    SchurDifferentiableOperator<Impl> Mpc(FermOp);
-    ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter, PowerQuarter);
-    msCG(Mpc, etaOdd, PhiOdd);
+    multiShiftInverse(PowerQuarter, etaOdd, PhiOdd);
 
     //////////////////////////////////////////////////////
     // FIXME : Clover term not yet..
@@ -151,10 +165,7 @@ public:
 
     SchurDifferentiableOperator<Impl> Mpc(FermOp);
 
-    ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter,
-                                                   PowerNegQuarter);
-
-    msCG(Mpc, PhiOdd, Y);
+    multiShiftInverse(PowerNegQuarter, PhiOdd, Y);
 
     if ( (rand()%param.BoundsCheckFreq)==0 ) { 
       FermionField gauss(FermOp.FermionRedBlackGrid());
@@ -208,9 +219,7 @@ public:
 
     SchurDifferentiableOperator<Impl> Mpc(FermOp);
 
-    ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter, PowerNegHalf);
-
-    msCG(Mpc, PhiOdd, MPhi_k);
+    multiShiftInverse(PowerNegHalf, PhiOdd, MPhi_k);
 
     dSdU = Zero();
     for (int k = 0; k < Npole; k++) {
@@ -0,0 +1,176 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./lib/qcd/action/pseudofermion/OneFlavourEvenOddRationalMixedPrec.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#ifndef QCD_PSEUDOFERMION_ONE_FLAVOUR_EVEN_ODD_RATIONAL_MIXED_PREC_H
+#define QCD_PSEUDOFERMION_ONE_FLAVOUR_EVEN_ODD_RATIONAL_MIXED_PREC_H
+
+NAMESPACE_BEGIN(Grid);
+
+    ///////////////////////////////////////
+    // One flavour rational actions with the multi-shift solves in mixed
+    // precision: single precision Krylov recurrences on a copy of the
+    // operators in ImplF, reliable updates and cleanup in double
+    // (ConjugateGradientMultiShiftMixedPrec).
+    ///////////////////////////////////////
+
+    template<class ImplD, class ImplF>
+    class OneFlavourEvenOddRationalMixedPrecPseudoFermionAction : public OneFlavourEvenOddRationalPseudoFermionAction<ImplD> {
+    public:
+
+      typedef OneFlavourEvenOddRationalPseudoFermionAction<ImplD> Base;
+      INHERIT_IMPL_TYPES(ImplD);
+      typedef typename ImplF::FermionField FermionFieldF;
+      typedef typename ImplF::GaugeField   GaugeFieldF;
+      typedef OneFlavourRationalParams Params;
+
+    private:
+
+      FermionOperator<ImplD> & FermOpD;
+      FermionOperator<ImplF> & FermOpF;
+      RealD Delta; // reliable update parameter
+
+      void ImportGaugeF(const GaugeField &U) {
+	GaugeFieldF Uf(FermOpF.GaugeGrid());
+	precisionChange(Uf,U);
+	FermOpF.ImportGauge(Uf);
+      }
+
+    protected:
+
+      virtual void multiShiftInverse(MultiShiftFunction &approx, const FermionField &in, FermionField &out){
+	SchurDifferentiableOperator<ImplD> MpcD(FermOpD);
+	SchurDifferentiableOperator<ImplF> MpcF(FermOpF);
+	ConjugateGradientMultiShiftMixedPrec<FermionField,FermionFieldF>
+	  msCG(this->param.MaxIter,approx,FermOpF.FermionRedBlackGrid(),MpcF,Delta);
+	msCG(MpcD,in,out);
+      }
+      virtual void multiShiftInverse(MultiShiftFunction &approx, const FermionField &in, std::vector<FermionField> &out_k){
+	SchurDifferentiableOperator<ImplD> MpcD(FermOpD);
+	SchurDifferentiableOperator<ImplF> MpcF(FermOpF);
+	ConjugateGradientMultiShiftMixedPrec<FermionField,FermionFieldF>
+	  msCG(this->param.MaxIter,approx,FermOpF.FermionRedBlackGrid(),MpcF,Delta);
+	msCG(MpcD,in,out_k);
+      }
+
+    public:
+
+      OneFlavourEvenOddRationalMixedPrecPseudoFermionAction(FermionOperator<ImplD> &OpD,
+							     FermionOperator<ImplF> &OpF,
+							     Params & p,
+							     RealD _Delta = 0.1) :
+	Base(OpD,p), FermOpD(OpD), FermOpF(OpF), Delta(_Delta)
+      {};
+
+      virtual std::string action_name(){return "OneFlavourEvenOddRationalMixedPrecPseudoFermionAction";}
+
+      virtual void refresh(const GaugeField &U, GridParallelRNG& pRNG) {
+	ImportGaugeF(U);
+	Base::refresh(U,pRNG);
+      }
+      virtual RealD S(const GaugeField &U) {
+	ImportGaugeF(U);
+	return Base::S(U);
+      }
+      virtual void deriv(const GaugeField &U,GaugeField & dSdU) {
+	ImportGaugeF(U);
+	Base::deriv(U,dSdU);
+      }
+    };
+
+    template<class ImplD, class ImplF>
+    class OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction : public OneFlavourEvenOddRatioRationalPseudoFermionAction<ImplD> {
+    public:
+
+      typedef OneFlavourEvenOddRatioRationalPseudoFermionAction<ImplD> Base;
+      INHERIT_IMPL_TYPES(ImplD);
+      typedef typename ImplF::FermionField FermionFieldF;
+      typedef typename ImplF::GaugeField   GaugeFieldF;
+      typedef OneFlavourRationalParams Params;
+
+    private:
+
+      FermionOperator<ImplD> & NumOpD;
+      FermionOperator<ImplD> & DenOpD;
+      FermionOperator<ImplF> & NumOpF;
+      FermionOperator<ImplF> & DenOpF;
+      RealD Delta; // reliable update parameter
+
+      void ImportGaugeF(const GaugeField &U) {
+	GaugeFieldF Uf(NumOpF.GaugeGrid());
+	precisionChange(Uf,U);
+	NumOpF.ImportGauge(Uf);
+	DenOpF.ImportGauge(Uf);
+      }
+
+    protected:
+
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx, const FermionField &in, FermionField &out){
+	SchurDifferentiableOperator<ImplD> MpcD(numerator ? NumOpD : DenOpD);
+	SchurDifferentiableOperator<ImplF> MpcF(numerator ? NumOpF : DenOpF);
+	ConjugateGradientMultiShiftMixedPrec<FermionField,FermionFieldF>
+	  msCG(this->param.MaxIter,approx,NumOpF.FermionRedBlackGrid(),MpcF,Delta);
+	msCG(MpcD,in,out);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx, const FermionField &in, std::vector<FermionField> &out_k, FermionField &out){
+	SchurDifferentiableOperator<ImplD> MpcD(numerator ? NumOpD : DenOpD);
+	SchurDifferentiableOperator<ImplF> MpcF(numerator ? NumOpF : DenOpF);
+	ConjugateGradientMultiShiftMixedPrec<FermionField,FermionFieldF>
+	  msCG(this->param.MaxIter,approx,NumOpF.FermionRedBlackGrid(),MpcF,Delta);
+	msCG(MpcD,in,out_k,out);
+      }
+
+    public:
+
+      OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction(FermionOperator<ImplD>  &_NumOp,
+								  FermionOperator<ImplD>  &_DenOp,
+								  FermionOperator<ImplF>  &_NumOpF,
+								  FermionOperator<ImplF>  &_DenOpF,
+								  Params & p,
+								  RealD _Delta = 0.1) :
+	Base(_NumOp,_DenOp,p),
+	NumOpD(_NumOp), DenOpD(_DenOp),
+	NumOpF(_NumOpF), DenOpF(_DenOpF),
+	Delta(_Delta)
+      {};
+
+      virtual std::string action_name(){return "OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction";}
+
+      virtual void refresh(const GaugeField &U, GridParallelRNG& pRNG) {
+	ImportGaugeF(U);
+	Base::refresh(U,pRNG);
+      }
+      virtual RealD S(const GaugeField &U) {
+	ImportGaugeF(U);
+	return Base::S(U);
+      }
+      virtual void deriv(const GaugeField &U,GaugeField & dSdU) {
+	ImportGaugeF(U);
+	Base::deriv(U,dSdU);
+      }
+    };
+
+NAMESPACE_END(Grid);
+
+#endif
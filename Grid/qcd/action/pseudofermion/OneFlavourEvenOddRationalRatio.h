@@ -60,6 +60,23 @@ NAMESPACE_BEGIN(Grid);
       FermionField PhiEven; // the pseudo fermion field for this trajectory
       FermionField PhiOdd; // the pseudo fermion field for this trajectory
 
+    protected:
+      //////////////////////////////////////////////////////
+      // Multi-shift solves on VdagV (numerator) or MdagM, after the
+      // operators have imported the gauge field. A derived class may
+      // substitute the solver.
+      //////////////////////////////////////////////////////
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx, const FermionField &in, FermionField &out){
+	SchurDifferentiableOperator<Impl> Mpc(numerator ? NumOp : DenOp);
+	ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter,approx);
+	msCG(Mpc,in,out);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx, const FermionField &in, std::vector<FermionField> &out_k, FermionField &out){
+	SchurDifferentiableOperator<Impl> Mpc(numerator ? NumOp : DenOp);
+	ConjugateGradientMultiShift<FermionField> msCG(param.MaxIter,approx);
+	msCG(Mpc,in,out_k,out);
+      }
+
     public:
 
       OneFlavourEvenOddRatioRationalPseudoFermionAction(FermionOperator<Impl>  &_NumOp, 
@@ -133,14 +150,10 @@ NAMESPACE_BEGIN(Grid);
 
 
 	// MdagM^1/4 eta
-	SchurDifferentiableOperator<Impl> MdagM(DenOp);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerQuarter);
-	msCG_M(MdagM,etaOdd,tmp);
+	multiShiftInverse(false,PowerQuarter,etaOdd,tmp);
 
 	// VdagV^-1/4 MdagM^1/4 eta
-	SchurDifferentiableOperator<Impl> VdagV(NumOp);
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerNegQuarter);
-	msCG_V(VdagV,tmp,PhiOdd);
+	multiShiftInverse(true,PowerNegQuarter,tmp,PhiOdd);
 
 	assert(NumOp.ConstEE() == 1);
 	assert(DenOp.ConstEE() == 1);
@@ -160,14 +173,11 @@ NAMESPACE_BEGIN(Grid);
 	FermionField Y(NumOp.FermionRedBlackGrid());
 
 	// VdagV^1/4 Phi
-	SchurDifferentiableOperator<Impl> VdagV(NumOp);
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerQuarter);
-	msCG_V(VdagV,PhiOdd,X);
+	multiShiftInverse(true,PowerQuarter,PhiOdd,X);
 
 	// MdagM^-1/4 VdagV^1/4 Phi
 	SchurDifferentiableOperator<Impl> MdagM(DenOp);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerNegQuarter);
-	msCG_M(MdagM,X,Y);
+	multiShiftInverse(false,PowerNegQuarter,X,Y);
 
 	// Randomly apply rational bounds checks.
 	if ( (rand()%param.BoundsCheckFreq)==0 ) { 
@@ -235,12 +245,9 @@ NAMESPACE_BEGIN(Grid);
 	SchurDifferentiableOperator<Impl> VdagV(NumOp);
 	SchurDifferentiableOperator<Impl> MdagM(DenOp);
 
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerQuarter);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerNegHalf);
-
-	msCG_V(VdagV,PhiOdd,MpvPhi_k,MpvPhi);
-	msCG_M(MdagM,MpvPhi,MfMpvPhi_k,MfMpvPhi);
-	msCG_V(VdagV,MfMpvPhi,MpvMfMpvPhi_k,MpvMfMpvPhi);
+	multiShiftInverse(true ,PowerQuarter,PhiOdd,MpvPhi_k,MpvPhi);
+	multiShiftInverse(false,PowerNegHalf,MpvPhi,MfMpvPhi_k,MfMpvPhi);
+	multiShiftInverse(true ,PowerQuarter,MfMpvPhi,MpvMfMpvPhi_k,MpvMfMpvPhi);
 
 	RealD ak;
 
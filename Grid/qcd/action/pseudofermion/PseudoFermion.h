@@ -33,6 +33,7 @@ directory
 #include <Grid/qcd/action/pseudofermion/Bounds.h>
 
 #include <Grid/qcd/action/pseudofermion/EvenOddSchurDifferentiable.h>
+#include <Grid/qcd/action/pseudofermion/ChronologicalGuess.h>
 #include <Grid/qcd/action/pseudofermion/TwoFlavour.h>
 #include <Grid/qcd/action/pseudofermion/TwoFlavourRatio.h>
 #include <Grid/qcd/action/pseudofermion/TwoFlavourEvenOdd.h>
@@ -41,6 +42,7 @@ directory
 #include <Grid/qcd/action/pseudofermion/OneFlavourRationalRatio.h>
 #include <Grid/qcd/action/pseudofermion/OneFlavourEvenOddRational.h>
 #include <Grid/qcd/action/pseudofermion/OneFlavourEvenOddRationalRatio.h>
+#include <Grid/qcd/action/pseudofermion/OneFlavourEvenOddRationalMixedPrec.h>
 #include <Grid/qcd/action/pseudofermion/ExactOneFlavourRatio.h>
 
 #endif
@@ -49,6 +49,8 @@ private:
 
   FermionField Phi;  // the pseudo fermion field for this trajectory
 
+  ChronologicalGuess<FermionField> Chrono; // past force solutions
+
 public:
   /////////////////////////////////////////////////
   // Pass in required objects.
@@ -64,9 +66,12 @@ public:
 
   virtual std::string action_name(){return "TwoFlavourPseudoFermionAction";}
 
+  void SetChronoForecast(const ChronoForecastParams &p) { Chrono.SetParams(p); }
+
   virtual std::string LogParameters(){
     std::stringstream sstream;
-    sstream << GridLogMessage << "["<<action_name()<<"] has no parameters" << std::endl;
+    if ( Chrono.Enabled() ) sstream << Chrono.LogParameters(action_name());
+    else sstream << GridLogMessage << "["<<action_name()<<"] has no parameters" << std::endl;
     return sstream.str();
   }  
   
@@ -74,6 +79,7 @@ public:
   // Push the gauge field in to the dops. Assume any BC's and smearing already applied
   //////////////////////////////////////////////////////////////////////////////////////
   virtual void refresh(const GaugeField &U, GridParallelRNG &pRNG) {
+    Chrono.Reset();
     // P(phi) = e^{- phi^dag (MdagM)^-1 phi}
     // Phi = Mdag eta
     // P(eta) = e^{- eta^dag eta}
@@ -137,8 +143,7 @@ public:
 
     MdagMLinearOperator<FermionOperator<Impl>, FermionField> MdagMOp(FermOp);
 
-    X = Zero();
-    DerivativeSolver(MdagMOp, Phi, X); // X = (MdagM)^-1 phi    
+    Chrono(DerivativeSolver, MdagMOp, Phi, X); // X = (MdagM)^-1 phi
     MdagMOp.Op(X, Y);                  // Y = M X = (Mdag)^-1 phi
 
     // Our conventions really make this UdSdU; We do not differentiate wrt Udag here.
@@ -51,6 +51,8 @@ private:
   FermionField PhiOdd;   // the pseudo fermion field for this trajectory
   FermionField PhiEven;  // the pseudo fermion field for this trajectory
 
+  ChronologicalGuess<FermionField> Chrono; // past force solutions
+
 public:
   /////////////////////////////////////////////////
   // Pass in required objects.
@@ -66,10 +68,13 @@ public:
   {};
   
   virtual std::string action_name(){return "TwoFlavourEvenOddPseudoFermionAction";}
+
+  void SetChronoForecast(const ChronoForecastParams &p) { Chrono.SetParams(p); }
       
   virtual std::string LogParameters(){
     std::stringstream sstream;
-    sstream << GridLogMessage << "["<<action_name()<<"] has no parameters" << std::endl;
+    if ( Chrono.Enabled() ) sstream << Chrono.LogParameters(action_name());
+    else sstream << GridLogMessage << "["<<action_name()<<"] has no parameters" << std::endl;
     return sstream.str();
   }  
 
@@ -78,6 +83,7 @@ public:
   // Push the gauge field in to the dops. Assume any BC's and smearing already applied
   //////////////////////////////////////////////////////////////////////////////////////
   virtual void refresh(const GaugeField &U, GridParallelRNG& pRNG) {
+    Chrono.Reset();
     
     // P(phi) = e^{- phi^dag (MpcdagMpc)^-1 phi}
     // Phi = McpDag eta 
@@ -155,8 +161,7 @@ public:
     // Our conventions really make this UdSdU; We do not differentiate wrt Udag here.
     // So must take dSdU - adj(dSdU) and left multiply by mom to get dS/dt.
 
-    X=Zero();
-    DerivativeSolver(Mpc,PhiOdd,X);
+    Chrono(DerivativeSolver,Mpc,PhiOdd,X);
     Mpc.Mpc(X,Y);
     Mpc.MpcDeriv(tmp , Y, X );    dSdU=tmp;
     Mpc.MpcDagDeriv(tmp , X, Y);  dSdU=dSdU+tmp;
@@ -50,6 +50,8 @@ NAMESPACE_BEGIN(Grid);
       FermionField PhiOdd;   // the pseudo fermion field for this trajectory
       FermionField PhiEven;  // the pseudo fermion field for this trajectory
 
+      ChronologicalGuess<FermionField> Chrono; // past force solutions
+
     public:
       TwoFlavourEvenOddRatioPseudoFermionAction(FermionOperator<Impl>  &_NumOp, 
                                                 FermionOperator<Impl>  &_DenOp, 
@@ -77,14 +79,18 @@ NAMESPACE_BEGIN(Grid);
 
       virtual std::string action_name(){return "TwoFlavourEvenOddRatioPseudoFermionAction";}
 
+      void SetChronoForecast(const ChronoForecastParams &p) { Chrono.SetParams(p); }
+
       virtual std::string LogParameters(){
 	std::stringstream sstream;
-	sstream << GridLogMessage << "["<<action_name()<<"] has no parameters" << std::endl;
+	if ( Chrono.Enabled() ) sstream << Chrono.LogParameters(action_name());
+	else sstream << GridLogMessage << "["<<action_name()<<"] has no parameters" << std::endl;
 	return sstream.str();
       } 
 
       
       virtual void refresh(const GaugeField &U, GridParallelRNG& pRNG) {
+        Chrono.Reset();
 
         // P(phi) = e^{- phi^dag Vpc (MpcdagMpc)^-1 Vpcdag phi}
         //
@@ -187,8 +193,7 @@ NAMESPACE_BEGIN(Grid);
         //X = (Mdag M)^-1 V^dag phi
         //Y = (Mdag)^-1 V^dag  phi
         Vpc.MpcDag(PhiOdd,Y);          // Y= Vdag phi
-        X=Zero();
-        DerivativeSolver(Mpc,Y,X);     // X= (MdagM)^-1 Vdag phi
+        Chrono(DerivativeSolver,Mpc,Y,X); // X= (MdagM)^-1 Vdag phi
         Mpc.Mpc(X,Y);                  // Y=  Mdag^-1 Vdag phi
 
         // phi^dag V (Mdag M)^-1 dV^dag  phi
@@ -49,6 +49,8 @@ private:
 
   FermionField Phi; // the pseudo fermion field for this trajectory
 
+  ChronologicalGuess<FermionField> Chrono; // past force solutions
+
 public:
   TwoFlavourRatioPseudoFermionAction(FermionOperator<Impl>  &_NumOp, 
 				     FermionOperator<Impl>  &_DenOp, 
@@ -58,13 +60,17 @@ public:
       
   virtual std::string action_name(){return "TwoFlavourRatioPseudoFermionAction";}
 
+  void SetChronoForecast(const ChronoForecastParams &p) { Chrono.SetParams(p); }
+
   virtual std::string LogParameters(){
     std::stringstream sstream;
-    sstream << GridLogMessage << "["<<action_name()<<"] has no parameters" << std::endl;
+    if ( Chrono.Enabled() ) sstream << Chrono.LogParameters(action_name());
+    else sstream << GridLogMessage << "["<<action_name()<<"] has no parameters" << std::endl;
     return sstream.str();
   }  
       
   virtual void refresh(const GaugeField &U, GridParallelRNG& pRNG) {
+    Chrono.Reset();
 
     // P(phi) = e^{- phi^dag V (MdagM)^-1 Vdag phi}
     //
@@ -147,8 +153,7 @@ public:
     //X = (Mdag M)^-1 V^dag phi
     //Y = (Mdag)^-1 V^dag  phi
     NumOp.Mdag(Phi,Y);              // Y= Vdag phi
-    X=Zero();
-    DerivativeSolver(MdagMOp,Y,X);      // X= (MdagM)^-1 Vdag phi
+    Chrono(DerivativeSolver,MdagMOp,Y,X);  // X= (MdagM)^-1 Vdag phi
     DenOp.M(X,Y);                  // Y=  Mdag^-1 Vdag phi
 
     // phi^dag V (Mdag M)^-1 dV^dag  phi
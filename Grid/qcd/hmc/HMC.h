@@ -230,6 +230,10 @@ public:
       }
       std::cout << GridLogMessage << ":::::::::::::::::::::::::::::::::::::::::::" << std::endl;
     }
+
+    for (int obs = 0; obs < Observables.size(); obs++) {
+      Observables[obs]->EvolutionComplete();
+    }
   }
 
 };
@@ -121,6 +121,17 @@ class HMCForceGradient: public HMCModule< GenericHMCRunnerTemplate<Implementatio
   }
 };
 
+template < class ImplementationPolicy, class RepresentationPolicy, class ReaderClass >
+class HMCOMF4: public HMCModule< GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, OMF4>, ReaderClass  >{
+  typedef HMCModule< GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, OMF4>, ReaderClass   > HMCBaseMod;
+  using HMCBaseMod::HMCBaseMod;
+
+  // aquire resource
+  virtual void initialize(){
+    this->HMCPtr.reset(new GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, OMF4>(this->Par_) );
+  }
+};
+
 extern char hmc_string[];
 
 //////////////////////////////////////////////////////////////
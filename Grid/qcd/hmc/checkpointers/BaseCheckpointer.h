@@ -39,16 +39,23 @@ public:
 				  int, saveInterval, 
 				  std::string, format, );
 
+  // Write in the background while the next trajectories run (Nersc and
+  // Binary checkpointers). Set in code; not in the parameter file, so
+  // existing Checkpointer blocks still read.
+  bool async;
+
   CheckpointerParameters(std::string cf = "cfg", std::string rn = "rng",
-			 int savemodulo = 1, const std::string &f = "IEEE64BIG")
+			 int savemodulo = 1, const std::string &f = "IEEE64BIG",
+			 bool as = false)
     : config_prefix(cf),
       rng_prefix(rn),
       saveInterval(savemodulo),
-      format(f){};
+      format(f),
+      async(as){};
 
 
   template <class ReaderClass >
-  CheckpointerParameters(Reader<ReaderClass> &Reader) {
+  CheckpointerParameters(Reader<ReaderClass> &Reader) : async(false) {
     read(Reader, "Checkpointer", *this);
   }
  
@@ -40,6 +40,7 @@ template <class Impl>
 class BinaryHmcCheckpointer : public BaseHmcCheckpointer<Impl> {
 private:
   CheckpointerParameters Params;
+  BinaryIOAsyncWriter    Writer;
 
 public:
   INHERIT_FIELD_TYPES(Impl);  // Gets the Field type, a Lattice object
@@ -67,11 +68,35 @@ public:
       std::string config, rng;
       this->build_filenames(traj, Params, config, rng);
 
+      BinarySimpleUnmunger<sobj_double, sobj> munge;
+
+      if ( Params.async ) {
+        // Completes the previous checkpoint, then snapshots U and the RNGs
+        Writer.Wait();
+        GridBase *grid = U.Grid();
+        if ( grid->IsBoss() ) {
+          truncate(rng);
+          truncate(config);
+        }
+        grid->Barrier();
+        Writer.AddRNG(sRNG, pRNG, rng, 0, nullptr);
+        Writer.template AddLatticeObject<vobj, sobj_double>(U, config, munge, 0, Params.format,
+                                                            [config](uint32_t nersc_csum,uint32_t scidac_csuma,uint32_t scidac_csumb) {
+          std::cout << GridLogMessage << "Written Binary Configuration " << config
+                    << " checksum " << std::hex 
+                    << nersc_csum   <<"/"
+                    << scidac_csuma   <<"/"
+                    << scidac_csumb 
+                    << std::dec << std::endl;
+        });
+        Writer.Start();
+        return;
+      }
+
       uint32_t nersc_csum;
       uint32_t scidac_csuma;
       uint32_t scidac_csumb;
       
-      BinarySimpleUnmunger<sobj_double, sobj> munge;
       truncate(rng);
       BinaryIO::writeRNG(sRNG, pRNG, rng, 0,nersc_csum,scidac_csuma,scidac_csumb);
       truncate(config);
@@ -89,7 +114,10 @@ public:
 
   };
 
+  void EvolutionComplete(void) { Writer.Wait(); };
+
   void CheckpointRestore(int traj, Field &U, GridSerialRNG &sRNG, GridParallelRNG &pRNG) {
+    Writer.Wait();
     std::string config, rng;
     this->build_filenames(traj, Params, config, rng);
     this->check_filename(rng);
@@ -40,6 +40,7 @@ template <class Gimpl>
 class NerscHmcCheckpointer : public BaseHmcCheckpointer<Gimpl> {
 private:
   CheckpointerParameters Params;
+  BinaryIOAsyncWriter    Writer;
 
 public:
   INHERIT_GIMPL_TYPES(Gimpl);  // only for gauge configurations
@@ -58,15 +59,25 @@ public:
       std::string config, rng;
       this->build_filenames(traj, Params, config, rng);
 
-      int precision32 = 1;
-      int tworow = 0;
-      NerscIO::writeRNGState(sRNG, pRNG, rng);
-      NerscIO::writeConfiguration<GaugeStats>(U, config, tworow, precision32);
+      if ( Params.async ) {
+        // Completes the previous checkpoint, then snapshots U and the RNGs
+        NerscIO::writeRNGState(Writer, sRNG, pRNG, rng);
+        NerscIO::writeConfiguration<GaugeStats>(Writer, U, config);
+        Writer.Start();
+      } else {
+        int precision32 = 1;
+        int tworow = 0;
+        NerscIO::writeRNGState(sRNG, pRNG, rng);
+        NerscIO::writeConfiguration<GaugeStats>(U, config, tworow, precision32);
+      }
     }
   };
 
+  void EvolutionComplete(void) { Writer.Wait(); };
+
   void CheckpointRestore(int traj, GaugeField &U, GridSerialRNG &sRNG,
                          GridParallelRNG &pRNG) {
+    Writer.Wait();
     std::string config, rng;
     this->build_filenames(traj, Params, config, rng);
     this->check_filename(rng);
@@ -53,6 +53,11 @@ class ScidacHmcCheckpointer : public BaseHmcCheckpointer<Implementation> {
   void initialize(const CheckpointerParameters &Params_) {
     Params = Params_;
 
+    // No background mode for LIME files
+    if ( Params.async ) {
+      std::cout << GridLogMessage << "ScidacHmcCheckpointer: async checkpointing not supported, writing synchronously" << std::endl;
+    }
+
     // check here that the format is valid
     int ieee32big = (Params.format == std::string("IEEE32BIG"));
     int ieee32    = (Params.format == std::string("IEEE32"));
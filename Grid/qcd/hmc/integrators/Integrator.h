@@ -86,6 +86,37 @@ protected:
 
   const ActionSet<Field, RepresentationPolicy> as;
 
+  ////////////////////////////////////////////////////////////////////////////
+  // Force cache: the total force of each level is kept together with the
+  // generation of the MD gauge field it was computed on; update_U advances
+  // the generation. A further P update of the same level before U moves
+  // reuses it. This covers the boundary of consecutive steps and the
+  // boundaries of a nested level either side of a P update of its parent,
+  // so integrators need not merge coincident P updates by hand.
+  ////////////////////////////////////////////////////////////////////////////
+  Field const *cache_U;                 // the field being integrated
+  uint64_t U_generation;
+  std::vector<Field>   cache_force;
+  std::vector<int64_t> cache_generation;// -1 : invalid
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Per action force statistics over a trajectory, for step size tuning
+  ////////////////////////////////////////////////////////////////////////////
+  struct ForceStatistics {
+    int   evals      = 0;
+    RealD sum_abs    = 0.0;
+    RealD max_abs    = 0.0;
+    RealD time_force = 0.0; // ms
+    RealD time_full  = 0.0; // ms
+  };
+  std::vector<std::vector<ForceStatistics> > force_stats;
+  std::vector<int> cache_hits;
+
+  void invalidate_force_cache(void)
+  {
+    for (int level = 0; level < levels; ++level) cache_generation[level] = -1;
+  }
+
   //Get a pointer to a shared static instance of the "do-nothing" momentum filter to serve as a default
   static MomentumFilterBase<MomentaField> const* getDefaultMomFilter(){ 
     static MomentumFilterNone<MomentaField> filter;
@@ -106,7 +137,7 @@ protected:
   {
     template <class FieldType, class GF, class Repr>
     void operator()(std::vector<Action<FieldType>*> repr_set, Repr& Rep,
-                    GF& Mom, GF& U, double ep) {
+                    GF& Force, GF& U) {
       for (int a = 0; a < repr_set.size(); ++a) {
         FieldType forceR(U.Grid());
         // Implement smearing only for the fundamental representation now
@@ -114,7 +145,7 @@ protected:
         GF force = Rep.RtoFundamentalProject(forceR);  // Ta for the fundamental rep
         Real force_abs = std::sqrt(norm2(force)/(U.Grid()->gSites()));
         std::cout << GridLogIntegrator << "Hirep Force average: " << force_abs << std::endl;
-	Mom -= force * ep* HMC_MOMENTUM_DENOMINATOR;; 
+	Force += force;
       }
     }
   } update_P_hireps{};
@@ -122,11 +153,23 @@ protected:
   void update_P(MomentaField& Mom, Field& U, int level, double ep) {
     // input U actually not used in the fundamental case
     // Fundamental updates, include smearing
+    conformable(U.Grid(), Mom.Grid());
+
+    int use_cache = (&U == cache_U);
+    if ( use_cache && (cache_generation[level] == (int64_t)U_generation) ) {
+      std::cout << GridLogIntegrator << "["<<level<<"] P update reuses the cached force" << std::endl;
+      cache_hits[level]++;
+      Mom -= cache_force[level] * ep* HMC_MOMENTUM_DENOMINATOR;
+      MomFilter->applyFilter(Mom);
+      return;
+    }
+
+    Field level_force(U.Grid());
+    level_force = Zero();
 
     for (int a = 0; a < as[level].actions.size(); ++a) {
       double start_full = usecond();
       Field force(U.Grid());
-      conformable(U.Grid(), Mom.Grid());
 
       Field& Us = Smearer.get_U(as[level].actions.at(a)->is_smeared);
       double start_force = usecond();
@@ -138,15 +181,29 @@ protected:
       double end_force = usecond();
       Real force_abs = std::sqrt(norm2(force)/U.Grid()->gSites());
       std::cout << GridLogIntegrator << "["<<level<<"]["<<a<<"] Force average: " << force_abs << std::endl;
-      Mom -= force * ep* HMC_MOMENTUM_DENOMINATOR;; 
+      level_force += force;
       double end_full = usecond();
       double time_full  = (end_full - start_full) / 1e3;
       double time_force = (end_force - start_force) / 1e3;
       std::cout << GridLogMessage << "["<<level<<"]["<<a<<"] P update elapsed time: " << time_full << " ms (force: " << time_force << " ms)"  << std::endl;
+
+      ForceStatistics &stats = force_stats[level][a];
+      stats.evals++;
+      stats.sum_abs   += force_abs;
+      stats.max_abs    = std::max(stats.max_abs, (RealD)force_abs);
+      stats.time_force+= time_force;
+      stats.time_full += time_full;
     }
 
     // Force from the other representations
-    as[level].apply(update_P_hireps, Representations, Mom, U, ep);
+    as[level].apply(update_P_hireps, Representations, level_force, U);
+
+    Mom -= level_force * ep* HMC_MOMENTUM_DENOMINATOR;
+
+    if ( use_cache ) {
+      cache_force[level]      = level_force;
+      cache_generation[level] = U_generation;
+    }
 
     MomFilter->applyFilter(Mom);
   }
@@ -164,6 +221,7 @@ protected:
   {
     // exponential of Mom*U in the gauge fields case
     FieldImplementation::update_field(Mom, U, ep);
+    if ( &U == cache_U ) U_generation++;
 
     // Update the smeared fields, can be implemented as observer
     Smearer.set_Field(U);
@@ -187,6 +245,14 @@ public:
   {
     t_P.resize(levels, 0.0);
     t_U = 0.0;
+
+    cache_U = nullptr;
+    U_generation = 0;
+    cache_force.resize(levels, Field(grid));
+    cache_generation.resize(levels, -1);
+    cache_hits.resize(levels, 0);
+    force_stats.resize(levels);
+    for (int level = 0; level < levels; ++level) force_stats[level].resize(as[level].actions.size());
     // initialization of smearer delegated outside of Integrator
 
     //Default the momentum filter to "do-nothing"
@@ -227,6 +293,33 @@ public:
 
   }
 
+  // Per action force magnitude and cost over the last trajectory.
+  // |F| dt is the per step impulse; balancing it against the cost per
+  // evaluation across the levels is the usual guide for the multipliers.
+  void print_force_statistics()
+  {
+    std::cout << GridLogMessage << ":::::::::::::::::::::::::::::::::::::::::" << std::endl;
+    std::cout << GridLogMessage << "[Integrator] Force statistics for the last trajectory: "<<std::endl;
+    RealD dt = Params.trajL/Params.MDsteps;
+    for (int level = 0; level < as.size(); ++level) {
+      dt /= as[level].multiplier;
+      std::cout << GridLogMessage << "[Integrator] ---- Level: "<< level << " dt " << dt
+		<< " cached P updates " << cache_hits[level] << std::endl;
+      for (int actionID = 0; actionID < as[level].actions.size(); ++actionID) {
+	ForceStatistics &stats = force_stats[level][actionID];
+	if ( stats.evals == 0 ) continue;
+	RealD avg = stats.sum_abs/stats.evals;
+	std::cout << GridLogMessage << "["<< as[level].actions.at(actionID)->action_name() << "] ID: " << actionID
+		  << " evals " << stats.evals
+		  << " <|F|> " << avg << " max|F| " << stats.max_abs
+		  << " <|F|>dt " << avg*dt << " max|F|dt " << stats.max_abs*dt
+		  << " time/eval " << stats.time_force/stats.evals << " ms"
+		  << " total " << stats.time_full << " ms" << std::endl;
+      }
+    }
+    std::cout << GridLogMessage << ":::::::::::::::::::::::::::::::::::::::::"<< std::endl;
+  }
+
   void reverse_momenta()
   {
     P *= -1.0;
@@ -254,6 +347,9 @@ public:
 
     FieldImplementation::generate_momenta(P, pRNG);
 
+    // new pseudofermions: no force computed so far is valid
+    invalidate_force_cache();
+
     // Update the smeared fields, can be implemented as observer
     // necessary to keep the fields updated even after a reject
     // of the Metropolis
@@ -329,6 +425,14 @@ public:
       t_P[level] = 0;
     }
 
+    // track U for the force cache, and restart the statistics
+    cache_U = &U;
+    invalidate_force_cache();
+    for (int level = 0; level < as.size(); ++level) {
+      cache_hits[level] = 0;
+      for (auto &stats : force_stats[level]) stats = ForceStatistics();
+    }
+
     for (int stp = 0; stp < Params.MDsteps; ++stp) {  // MD step
       int first_step = (stp == 0);
       int last_step = (stp == Params.MDsteps - 1);
@@ -346,6 +450,9 @@ public:
     // and that we indeed got to the end of the trajectory
     assert(fabs(t_U - Params.trajL) < 1.0e-6);
 
+    cache_U = nullptr;
+    print_force_statistics();
+
   }
 
 };
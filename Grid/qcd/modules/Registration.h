@@ -124,6 +124,7 @@ static Registrar<ILDGCPModule<ImplementationPolicy>  , HMC_CPModuleFactory<cp_st
 static Registrar< HMCLeapFrog<ImplementationPolicy, RepresentationPolicy, Serialiser>      , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCLFmodXMLInit("LeapFrog");
 static Registrar< HMCMinimumNorm2<ImplementationPolicy, RepresentationPolicy, Serialiser>  , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCMN2modXMLInit("MinimumNorm2");
 static Registrar< HMCForceGradient<ImplementationPolicy, RepresentationPolicy, Serialiser> , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCFGmodXMLInit("ForceGradient");
+static Registrar< HMCOMF4<ImplementationPolicy, RepresentationPolicy, Serialiser>          , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCOMF4modXMLInit("OMF4");
 
 typedef HMCRunnerModuleFactory<hmc_string, Serialiser > HMCModuleFactory;
 
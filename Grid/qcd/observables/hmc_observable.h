@@ -38,6 +38,8 @@ class HmcObservable {
                                   Field &U,
                                   GridSerialRNG &sRNG,
                                   GridParallelRNG &pRNG) = 0;
+  // End of an evolution; complete any work still in flight
+  virtual void EvolutionComplete(void) {};
 };
 
 NAMESPACE_END(Grid);
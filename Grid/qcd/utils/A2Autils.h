@@ -118,6 +118,19 @@ private:
                                const int Ns, const int ss);
 };
 
+////////////////////////////////////////////////////////////////////
+// Meson field as a sequence of complex GEMMs.
+//
+// With S_m(t)_{s1 s2}(i,j) = sum_{x in t} phase_m(x) conj(w_i(x))_{s2 c} v_j(x)_{s1 c}
+// the result is mat(m,mu,t,i,j) = trace(S_m(t)(i,j) Gamma_mu).
+//
+// Rows (i,s2) and columns (j,s1) make S_m(t) one (Ns L) x (Ns R) matrix, the
+// product of  A_m = [phase_m(x) conj(w_i(x))_{s2 c}]  and  B = [v_j(x)_{s1 c}]
+// over k=(x,c). Each thread packs a tile of MesonFieldSiteBlock sites of a
+// timeslice, all left and right vectors, into A and B (cache resident) and
+// accumulates one GEMM per momentum; the tiles of a timeslice are reduced over
+// threads, then the gamma traces are taken once per (m,t,i,j). One global sum.
+////////////////////////////////////////////////////////////////////
 template <class FImpl>
 template <typename TensorType>
 void A2Autils<FImpl>::MesonField(TensorType &mat, 
@@ -133,121 +146,158 @@ void A2Autils<FImpl>::MesonField(TensorType &mat,
   typedef typename vobj::scalar_type scalar_type;
   typedef typename vobj::vector_type vector_type;
 
-  typedef iSpinMatrix<vector_type> SpinMatrix_v;
   typedef iSpinMatrix<scalar_type> SpinMatrix_s;
+  typedef std::complex<double> GemmScalar;
+  typedef Eigen::Matrix<GemmScalar,Eigen::Dynamic,Eigen::Dynamic> GemmMatrix;
+  typedef decltype(lhs_wi[0].View(CpuRead))  FermionView;
+  typedef decltype(mom[0].View(CpuRead))     PhaseView;
+
+  const int MesonFieldSiteBlock = 64;
   
   int Lblock = mat.dimension(3); 
   int Rblock = mat.dimension(4);
 
   GridBase *grid = lhs_wi[0].Grid();
   
-  const int    Nd = grid->_ndimension;
   const int Nsimd = grid->Nsimd();
 
   int Nt     = grid->GlobalDimensions()[orthogdim];
   int Ngamma = gammas.size();
   int Nmom   = mom.size();
 
-  int fd=grid->_fdimensions[orthogdim];
   int ld=grid->_ldimensions[orthogdim];
   int rd=grid->_rdimensions[orthogdim];
 
-  // will locally sum vectors first
-  // sum across these down to scalars
-  // splitting the SIMD
-  int MFrvol = rd*Lblock*Rblock*Nmom;
-  int MFlvol = ld*Lblock*Rblock*Nmom;
-
-  Vector<SpinMatrix_v > lvSum(MFrvol);
-  thread_for( r, MFrvol,{
-    lvSum[r] = Zero();
-  });
+  const int Nsc = sizeof(sobj)/sizeof(scalar_type);   // spin x colour words of a site
+  const int Ncs = Nsc/Ns;
+  assert(Ncs*Ns == Nsc);
 
-  Vector<SpinMatrix_s > lsSum(MFlvol);             
-  thread_for(r,MFlvol,{
-    lsSum[r]=scalar_type(0.0);
-  });
+  assert(mat.dimension(0) == Nmom);
+  assert(mat.dimension(1) == Ngamma);
+  assert(mat.dimension(2) == Nt);
 
   int e1=    grid->_slice_nblock[orthogdim];
   int e2=    grid->_slice_block [orthogdim];
   int stride=grid->_slice_stride[orthogdim];
 
-  // potentially wasting cores here if local time extent too small
   if (t_kernel) *t_kernel = -usecond();
-  thread_for(r,rd,{
 
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
-
-    for(int n=0;n<e1;n++){
+  //////////////////////////////////////////////
+  // Sites (outer index, lane) of each local timeslice; lanes of an outer site adjacent
+  //////////////////////////////////////////////
+  std::vector<std::vector<std::pair<int,int> > > tsites(ld);
+  {
+    Coordinate icoor(grid->_ndimension);
+    for(int r=0;r<rd;r++){
+      int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
+      for(int n=0;n<e1;n++){
       for(int b=0;b<e2;b++){
-
 	int ss= so+n*stride+b;
+	for(int idx=0;idx<Nsimd;idx++){
+	  grid->iCoorFromIindex(icoor,idx);
+	  int lt = r+icoor[orthogdim]*rd;
+	  tsites[lt].push_back(std::make_pair(ss,idx));
+	}
+      }}
+    }
+  }
 
+  //////////////////////////////////////////////
+  // Views once, not per site
+  //////////////////////////////////////////////
+  std::vector<FermionView> lhs_v, rhs_v;
+  std::vector<PhaseView>   mom_v;
+  for(int i=0;i<Lblock;i++) lhs_v.push_back(lhs_wi[i].View(CpuRead));
+  for(int j=0;j<Rblock;j++) rhs_v.push_back(rhs_vj[j].View(CpuRead));
+  for(int m=0;m<Nmom;m++)   mom_v.push_back(mom[m].View(CpuRead));
+
+  const int rows = Ns*Lblock;   // (i,s2)
+  const int cols = Ns*Rblock;   // (j,s1)
+  std::vector<std::vector<GemmMatrix> > S(ld,std::vector<GemmMatrix>(Nmom,GemmMatrix::Zero(rows,cols)));
+
+  //////////////////////////////////////////////
+  // Work list of (lt,tile) over all local timeslices, so threads are not limited by one slice's tiles
+  //////////////////////////////////////////////
+  std::vector<std::pair<int,int> > work;
+  for(int lt=0;lt<ld;lt++){
+    int ntile = (tsites[lt].size()+MesonFieldSiteBlock-1)/MesonFieldSiteBlock;
+    for(int tile=0;tile<ntile;tile++) work.push_back(std::make_pair(lt,tile));
+  }
+  int nwork = work.size();
+
+  thread_region
+  {
+    // Per thread accumulators; sized when the thread first touches a timeslice
+    std::vector<std::vector<GemmMatrix> > Sthr(ld,std::vector<GemmMatrix>(Nmom));
+    std::vector<int> touched(ld,0);
+    GemmMatrix A(rows,Ncs*MesonFieldSiteBlock);
+    GemmMatrix Am(rows,Ncs*MesonFieldSiteBlock);
+    GemmMatrix B(Ncs*MesonFieldSiteBlock,cols);
+    std::vector<GemmScalar> phase(Nmom*MesonFieldSiteBlock);
+
+    thread_for_in_region(iw,nwork,{
+      int lt   = work[iw].first;
+      int tile = work[iw].second;
+      int nsite = tsites[lt].size();
+      if ( !touched[lt] ) {
+	for(int m=0;m<Nmom;m++) Sthr[lt][m] = GemmMatrix::Zero(rows,cols);
+	touched[lt] = 1;
+      }
+      int x0 = tile*MesonFieldSiteBlock;
+      int nx = std::min(MesonFieldSiteBlock,nsite-x0);
+      int kk = nx*Ncs;
+
+      // Pack the tile: A = conj(w), B = v, phases
+      for(int x=0;x<nx;x++){
+	int ss   = tsites[lt][x0+x].first;
+	int lane = tsites[lt][x0+x].second;
 	for(int i=0;i<Lblock;i++){
+	  sobj site = extractLane(lane,lhs_v[i][ss]);
+	  scalar_type *w = (scalar_type *)&site;
+	  for(int s=0;s<Ns;s++){
+	  for(int c=0;c<Ncs;c++){
+	    A(i*Ns+s,x*Ncs+c) = std::conj(GemmScalar(real(w[s*Ncs+c]),imag(w[s*Ncs+c])));
+	  }}
+	}
+	for(int j=0;j<Rblock;j++){
+	  sobj site = extractLane(lane,rhs_v[j][ss]);
+	  scalar_type *v = (scalar_type *)&site;
+	  for(int s=0;s<Ns;s++){
+	  for(int c=0;c<Ncs;c++){
+	    B(x*Ncs+c,j*Ns+s) = GemmScalar(real(v[s*Ncs+c]),imag(v[s*Ncs+c]));
+	  }}
+	}
+	for(int m=0;m<Nmom;m++){
+	  auto ph = TensorRemove(extractLane(lane,mom_v[m][ss]));
+	  phase[m*MesonFieldSiteBlock+x] = GemmScalar(real(ph),imag(ph));
+	}
+      }
 
-	  // Recreate view potentially expensive outside fo UVM mode
-	  autoView(lhs_v,lhs_wi[i],CpuRead);
-	  auto left = conjugate(lhs_v[ss]);
-	  for(int j=0;j<Rblock;j++){
-
-	    SpinMatrix_v vv;
-	    // Recreate view potentially expensive outside fo UVM mode
-	    autoView(rhs_v,rhs_vj[j],CpuRead);
-	    auto right = rhs_v[ss];
-	    for(int s1=0;s1<Ns;s1++){
-	    for(int s2=0;s2<Ns;s2++){
-	      vv()(s1,s2)() = left()(s2)(0) * right()(s1)(0)
-		+             left()(s2)(1) * right()(s1)(1)
-		+             left()(s2)(2) * right()(s1)(2);
-	    }}
-	    
-	    // After getting the sitewise product do the mom phase loop
-	    int base = Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*r;
-	    for ( int m=0;m<Nmom;m++){
-	      int idx = m+base;
-	      autoView(mom_v,mom[m],CpuRead);
-	      auto phase = mom_v[ss];
-	      mac(&lvSum[idx],&vv,&phase);
-	    }
-	  }
+      // One GEMM per momentum
+      for(int m=0;m<Nmom;m++){
+	for(int x=0;x<nx;x++){
+	  GemmScalar ph = phase[m*MesonFieldSiteBlock+x];
+	  Am.middleCols(x*Ncs,Ncs) = ph*A.middleCols(x*Ncs,Ncs);
 	}
+	Sthr[lt][m].noalias() += Am.leftCols(kk) * B.topRows(kk);
+      }
+    });
+    thread_critical
+    {
+      for(int lt=0;lt<ld;lt++){
+	if ( touched[lt] ) for(int m=0;m<Nmom;m++) S[lt][m] += Sthr[lt][m];
       }
     }
-  });
-
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  thread_for(rt,rd,{
-
-    Coordinate icoor(Nd);
-    ExtractBuffer<SpinMatrix_s> extracted(Nsimd);               
-
-    for(int i=0;i<Lblock;i++){
-    for(int j=0;j<Rblock;j++){
-    for(int m=0;m<Nmom;m++){
-
-      int ij_rdx = m+Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*rt;
-
-      extract(lvSum[ij_rdx],extracted);
-
-      for(int idx=0;idx<Nsimd;idx++){
-
-	grid->iCoorFromIindex(icoor,idx);
-
-	int ldx    = rt+icoor[orthogdim]*rd;
-
-	int ij_ldx = m+Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*ldx;
-
-	lsSum[ij_ldx]=lsSum[ij_ldx]+extracted[idx];
+  }
 
-      }
-    }}}
-  });
+  for(int i=0;i<Lblock;i++) lhs_v[i].ViewClose();
+  for(int j=0;j<Rblock;j++) rhs_v[j].ViewClose();
+  for(int m=0;m<Nmom;m++)   mom_v[m].ViewClose();
   if (t_kernel) *t_kernel += usecond();
-  assert(mat.dimension(0) == Nmom);
-  assert(mat.dimension(1) == Ngamma);
-  assert(mat.dimension(2) == Nt);
 
-  // ld loop and local only??
+  //////////////////////////////////////////////
+  // Gamma traces; zero on other ranks' timeslices
+  //////////////////////////////////////////////
   int pd = grid->_processors[orthogdim];
   int pc = grid->_processor_coor[orthogdim];
   thread_for_collapse(2,lt,ld,{
@@ -257,10 +307,14 @@ void A2Autils<FImpl>::MesonField(TensorType &mat,
 	for(int i=0;i<Lblock;i++){
 	  for(int j=0;j<Rblock;j++){
 	    for(int m=0;m<Nmom;m++){
-	      int ij_dx = m+Nmom*i + Nmom*Lblock * j + Nmom*Lblock * Rblock * lt;
+	      SpinMatrix_s Sij;
+	      for(int s1=0;s1<Ns;s1++){
+	      for(int s2=0;s2<Ns;s2++){
+		GemmScalar z = S[lt][m](i*Ns+s2,j*Ns+s1);
+		Sij()(s1,s2)() = scalar_type(z.real(),z.imag());
+	      }}
 	      for(int mu=0;mu<Ngamma;mu++){
-		// this is a bit slow
-		mat(m,mu,t,i,j) = trace(lsSum[ij_dx]*Gamma(gammas[mu]))()()();
+		mat(m,mu,t,i,j) = trace(Sij*Gamma(gammas[mu]))()()();
 	      }
 	    }
 	  }
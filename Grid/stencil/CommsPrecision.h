@@ -0,0 +1,154 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/stencil/CommsPrecision.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Halo comms precision, selected at run time through the compressor.
+//
+//   CommsPrecisionNative : the site object as computed
+//   CommsPrecisionSingle : fp32; same as Native for single precision fields
+//   CommsPrecisionHalf   : IEEE fp16 with a power of two scale per site (SIMD lane),
+//                          so the range is that of the field and the precision 2^-11
+//                          relative to the largest component of the site
+//   CommsPrecisionBF16   : bfloat16, round to nearest even; 2^-8 relative precision
+//
+// Packed datums are laid out back to back at CommsDatumBytes stride from the
+// base of each packet; the stencil sends that many bytes per site and runs the
+// compressor's decompression step on receipt.
+//////////////////////////////////////////////////////////////////////////////////////////
+enum CommsPrecisionPolicy {
+  CommsPrecisionNative = 0,
+  CommsPrecisionSingle = 1,
+  CommsPrecisionHalf   = 2,
+  CommsPrecisionBF16   = 3
+};
+
+template<class vobj> struct CommsPackTraits {
+  typedef typename vobj::scalar_type             scalar;
+  typedef typename RealPart<scalar>::type        real;
+  static const int Nsimd = vobj::Nsimd();
+  static const int Nlane = sizeof(scalar)/sizeof(real);        // reals per lane
+  static const int Nreal = sizeof(vobj)/sizeof(real);
+  static accelerator_inline int Lane(int i) { return (i%(Nsimd*Nlane))/Nlane; };
+};
+
+// Single precision for a single precision object is no compression at all
+template<class vobj> inline int CommsPrecisionSelect(int precision)
+{
+  typedef typename CommsPackTraits<vobj>::real real;
+  if ( (precision==CommsPrecisionSingle) && (sizeof(real)==sizeof(float)) ) return CommsPrecisionNative;
+  return precision;
+}
+
+template<class vobj> accelerator_inline int CommsDatumBytes(int precision)
+{
+  typedef CommsPackTraits<vobj> T;
+  switch(precision) {
+  case CommsPrecisionSingle: return sizeof(float)*T::Nreal;
+  case CommsPrecisionHalf:   return (sizeof(uint16_t)*T::Nreal+T::Nsimd+3)&(~0x3);
+  case CommsPrecisionBF16:   return (sizeof(uint16_t)*T::Nreal+3)&(~0x3);
+  default:                   return sizeof(vobj);
+  }
+}
+
+accelerator_inline uint16_t CommsFloatToBF16(float f)
+{
+  FP32 u; u.f = f;
+  if ( (u.u & 0x7fffffff) > 0x7f800000 ) return (u.u>>16) | 0x40; // quiet NaN
+  u.u += 0x7fff + ((u.u>>16)&0x1);
+  return u.u>>16;
+}
+accelerator_inline float CommsBF16ToFloat(uint16_t b)
+{
+  FP32 u; u.u = ((unsigned int)b)<<16;
+  return u.f;
+}
+
+template<class vobj> accelerator_inline void CommsPack(int precision,void *buf,Integer o,const vobj &in)
+{
+  typedef CommsPackTraits<vobj> T;
+  typedef typename T::real real;
+  const real *x = (const real *)&in;
+  uint8_t *datum = (uint8_t *)buf + o*CommsDatumBytes<vobj>(precision);
+
+  if ( precision == CommsPrecisionSingle ) {
+    float *f = (float *)datum;
+    for(int i=0;i<T::Nreal;i++) f[i] = x[i];
+  } else if ( precision == CommsPrecisionHalf ) {
+    uint16_t *h = (uint16_t *)datum;
+    int8_t   *e = (int8_t *)&h[T::Nreal];
+    real amax[T::Nsimd];
+    for(int l=0;l<T::Nsimd;l++) amax[l] = 0.0;
+    for(int i=0;i<T::Nreal;i++) {
+      int l = T::Lane(i);
+      real a = x[i] < 0.0 ? -x[i] : x[i];
+      amax[l] = a > amax[l] ? a : amax[l];
+    }
+    for(int l=0;l<T::Nsimd;l++) {
+      int exp=0;
+      frexp(amax[l],&exp);       // amax < 2^exp
+      exp = exp >  127 ?  127 : exp;
+      exp = exp < -127 ? -127 : exp;
+      e[l] = exp;
+    }
+    for(int i=0;i<T::Nreal;i++) {
+      h[i] = sfw_float_to_half((float)ldexp(x[i],-e[T::Lane(i)])).x;
+    }
+  } else if ( precision == CommsPrecisionBF16 ) {
+    uint16_t *b = (uint16_t *)datum;
+    for(int i=0;i<T::Nreal;i++) b[i] = CommsFloatToBF16((float)x[i]);
+  } else {
+    *((vobj *)datum) = in;
+  }
+}
+
+template<class vobj> accelerator_inline void CommsUnpack(int precision,vobj &out,const void *buf,Integer o)
+{
+  typedef CommsPackTraits<vobj> T;
+  typedef typename T::real real;
+  real *x = (real *)&out;
+  const uint8_t *datum = (const uint8_t *)buf + o*CommsDatumBytes<vobj>(precision);
+
+  if ( precision == CommsPrecisionSingle ) {
+    const float *f = (const float *)datum;
+    for(int i=0;i<T::Nreal;i++) x[i] = f[i];
+  } else if ( precision == CommsPrecisionHalf ) {
+    const uint16_t *h = (const uint16_t *)datum;
+    const int8_t   *e = (const int8_t *)&h[T::Nreal];
+    for(int i=0;i<T::Nreal;i++) {
+      x[i] = ldexp((real)sfw_half_to_float(Grid_half(h[i])),e[T::Lane(i)]);
+    }
+  } else if ( precision == CommsPrecisionBF16 ) {
+    const uint16_t *b = (const uint16_t *)datum;
+    for(int i=0;i<T::Nreal;i++) x[i] = CommsBF16ToFloat(b[i]);
+  } else {
+    out = *((const vobj *)datum);
+  }
+}
+
+NAMESPACE_END(Grid);
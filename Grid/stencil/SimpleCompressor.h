@@ -6,17 +6,41 @@ NAMESPACE_BEGIN(Grid);
 template<class vobj>
 class SimpleCompressor {
 public:
+  int precision; // CommsPrecisionPolicy
+
+  SimpleCompressor(int _precision=CommsPrecisionNative) : precision(CommsPrecisionSelect<vobj>(_precision)) {};
+
   void Point(int) {};
-  accelerator_inline int  CommDatumSize(void) { return sizeof(vobj); }
-  accelerator_inline bool DecompressionStep(void) { return false; }
-  template<class cobj> accelerator_inline void Compress(cobj *buf,int o,const cobj &in) { buf[o]=in; }
+  accelerator_inline int  CommDatumSize(void) { return CommsDatumBytes<vobj>(precision); }
+  accelerator_inline bool DecompressionStep(void) { return precision!=CommsPrecisionNative; }
+  template<class cobj> accelerator_inline void Compress(cobj *buf,int o,const cobj &in) {
+    if ( precision==CommsPrecisionNative ) buf[o]=in;
+    else CommsPack(precision,(void *)buf,o,in);
+  }
   accelerator_inline void Exchange(vobj *mp,vobj *vp0,vobj *vp1,Integer type,Integer o){
-    exchange(mp[2*o],mp[2*o+1],vp0[o],vp1[o],type);
+    if ( precision==CommsPrecisionNative ) {
+      exchange(mp[2*o],mp[2*o+1],vp0[o],vp1[o],type);
+    } else {
+      vobj t0,t1;
+      CommsUnpack(precision,t0,(void *)vp0,o);
+      CommsUnpack(precision,t1,(void *)vp1,o);
+      exchange(mp[2*o],mp[2*o+1],t0,t1,type);
+    }
+  }
+  accelerator_inline void Decompress(vobj *out,vobj *in, int o){
+    assert(precision!=CommsPrecisionNative);
+    CommsUnpack(precision,out[o],(void *)in,o);
   }
-  accelerator_inline void Decompress(vobj *out,vobj *in, int o){ assert(0); }
   accelerator_inline void CompressExchange(vobj *out0,vobj *out1,const vobj *in,
 			       int j,int k, int m,int type){
-    exchange(out0[j],out1[j],in[k],in[m],type);
+    if ( precision==CommsPrecisionNative ) {
+      exchange(out0[j],out1[j],in[k],in[m],type);
+    } else {
+      vobj t0,t1;
+      exchange(t0,t1,in[k],in[m],type);
+      CommsPack(precision,(void *)out0,j,t0);
+      CommsPack(precision,(void *)out1,j,t1);
+    }
   }
   // For cshift. Cshift should drop compressor coupling altogether 
   // because I had to decouple the code from the Stencil anyway
@@ -30,6 +30,7 @@
 
 #define STENCIL_MAX (16)
 
+#include <Grid/stencil/CommsPrecision.h>     // subdir aggregate
 #include <Grid/stencil/SimpleCompressor.h>   // subdir aggregate
 #include <Grid/stencil/Lebesgue.h>   // subdir aggregate
 
@@ -69,13 +70,22 @@ void Gather_plane_simple_table (Vector<std::pair<int,int> >& table,const Lattice
   std::pair<int,int> *table_v = & table[0];
 
   auto rhs_v = rhs.View(AcceleratorRead);
-  accelerator_forNB( i,num, vobj::Nsimd(), {
-    typedef decltype(coalescedRead(buffer[0])) compressed_t;
-    compressed_t   tmp_c;
-    uint64_t o = table_v[i].first;
-    compress.Compress(&tmp_c,0,rhs_v(so+table_v[i].second));
-    coalescedWrite(buffer[off+o],tmp_c);
-  });
+  if ( compress.DecompressionStep() ) {
+    // Reduced precision datums are packed at CommDatumSize stride from the start
+    // of this face; the packet and its decompression are based at &buffer[off]
+    cobj *face = &buffer[off];
+    accelerator_forNB( i,num, 1, {
+      compress.Compress(face,table_v[i].first,rhs_v[so+table_v[i].second]);
+    });
+  } else {
+    accelerator_forNB( i,num, vobj::Nsimd(), {
+      typedef decltype(coalescedRead(buffer[0])) compressed_t;
+      compressed_t   tmp_c;
+      uint64_t o = table_v[i].first;
+      compress.Compress(&tmp_c,0,rhs_v(so+table_v[i].second));
+      coalescedWrite(buffer[off+o],tmp_c);
+    });
+  }
   rhs_v.ViewClose();
 // Further optimisatoin: i) software prefetch the first element of the next table entry, prefetch the table
 }
@@ -245,6 +255,38 @@ public:
     cobj * mpi_p;
     Integer buffer_size;
   };
+  ///////////////////////////////////////////
+  // Persistent comms requests matching a packet list. Requests are
+  // never shared between copies of a stencil; a copy rebuilds its own.
+  ///////////////////////////////////////////
+  struct PersistentComms {
+    std::vector<Packet> packets;
+    std::vector<std::vector<CommsRequest_t> > reqs;
+    std::vector<double> bytes;
+    PersistentComms() {};
+    PersistentComms(const PersistentComms &) {};
+    PersistentComms & operator=(const PersistentComms &) { Free(); return *this; };
+    ~PersistentComms() { Free(); };
+    void Free(void) {
+      for(int i=0;i<reqs.size();i++){
+	CartesianCommunicator::StencilSendToRecvFromPersistentFree(reqs[i]);
+      }
+      reqs.resize(0);
+      bytes.resize(0);
+      packets.resize(0);
+    }
+    bool Matches(const std::vector<Packet> &pkts) const {
+      if ( pkts.size() != packets.size() ) return false;
+      for(int i=0;i<pkts.size();i++){
+	if ( (pkts[i].send_buf  != packets[i].send_buf)  ||
+	     (pkts[i].recv_buf  != packets[i].recv_buf)  ||
+	     (pkts[i].to_rank   != packets[i].to_rank)   ||
+	     (pkts[i].from_rank != packets[i].from_rank) ||
+	     (pkts[i].bytes     != packets[i].bytes) ) return false;
+      }
+      return true;
+    }
+  };
 
 
 protected:
@@ -275,6 +317,7 @@ public:
   std::vector<Merge> MergersSHM;
   std::vector<Decompress> Decompressions;
   std::vector<Decompress> DecompressionsSHM;
+  PersistentComms Persistent;
 
   ///////////////////////////////////////////////////////////
   // Unified Comms buffers for all directions
@@ -433,6 +476,42 @@ public:
     commtime+=usecond();
   }
   ////////////////////////////////////////////////////////////////////////
+  // Non blocking send and receive on persistent requests. The packet list
+  // is fixed by the stencil geometry, so requests are only (re)built when
+  // it changes and are otherwise restarted.
+  ////////////////////////////////////////////////////////////////////////
+  void CommunicatePersistentBegin(void)
+  {
+    if ( ! Persistent.Matches(Packets) ) {
+      Persistent.Free();
+      Persistent.packets = Packets;
+      Persistent.reqs.resize(Packets.size());
+      Persistent.bytes.resize(Packets.size());
+      for(int i=0;i<Packets.size();i++){
+	Persistent.bytes[i]=_grid->StencilSendToRecvFromPersistentInit(Persistent.reqs[i],
+								       Packets[i].send_buf,
+								       Packets[i].to_rank,
+								       Packets[i].recv_buf,
+								       Packets[i].from_rank,
+								       Packets[i].bytes,i);
+      }
+    }
+    commtime-=usecond();
+    for(int i=0;i<Packets.size();i++){
+      _grid->StencilSendToRecvFromPersistentStart(Persistent.reqs[i],i);
+      comms_bytes+=Persistent.bytes[i];
+      shm_bytes  +=2*Packets[i].bytes-Persistent.bytes[i];
+    }
+  }
+
+  void CommunicatePersistentComplete(void)
+  {
+    for(int i=0;i<Packets.size();i++){
+      _grid->StencilSendToRecvFromPersistentComplete(Persistent.reqs[i],i);
+    }
+    commtime+=usecond();
+  }
+  ////////////////////////////////////////////////////////////////////////
   // Blocking send and receive. Either sequential or parallel.
   ////////////////////////////////////////////////////////////////////////
   void Communicate(void)
@@ -460,9 +539,8 @@ public:
 	}
       }
     } else { // Concurrent and non-threaded asynch calls to MPI
-      std::vector<std::vector<CommsRequest_t> > reqs;
-      this->CommunicateBegin(reqs);
-      this->CommunicateComplete(reqs);
+      this->CommunicatePersistentBegin();
+      this->CommunicatePersistentComplete();
     }
   }
 
@@ -475,6 +553,25 @@ public:
     CommsMerge(compress);
   }
 
+  ////////////////////////////////////////////////////////////////////////
+  // Split halo exchange. After Begin the node local (SHM) faces are merged
+  // and kernels may compute every site whose neighbours are all local or
+  // same_node; after Finish the remaining surface sites may be completed.
+  ////////////////////////////////////////////////////////////////////////
+  template<class compressor> void HaloExchangeBegin(const Lattice<vobj> &source,compressor &compress)
+  {
+    Prepare();
+    HaloGather(source,compress);
+    CommunicatePersistentBegin();
+    CommsMergeSHM(compress);
+  }
+
+  template<class compressor> void HaloExchangeFinish(compressor &compress)
+  {
+    CommunicatePersistentComplete();
+    CommsMerge(compress);
+  }
+
   template<class compressor> int HaloGatherDir(const Lattice<vobj> &source,compressor &compress,int point,int & face_idx)
   {
     int dimension    = this->_directions[point];
@@ -29,4 +29,7 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 #pragma once
 
 #include <Grid/threads/Threads.h>
+#ifdef GRID_WORK_STEALING
+#include <Grid/threads/ThreadPool.h>
+#endif
 #include <Grid/threads/Accelerator.h>
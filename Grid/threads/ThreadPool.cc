@@ -0,0 +1,269 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/threads/ThreadPool.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/GridCore.h>
+
+#ifdef GRID_WORK_STEALING
+
+NAMESPACE_BEGIN(Grid);
+
+uint64_t GridThreadPool::MinGrain        = 1;
+uint64_t GridThreadPool::GrainsPerThread = 8;
+
+#define GRID_POOL_SPIN (1<<16) // polls before a idle worker blocks on the condition variable
+
+static inline void PoolRelax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////
+// Per worker iteration range; owner takes from the front, thieves
+// split off the back half. Padded to a cache line.
+////////////////////////////////////////////////////////////////////
+struct alignas(64) PoolRange {
+  std::atomic_flag      lock = ATOMIC_FLAG_INIT;
+  std::atomic<uint64_t> begin;
+  std::atomic<uint64_t> end;
+  void Lock(void)   { while ( lock.test_and_set(std::memory_order_acquire) ) PoolRelax(); }
+  void Unlock(void) { lock.clear(std::memory_order_release); }
+  uint64_t Remaining(void) {
+    uint64_t b = begin.load(std::memory_order_relaxed);
+    uint64_t e = end.load(std::memory_order_relaxed);
+    return (e>b) ? e-b : 0;
+  }
+};
+
+struct PoolState {
+  int nthreads;
+  std::vector<std::thread> workers;
+  std::unique_ptr<PoolRange[]> ranges;
+
+  std::atomic<uint64_t> generation;
+  std::atomic<int>      departed;
+  std::atomic<int>      shutdown;
+  std::mutex              mutex;
+  std::condition_variable wake;
+
+  // Current loop
+  GridThreadPool::RangeFunction fn;
+  void    *closure;
+  uint64_t grain;
+};
+
+static PoolState *pool = nullptr;
+static thread_local int pool_busy = 0; // set while this thread executes loop bodies
+static std::atomic<int> pool_owned(0); // one thread drives the pool at a time
+
+static bool PoolTakeOwn(int me,uint64_t &b,uint64_t &e)
+{
+  PoolRange &r = pool->ranges[me];
+  bool got = false;
+  r.Lock();
+  uint64_t rb = r.begin.load(std::memory_order_relaxed);
+  uint64_t re = r.end.load(std::memory_order_relaxed);
+  if ( rb < re ) {
+    b = rb;
+    e = std::min(rb+pool->grain,re);
+    r.begin.store(e,std::memory_order_relaxed);
+    got = true;
+  }
+  r.Unlock();
+  return got;
+}
+
+static bool PoolSteal(int me)
+{
+  int nthreads = pool->nthreads;
+  while(1) {
+    // Victim with the most work left; the scan is advisory, re-checked under lock
+    int victim = -1;
+    uint64_t most = 0;
+    for(int t=0;t<nthreads;t++){
+      if ( t==me ) continue;
+      uint64_t rem = pool->ranges[t].Remaining();
+      if ( rem > most ) { most = rem; victim = t; }
+    }
+    if ( victim < 0 ) return false;
+
+    PoolRange &v = pool->ranges[victim];
+    uint64_t sb=0,se=0;
+    v.Lock();
+    uint64_t vb = v.begin.load(std::memory_order_relaxed);
+    uint64_t ve = v.end.load(std::memory_order_relaxed);
+    if ( vb < ve ) {
+      uint64_t rem = ve-vb;
+      sb = (rem > pool->grain) ? vb + rem/2 : vb;
+      se = ve;
+      v.end.store(sb,std::memory_order_relaxed);
+    }
+    v.Unlock();
+
+    if ( se > sb ) {
+      PoolRange &r = pool->ranges[me];
+      r.Lock();
+      r.begin.store(sb,std::memory_order_relaxed);
+      r.end.store(se,std::memory_order_relaxed);
+      r.Unlock();
+      return true;
+    }
+  }
+}
+
+static void PoolWork(int me)
+{
+  uint64_t b,e;
+  pool_busy = 1;
+  do {
+    while ( PoolTakeOwn(me,b,e) ) {
+      pool->fn(pool->closure,b,e);
+    }
+  } while ( PoolSteal(me) );
+  pool_busy = 0;
+}
+
+static void PoolWorker(int me)
+{
+  uint64_t seen = 0;
+  while(1) {
+    int spins = 0;
+    while ( (pool->generation.load(std::memory_order_acquire) == seen) && !pool->shutdown.load() ) {
+      if ( ++spins < GRID_POOL_SPIN ) {
+	PoolRelax();
+      } else {
+	std::unique_lock<std::mutex> lock(pool->mutex);
+	pool->wake.wait(lock,[&]{ return (pool->generation.load() != seen) || pool->shutdown.load(); });
+      }
+    }
+    if ( pool->shutdown.load() ) return;
+    seen = pool->generation.load(std::memory_order_acquire);
+    PoolWork(me);
+    pool->departed.fetch_add(1,std::memory_order_release);
+  }
+}
+
+static void PoolStart(int nthreads)
+{
+  GridThreadPool::Shutdown();
+  pool = new PoolState;
+  pool->nthreads = nthreads;
+  pool->ranges.reset(new PoolRange[nthreads]);
+  for(int t=0;t<nthreads;t++){
+    pool->ranges[t].begin = 0;
+    pool->ranges[t].end   = 0;
+  }
+  pool->generation = 0;
+  pool->departed   = 0;
+  pool->shutdown   = 0;
+  // Calling thread is worker 0
+  for(int t=1;t<nthreads;t++){
+    pool->workers.push_back(std::thread(PoolWorker,t));
+  }
+}
+
+int GridThreadPool::Threads(void)
+{
+  return GridThread::GetThreads();
+}
+
+void GridThreadPool::SerialThread(void)
+{
+  pool_busy = 1;
+}
+
+bool GridThreadPool::Inline(uint64_t num)
+{
+  if ( pool_busy ) return true;
+  if ( num == 1 ) return true;
+  if ( Threads() <= 1 ) return true;
+#ifdef GRID_OMP
+  if ( omp_in_parallel() ) return true;
+#endif
+  return false;
+}
+
+void GridThreadPool::Run(uint64_t num,RangeFunction fn,void *closure)
+{
+  ////////////////////////////////////////////////////
+  // A second thread issuing a loop while the pool is
+  // driven by another runs it inline instead
+  ////////////////////////////////////////////////////
+  if ( pool_owned.exchange(1,std::memory_order_acquire) ) {
+    int busy = pool_busy;
+    pool_busy = 1;
+    fn(closure,0,num);
+    pool_busy = busy;
+    return;
+  }
+
+  int nthreads = Threads();
+  if ( (pool == nullptr) || (pool->nthreads != nthreads) ) PoolStart(nthreads);
+
+  ////////////////////////////////////////////////////
+  // Static initial split; every worker has left the
+  // previous loop so the ranges are ours to write
+  ////////////////////////////////////////////////////
+  uint64_t grain = num/(nthreads*GrainsPerThread);
+  pool->grain    = std::max(grain,MinGrain);
+  pool->fn       = fn;
+  pool->closure  = closure;
+  for(int t=0;t<nthreads;t++){
+    pool->ranges[t].begin.store((num*t)/nthreads,std::memory_order_relaxed);
+    pool->ranges[t].end.store((num*(t+1))/nthreads,std::memory_order_relaxed);
+  }
+  pool->departed.store(0,std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    pool->generation.fetch_add(1,std::memory_order_release);
+  }
+  pool->wake.notify_all();
+
+  PoolWork(0);
+
+  while ( pool->departed.load(std::memory_order_acquire) < nthreads-1 ) PoolRelax();
+
+  pool_owned.store(0,std::memory_order_release);
+}
+
+void GridThreadPool::Shutdown(void)
+{
+  if ( pool == nullptr ) return;
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    pool->shutdown.store(1);
+  }
+  pool->wake.notify_all();
+  for(int t=0;t<pool->workers.size();t++){
+    pool->workers[t].join();
+  }
+  delete pool;
+  pool = nullptr;
+}
+
+NAMESPACE_END(Grid);
+
+#endif
@@ -0,0 +1,90 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/threads/ThreadPool.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////////////
+// Persistent worker threads with range stealing; backs thread_for when
+// configured with --enable-work-stealing.
+//
+// Each loop is first cut into one contiguous block per worker, as
+// schedule(static) would, so first touch placement is unchanged. A worker
+// eats its own block grain by grain from the front; when it runs dry it
+// steals the back half of the largest remaining block. Uneven surface lists
+// and planes are then rebalanced without a fresh fork-join.
+//
+// A thread_for issued from inside a worker, from inside an OpenMP
+// parallel region, or from a second thread while another drives the
+// pool, runs inline on the calling thread.
+//////////////////////////////////////////////////////////////////////////////////
+class GridThreadPool {
+public:
+  typedef void (*RangeFunction)(void *closure,uint64_t begin,uint64_t end);
+
+  template<class Lambda>
+  static void ForRange(uint64_t num,Lambda &&body)
+  {
+    if ( num == 0 ) return;
+    if ( Inline(num) ) {
+      body((uint64_t)0,num);
+      return;
+    }
+    typedef typename std::remove_reference<Lambda>::type LambdaType;
+    Run(num,&Trampoline<LambdaType>,(void *)&body);
+  }
+
+  static int  Threads(void);
+  static void Shutdown(void);
+
+  // Loops issued from the calling thread run inline from now on; for
+  // helper threads that work alongside the thread driving the pool
+  static void SerialThread(void);
+
+  ////////////////////////////////////////////////////////
+  // Minimum iterations handed out at once, and the number
+  // of grains each worker's static block is cut into
+  ////////////////////////////////////////////////////////
+  static uint64_t MinGrain;
+  static uint64_t GrainsPerThread;
+
+private:
+  template<class LambdaType>
+  static void Trampoline(void *closure,uint64_t begin,uint64_t end)
+  {
+    (*(LambdaType *)closure)(begin,end);
+  }
+  static bool Inline(uint64_t num);
+  static void Run(uint64_t num,RangeFunction fn,void *closure);
+};
+
+NAMESPACE_END(Grid);
+
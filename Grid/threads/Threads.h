@@ -57,6 +57,7 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 #define thread_max(a) (1)
 #endif
 
+#ifndef GRID_WORK_STEALING
 #define thread_for( i, num, ... )                           DO_PRAGMA(omp parallel for schedule(static)) for ( uint64_t i=0;i<num;i++) { __VA_ARGS__ } ;
 #define thread_for2d( i1, n1,i2,n2, ... )  \
   DO_PRAGMA(omp parallel for collapse(2))  \
@@ -65,9 +66,39 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
   { __VA_ARGS__ } ;			   \
   }}
 #define thread_foreach( i, container, ... )                 DO_PRAGMA(omp parallel for schedule(static)) for ( uint64_t i=container.begin();i<container.end();i++) { __VA_ARGS__ } ;
-#define thread_for_in_region( i, num, ... )                 DO_PRAGMA(omp for schedule(static))          for ( uint64_t i=0;i<num;i++) { __VA_ARGS__ } ;
 #define thread_for_collapse2( i, num, ... )                 DO_PRAGMA(omp parallel for collapse(2))      for ( uint64_t i=0;i<num;i++) { __VA_ARGS__ } ;
 #define thread_for_collapse( N , i, num, ... )              DO_PRAGMA(omp parallel for collapse ( N ) )  for ( uint64_t i=0;i<num;i++) { __VA_ARGS__ } ;
+#else
+//////////////////////////////////////////////////////////////////////////////////
+// Work stealing pool (threads/ThreadPool.h). Loop bodies stay inside a real for
+// so "continue" keeps its meaning; collapsed loops parallelise the outer index.
+//////////////////////////////////////////////////////////////////////////////////
+#define thread_for( i, num, ... )					\
+  Grid::GridThreadPool::ForRange((uint64_t)(num),[&](uint64_t __ws_b,uint64_t __ws_e) { \
+    for ( uint64_t i=__ws_b;i<__ws_e;i++) { __VA_ARGS__ } ;		\
+  });
+#define thread_for2d( i1, n1,i2,n2, ... )				\
+  {									\
+    uint64_t __ws_n2 = (n2);						\
+    Grid::GridThreadPool::ForRange((uint64_t)(n1)*__ws_n2,[&](uint64_t __ws_b,uint64_t __ws_e) { \
+      for ( uint64_t __ws_i=__ws_b;__ws_i<__ws_e;__ws_i++) {		\
+	uint64_t i1 = __ws_i/__ws_n2;					\
+	uint64_t i2 = __ws_i%__ws_n2;					\
+	{ __VA_ARGS__ } ;						\
+      }									\
+    });									\
+  }
+#define thread_foreach( i, container, ... )				\
+  {									\
+    uint64_t __ws_o = container.begin();				\
+    Grid::GridThreadPool::ForRange((uint64_t)(container.end()-__ws_o),[&](uint64_t __ws_b,uint64_t __ws_e) { \
+      for ( uint64_t i=__ws_o+__ws_b;i<__ws_o+__ws_e;i++) { __VA_ARGS__ } ; \
+    });									\
+  }
+#define thread_for_collapse2( i, num, ... )                 thread_for( i, num, __VA_ARGS__ )
+#define thread_for_collapse( N , i, num, ... )              thread_for( i, num, __VA_ARGS__ )
+#endif
+#define thread_for_in_region( i, num, ... )                 DO_PRAGMA(omp for schedule(static))          for ( uint64_t i=0;i<num;i++) { __VA_ARGS__ } ;
 #define thread_for_collapse_in_region( N , i, num, ... )    DO_PRAGMA(omp for collapse ( N ))            for ( uint64_t i=0;i<num;i++) { __VA_ARGS__ } ;
 #define thread_region                                       DO_PRAGMA(omp parallel)
 #define thread_critical                                     DO_PRAGMA(omp critical)
@@ -313,6 +313,22 @@ void Grid_init(int *argc,char ***argv)
     GlobalSharedMemory::Hugepages = 1;
   }
 
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--alloc-hugepages") ){
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--alloc-hugepages");
+    if      ( arg == "thp" ) MemoryManager::PagePolicy = PagesTransparent;
+    else if ( arg == "2MB" ) MemoryManager::PagePolicy = PagesHuge2MB;
+    else if ( arg == "1GB" ) MemoryManager::PagePolicy = PagesHuge1GB;
+    else if ( arg == "none") MemoryManager::PagePolicy = PagesDefault;
+    else {
+      std::cout << "--alloc-hugepages expects thp|2MB|1GB|none" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--alloc-first-touch") ){
+    MemoryManager::FirstTouch = 1;
+  }
+
 
   if( GridCmdOptionExists(*argv,*argv+*argc,"--debug-signals") ){
     Grid_debug_handler_init();
@@ -379,6 +395,11 @@ void Grid_init(int *argc,char ***argv)
 
   MemoryManager::InitMessage();
 
+#ifdef GRID_WORK_STEALING
+  std::cout << GridLogMessage << "thread_for/accelerator_for run on a "<<GridThread::GetThreads()
+	    <<" thread work stealing pool"<<std::endl;
+#endif
+
   if( GridCmdOptionExists(*argv,*argv+*argc,"--debug-mem") ){
     MemoryProfiler::debug = true;
     MemoryProfiler::stats = &dbgMemStats;
@@ -413,6 +434,8 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<"  --grid n.n.n.n  : default Grid size"<<std::endl;
     std::cout<<GridLogMessage<<"  --shm  M        : allocate M megabytes of shared memory for comms"<<std::endl;
     std::cout<<GridLogMessage<<"  --shm-hugepages : use explicit huge pages in mmap call "<<std::endl;    
+    std::cout<<GridLogMessage<<"  --alloc-hugepages thp|2MB|1GB : back large lattice fields with huge pages"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --alloc-first-touch : fault in fresh fields under thread_for for NUMA locality"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"Verbose and debug:"<<std::endl;
     std::cout<<GridLogMessage<<std::endl;
@@ -428,14 +451,21 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<"  --comms-concurrent : Asynchronous MPI calls; several dirs at a time "<<std::endl;    
     std::cout<<GridLogMessage<<"  --comms-sequential : Synchronous MPI calls; one dirs at a time "<<std::endl;    
     std::cout<<GridLogMessage<<"  --comms-overlap    : Overlap comms with compute "<<std::endl;    
+    std::cout<<GridLogMessage<<"  --comms-flat-reductions : one MPI_Allreduce over all ranks, not on node then between nodes"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --dslash-generic: Wilson kernel for generic Nc"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-unroll : Wilson kernel for Nc=3"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-asm    : Wilson kernel for AVX512"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-fuse-clover : apply the inverse clover term inside the Wilson kernel of the Schur operators"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-fuse-cayley : apply the 5d Cayley matrices inside the Wilson kernel of the Schur operators"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --lebesgue      : Cache oblivious Lebesgue curve/Morton order/Z-graph stencil looping"<<std::endl;    
     std::cout<<GridLogMessage<<"  --cacheblocking n.m.o.p : Hypercuboidal cache blocking"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --io-mmap       : read lattice files through mmap (node local or single node files)"<<std::endl;    
+    std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --reproducible-sums : global sums bitwise independent of threads, SIMD and MPI layout (slower)"<<std::endl;    
+    std::cout<<GridLogMessage<<std::endl;
     exit(EXIT_SUCCESS);
   }
 
@@ -455,6 +485,12 @@ void Grid_init(int *argc,char ***argv)
     WilsonKernelsStatic::Opt=WilsonKernelsStatic::OptGeneric;
     StaggeredKernelsStatic::Opt=StaggeredKernelsStatic::OptGeneric;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-fuse-clover") ){
+    WilsonKernelsStatic::FuseClover=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-fuse-cayley") ){
+    WilsonKernelsStatic::FuseCayley=1;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-overlap") ){
     WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
     StaggeredKernelsStatic::Comms = StaggeredKernelsStatic::CommsAndCompute;
@@ -468,10 +504,19 @@ void Grid_init(int *argc,char ***argv)
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-sequential") ){
     CartesianCommunicator::SetCommunicatorPolicy(CartesianCommunicator::CommunicatorPolicySequential);
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-flat-reductions") ){
+    CartesianCommunicator::NodeAwareReductions = 0;
+  }
 
   if( GridCmdOptionExists(*argv,*argv+*argc,"--lebesgue") ){
     LebesgueOrder::UseLebesgueOrder=1;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-mmap") ){
+    BinaryIO::mmapRead=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--reproducible-sums") ){
+    ReproducibleSum::Enabled=1;
+  }
   CartesianCommunicator::nCommThreads = 1;
 #ifdef GRID_COMMS_THREADS  
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-threads") ){
@@ -510,6 +555,10 @@ void Grid_init(int *argc,char ***argv)
 
 void Grid_finalize(void)
 {
+  if ( MemoryProfiler::debug ) MemoryManager::PrintCacheStats();
+#ifdef GRID_WORK_STEALING
+  GridThreadPool::Shutdown();
+#endif
 #if defined (GRID_COMMS_MPI) || defined (GRID_COMMS_MPI3) || defined (GRID_COMMS_MPIT)
   MPI_Finalize();
   Grid_unquiesce_nodes();
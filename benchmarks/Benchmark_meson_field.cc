@@ -770,6 +770,16 @@ int main (int argc, char ** argv)
   std::cout<<GridLogMessage << "Done "<< flops/(t1-t0) <<" mflops " <<std::endl;
   std::cout<<GridLogMessage << "Done "<< byte /(t1-t0) <<" MB/s " <<std::endl;
 
+  std::cout<<GridLogMessage << "Running A2Autils::MesonField sixteen gammas "<<Nmom<<" momenta "<<std::endl;
+  Eigen::Tensor<ComplexD,5> A2Amat(Nmom,16,nt,Nm,Nm);
+  double t_kernel, t_gsum;
+  t0 = usecond();
+  A2Autils<WilsonImplR>::MesonField(A2Amat,&w[0],&v[0],Gmu16,phases,Tp,&t_kernel,&t_gsum);
+  t1 = usecond();
+  std::cout<<GridLogMessage << "Done "<< (t1-t0) <<" usecond (kernel "<<t_kernel<<" usecond)" <<std::endl;
+  std::cout<<GridLogMessage << "Done "<< flops/(t1-t0) <<" mflops " <<std::endl;
+  std::cout<<GridLogMessage << "Done "<< byte /(t1-t0) <<" MB/s " <<std::endl;
+
 
 
   RealD err = 0;
@@ -151,6 +151,17 @@ int main (int argc, char ** argv)
     BENCH_DW(Mooee   ,src_o,r_o);
     BENCH_DW(MooeeInv,src_o,r_o);
 
+    // Schur operator blocks: separate passes, then the fused Ls column kernel
+    LatticeFermion r_tmp(FrbGrid);
+    int fuse_save = WilsonKernelsStatic::FuseCayley;
+    WilsonKernelsStatic::FuseCayley = 0;
+    BENCH_DW(MooeeInvMeooe      ,src_o,r_e,r_tmp);
+    BENCH_DW(MooeeInvDagMeooeDag,src_o,r_e,r_tmp);
+    WilsonKernelsStatic::FuseCayley = 1;
+    BENCH_DW(MooeeInvMeooe      ,src_o,r_e,r_tmp);
+    BENCH_DW(MooeeInvDagMeooeDag,src_o,r_e,r_tmp);
+    WilsonKernelsStatic::FuseCayley = fuse_save;
+
   }
 
   Grid_finalize();
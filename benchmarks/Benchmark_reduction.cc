@@ -0,0 +1,82 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./benchmarks/Benchmark_reduction.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  int threads = GridThread::GetThreads();
+  std::cout<<GridLogMessage << "Grid is setup to use "<<threads<<" threads"<<std::endl;
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking norm2 and innerProduct ; floating point vs reproducible (--reproducible-sums) sums"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "  L  "<<"\t\t"<<"bytes"<<"\t\t"<<"norm2 GB/s"<<"\t"<<"repro GB/s"<<"\t"<<"innerProduct GB/s"<<"\t"<<"repro GB/s"<<std::endl;
+  std::cout<<GridLogMessage << "----------------------------------------------------------"<<std::endl;
+  uint64_t lmax=32;
+  for(int lat=8;lat<=lmax;lat+=8){
+
+    Coordinate latt_size  ({lat*mpi_layout[0],lat*mpi_layout[1],lat*mpi_layout[2],lat*mpi_layout[3]});
+    int64_t vol= latt_size[0]*latt_size[1]*latt_size[2]*latt_size[3];
+    GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+
+    uint64_t Nloop=20*lmax*lmax*lmax*lmax/vol;
+
+    GridParallelRNG          pRNG(&Grid);      pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+    LatticeFermionD x(&Grid); gaussian(pRNG,x);
+    LatticeFermionD y(&Grid); gaussian(pRNG,y);
+
+    double bytes = vol*sizeof(SpinColourVectorD);
+    double gbs[4];
+    RealD nrm[2]; ComplexD ip[2];
+    for(int repro=0;repro<2;repro++){
+      ReproducibleSum::Enabled = repro;
+      nrm[repro] = norm2(x);
+      double start=usecond();
+      for(int i=0;i<Nloop;i++) nrm[repro] = norm2(x);
+      double stop=usecond();
+      gbs[repro] = Nloop*bytes/(stop-start)/1000.;
+
+      ip[repro] = innerProduct(x,y);
+      start=usecond();
+      for(int i=0;i<Nloop;i++) ip[repro] = innerProduct(x,y);
+      stop=usecond();
+      gbs[2+repro] = 2*Nloop*bytes/(stop-start)/1000.;
+    }
+    ReproducibleSum::Enabled = 0;
+
+    std::cout<<GridLogMessage<<std::setprecision(3) << lat<<"\t\t"<<bytes<<"   \t\t"<<gbs[0]<<"\t\t"<<gbs[1]<<"\t\t"<<gbs[2]<<"\t\t\t"<<gbs[3]
+	     <<"\t\t rel. diff "<<std::abs(nrm[1]-nrm[0])/nrm[1]<<std::endl;
+  }
+
+  Grid_finalize();
+}
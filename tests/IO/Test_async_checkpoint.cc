@@ -0,0 +1,159 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_async_checkpoint.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Checkpointer>
+void CheckRestore(Checkpointer &ckpt,int traj,LatticeGaugeField &Usnap,
+		  GridSerialRNG &sRNGsnap,GridParallelRNG &pRNGsnap)
+{
+  GridBase *grid = Usnap.Grid();
+  LatticeGaugeField Ur(grid);
+  GridParallelRNG   pRNGr(grid);
+  GridSerialRNG     sRNGr;
+
+  ckpt.CheckpointRestore(traj,Ur,sRNGr,pRNGr);
+
+  LatticeGaugeField diff(grid);
+  diff = Ur - Usnap;
+  std::cout << GridLogMessage << " restored gauge field difference " << norm2(diff) << std::endl;
+  assert(norm2(diff) == 0.0);
+
+  LatticeComplex ra(grid); random(pRNGsnap,ra);
+  LatticeComplex rb(grid); random(pRNGr,rb);
+  ra = ra - rb;
+  ComplexD a,b;
+  random(sRNGsnap,a);
+  random(sRNGr,b);
+  std::cout << GridLogMessage << " restored RNG differences " << norm2(ra) << " " << abs(a-b) << std::endl;
+  assert(norm2(ra) == 0.0);
+  assert(a == b);
+}
+
+std::vector<char> FileBytes(std::string file,uint64_t skip)
+{
+  std::ifstream fin(file,std::ios::binary);
+  std::vector<char> bytes((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+  bytes.erase(bytes.begin(),bytes.begin()+std::min<uint64_t>(skip,bytes.size()));
+  return bytes;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(seeds);
+  GridSerialRNG   sRNG;       sRNG.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField U(grid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+
+  const int traj = 10;
+
+  ////////////////////////////////////////////////////////////////
+  // Parameter files written before async existed still read
+  ////////////////////////////////////////////////////////////////
+  {
+    std::string xml("<?xml version=\"1.0\"?>\n<grid><Checkpointer>"
+		    "<config_prefix>ckpoint_lat</config_prefix><rng_prefix>ckpoint_rng</rng_prefix>"
+		    "<saveInterval>5</saveInterval><format>IEEE64BIG</format>"
+		    "</Checkpointer></grid>");
+    XmlReader RD(xml,true);
+    CheckpointerParameters Par(RD);
+    assert(Par.config_prefix=="ckpoint_lat" && Par.rng_prefix=="ckpoint_rng");
+    assert(Par.saveInterval==5 && Par.format=="IEEE64BIG");
+    assert(Par.async==false);
+    std::cout << GridLogMessage << "Checkpointer parameters without async read" << std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Nersc: snapshot is written while U and the RNGs move on
+  ////////////////////////////////////////////////////////////////
+  {
+    CheckpointerParameters SyncPar ("ckpoint_sync_lat" ,"ckpoint_sync_rng" ,1,"IEEE64BIG",false);
+    CheckpointerParameters AsyncPar("ckpoint_async_lat","ckpoint_async_rng",1,"IEEE64BIG",true);
+    NerscHmcCheckpointer<PeriodicGimplR> Sync(SyncPar);
+    NerscHmcCheckpointer<PeriodicGimplR> Async(AsyncPar);
+
+    LatticeGaugeField Usnap(U);
+    GridParallelRNG   pRNGsnap(pRNG);
+    GridSerialRNG     sRNGsnap(sRNG);
+
+    std::cout << GridLogMessage << "Nersc synchronous checkpoint" << std::endl;
+    Sync.TrajectoryComplete(traj,U,sRNG,pRNG);
+
+    std::cout << GridLogMessage << "Nersc asynchronous checkpoint" << std::endl;
+    Async.TrajectoryComplete(traj,U,sRNG,pRNG);
+    SU<Nc>::HotConfiguration(pRNG,U);   // next "trajectory"
+    Async.EvolutionComplete();
+
+    FieldMetaData hs, ha;
+    NerscIO::readHeader("ckpoint_sync_lat.10" ,grid,hs);
+    NerscIO::readHeader("ckpoint_async_lat.10",grid,ha);
+    std::cout << GridLogMessage << " checksums sync " << std::hex << hs.checksum
+	      << " async " << ha.checksum << std::dec << std::endl;
+    assert(hs.checksum == ha.checksum);
+    assert(FileBytes("ckpoint_sync_lat.10",hs.data_start) == FileBytes("ckpoint_async_lat.10",ha.data_start));
+
+    CheckRestore(Async,traj,Usnap,sRNGsnap,pRNGsnap);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Binary: two checkpoints back to back, the second waits on the first
+  ////////////////////////////////////////////////////////////////
+  {
+    CheckpointerParameters SyncPar ("ckpoint_sync_bin" ,"ckpoint_sync_binrng" ,1,"IEEE64BIG",false);
+    CheckpointerParameters AsyncPar("ckpoint_async_bin","ckpoint_async_binrng",1,"IEEE64BIG",true);
+    BinaryHmcCheckpointer<PeriodicGimplR> Sync(SyncPar);
+    BinaryHmcCheckpointer<PeriodicGimplR> Async(AsyncPar);
+
+    LatticeGaugeField Usnap(U);
+    GridParallelRNG   pRNGsnap(pRNG);
+    GridSerialRNG     sRNGsnap(sRNG);
+
+    Sync.TrajectoryComplete(traj,U,sRNG,pRNG);
+    Async.TrajectoryComplete(traj,U,sRNG,pRNG);
+    SU<Nc>::HotConfiguration(pRNG,U);
+    Async.TrajectoryComplete(traj+1,U,sRNG,pRNG);
+    Async.EvolutionComplete();
+
+    assert(FileBytes("ckpoint_sync_bin.10"   ,0) == FileBytes("ckpoint_async_bin.10"   ,0));
+    assert(FileBytes("ckpoint_sync_binrng.10",0) == FileBytes("ckpoint_async_binrng.10",0));
+
+    CheckRestore(Async,traj,Usnap,sRNGsnap,pRNGsnap);
+  }
+
+  std::cout << GridLogMessage << "Async checkpoints agree with synchronous" << std::endl;
+
+  Grid_finalize();
+}
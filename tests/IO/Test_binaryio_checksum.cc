@@ -0,0 +1,164 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binaryio_checksum.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  ////////////////////////////////////////////////////////////////
+  // Sliced CRC against zlib, all lengths and alignments
+  ////////////////////////////////////////////////////////////////
+  {
+    std::vector<unsigned char> buf(4096+8);
+    uint32_t seed = 12345;
+    for(auto &b : buf) { seed = seed*1103515245+12345; b = seed>>16; }
+    for(int align=0;align<8;align++){
+      for(int len=0;len<=4096;len+=(len<64 ? 1 : 61)){
+	uint32_t ref = crc32(0,&buf[align],len);
+	uint32_t crc = BinaryIO::Crc32(0,&buf[align],len);
+	assert(ref == crc);
+      }
+    }
+    // chaining
+    uint32_t ref = crc32(0,&buf[0],4096);
+    uint32_t crc = BinaryIO::Crc32(BinaryIO::Crc32(0,&buf[0],1001),&buf[1001],4096-1001);
+    assert(ref == crc);
+    std::cout << GridLogMessage << "Crc32 agrees with zlib crc32" << std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Fused encode/decode against the separate passes of IOobject
+  ////////////////////////////////////////////////////////////////
+  typedef LorentzColourMatrixD sobj;
+  typedef LorentzColourMatrixF fobjF;
+
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  LatticeGaugeField U(grid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+
+  uint64_t lsites = grid->lSites();
+  std::vector<sobj> scalardata(lsites);
+  unvectorizeToLexOrdArray(scalardata,U);
+
+  std::vector<std::string> formats({"IEEE64BIG","IEEE64","IEEE32BIG","IEEE32"});
+  for(auto format : formats){
+    int is32 = (format.find("32") != std::string::npos);
+    uint32_t n,a,b, nr,ar,br;
+
+    if ( is32 ) {
+      BinarySimpleUnmunger<fobjF,sobj> unmunge;
+      BinarySimpleMunger<fobjF,sobj>   munge;
+      std::vector<fobjF> ref(lsites), iodata(lsites);
+      for(uint64_t x=0;x<lsites;x++) unmunge(scalardata[x],ref[x]);
+      nr=ar=br=0;
+      BinaryIO::NerscChecksum(grid,ref,nr);
+      if ( format=="IEEE32BIG" ) BinaryIO::htobe32_v((void *)&ref[0],sizeof(fobjF)*lsites);
+      else                       BinaryIO::htole32_v((void *)&ref[0],sizeof(fobjF)*lsites);
+      BinaryIO::ScidacChecksum(grid,ref,ar,br);
+
+      BinaryIO::encodeSites(grid,scalardata,iodata,unmunge,format,n,a,b);
+      assert(memcmp(&ref[0],&iodata[0],sizeof(fobjF)*lsites)==0);
+      assert(n==nr && a==ar && b==br);
+
+      std::vector<sobj> back(lsites);
+      uint32_t nd,ad,bd;
+      BinaryIO::decodeSites(grid,iodata,back,munge,format,nd,ad,bd);
+      assert(n==nd && a==ad && b==bd);
+      for(uint64_t x=0;x<lsites;x++) assert(norm2(back[x]-scalardata[x]) < 1.0e-10);
+    } else {
+      BinarySimpleUnmunger<sobj,sobj> unmunge;
+      BinarySimpleMunger<sobj,sobj>   munge;
+      std::vector<sobj> ref(scalardata), iodata(lsites);
+      nr=ar=br=0;
+      BinaryIO::NerscChecksum(grid,ref,nr);
+      if ( format=="IEEE64BIG" ) BinaryIO::htobe64_v((void *)&ref[0],sizeof(sobj)*lsites);
+      else                       BinaryIO::htole64_v((void *)&ref[0],sizeof(sobj)*lsites);
+      BinaryIO::ScidacChecksum(grid,ref,ar,br);
+
+      BinaryIO::encodeSites(grid,scalardata,iodata,unmunge,format,n,a,b);
+      assert(memcmp(&ref[0],&iodata[0],sizeof(sobj)*lsites)==0);
+      assert(n==nr && a==ar && b==br);
+
+      std::vector<sobj> back(lsites);
+      uint32_t nd,ad,bd;
+      BinaryIO::decodeSites(grid,iodata,back,munge,format,nd,ad,bd);
+      assert(n==nd && a==ad && b==bd);
+      assert(memcmp(&back[0],&scalardata[0],sizeof(sobj)*lsites)==0);
+    }
+    std::cout << GridLogMessage << format << " fused pass checksums " << std::hex
+	      << n << " " << a << " " << b << std::dec << " agree" << std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Round trip through the file
+  ////////////////////////////////////////////////////////////////
+  {
+    std::string file("./ckpoint_checksum_lat");
+    BinarySimpleUnmunger<sobj,sobj> unmunge;
+    BinarySimpleMunger<sobj,sobj>   munge;
+    uint32_t nw,aw,bw, nr,ar,br;
+    { std::ofstream fout(file,std::ios::out); }
+    BinaryIO::writeLatticeObject<vLorentzColourMatrixD,sobj>(U,file,unmunge,0,"IEEE64BIG",nw,aw,bw);
+    LatticeGaugeField Ur(grid);
+    BinaryIO::readLatticeObject<vLorentzColourMatrixD,sobj>(Ur,file,munge,0,"IEEE64BIG",nr,ar,br);
+    assert(nw==nr && aw==ar && bw==br);
+    Ur = Ur - U;
+    assert(norm2(Ur) == 0.0);
+    std::cout << GridLogMessage << "write/read round trip agrees" << std::endl;
+
+    // Zero copy read through mmap, behind a header sized offset
+    uint64_t offset = 4099;
+    {
+      std::ofstream fout(file,std::ios::out);
+      fout << std::string(offset,'#');
+    }
+    BinarySimpleUnmunger<fobjF,sobj> unmungeF;
+    BinarySimpleMunger<fobjF,sobj>   mungeF;
+    BinaryIO::writeLatticeObject<vLorentzColourMatrixD,fobjF>(U,file,unmungeF,offset,"IEEE32BIG",nw,aw,bw);
+    LatticeGaugeField Ustream(grid);
+    LatticeGaugeField Umapped(grid);
+    BinaryIO::mmapRead = 0;
+    BinaryIO::readLatticeObject<vLorentzColourMatrixD,fobjF>(Ustream,file,mungeF,offset,"IEEE32BIG",nr,ar,br);
+    assert(nw==nr && aw==ar && bw==br);
+    BinaryIO::mmapRead = 1;
+    BinaryIO::readLatticeObject<vLorentzColourMatrixD,fobjF>(Umapped,file,mungeF,offset,"IEEE32BIG",nr,ar,br);
+    BinaryIO::mmapRead = 0;
+    assert(nw==nr && aw==ar && bw==br);
+    Ur = Umapped - Ustream;
+    assert(norm2(Ur) == 0.0);
+    std::cout << GridLogMessage << "mmap read agrees" << std::endl;
+  }
+
+  Grid_finalize();
+}
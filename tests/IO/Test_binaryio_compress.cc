@@ -0,0 +1,191 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binaryio_compress.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  LatticeGaugeField U(grid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+  LatticeSpinColourVector psi(grid);
+  gaussian(pRNG,psi);
+
+  typedef LorentzColourMatrixD gobj;
+  typedef SpinColourVectorD    fobjD;
+  typedef SpinColourVectorF    fobjF;
+  std::string file("./ckpoint_compress");
+
+  ////////////////////////////////////////////////////////////////
+  // Lossless: exact, and the checksums of the uncompressed record
+  ////////////////////////////////////////////////////////////////
+  for(int block_sites : std::vector<int>({4096,333})){
+    BinarySimpleUnmunger<gobj,gobj> unmunge;
+    BinarySimpleMunger<gobj,gobj>   munge;
+    uint32_t nb,ab,bb, nw,aw,bw, nr,ar,br;
+    { std::ofstream fout(file,std::ios::out); }
+    BinaryIO::writeLatticeObject<vLorentzColourMatrixD,gobj>(U,file,unmunge,0,"IEEE64BIG",nb,ab,bb);
+
+    BinaryIOCompressionParameters par("shuffle-deflate",0,1,block_sites);
+    BinaryIOCompressedRecord record;
+    uint64_t offset = 17;
+    { std::ofstream fout(file,std::ios::out); fout << std::string(offset,'#'); }
+    BinaryIOCompress::writeLatticeObject<vLorentzColourMatrixD,gobj>(U,file,unmunge,offset,"IEEE64BIG",par,record,nw,aw,bw);
+    assert(nw==nb && aw==ab && bw==bb);
+    assert(record.bytes < record.uncompressed_bytes);
+
+    // The record travels as XML
+    XmlWriter WR("","");
+    write(WR,record.SerialisableClassName(),record);
+    XmlReader RD(WR.docString(),true,"");
+    BinaryIOCompressedRecord reread;
+    read(RD,record.SerialisableClassName(),reread);
+    assert(reread == record);
+
+    LatticeGaugeField Ur(grid);
+    BinaryIOCompress::readLatticeObject<vLorentzColourMatrixD,gobj>(Ur,file,munge,offset,reread,nr,ar,br);
+    assert(nw==nr && aw==ar && bw==br);
+    Ur = Ur - U;
+    assert(norm2(Ur) == 0.0);
+    std::cout << GridLogMessage << "lossless, blocks of " << block_sites << " sites: ratio "
+	      << (double)record.uncompressed_bytes/record.bytes << ", exact" << std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Error bounded, double and single precision words
+  ////////////////////////////////////////////////////////////////
+  for(int bits : std::vector<int>({10,16})){
+    uint32_t nw,aw,bw, nr,ar,br;
+    { std::ofstream fout(file,std::ios::out); }
+    BinaryIOCompressionParameters par("truncate-shuffle-deflate",bits);
+    BinaryIOCompressedRecord record;
+
+    BinarySimpleUnmunger<fobjD,fobjD> unmungeD;
+    BinarySimpleMunger<fobjD,fobjD>   mungeD;
+    BinaryIOCompress::writeLatticeObject<vSpinColourVectorD,fobjD>(psi,file,unmungeD,0,"IEEE64BIG",par,record,nw,aw,bw);
+    LatticeSpinColourVector psiD(grid);
+    BinaryIOCompress::readLatticeObject<vSpinColourVectorD,fobjD>(psiD,file,mungeD,0,record,nr,ar,br);
+    assert(nw==nr && aw==ar && bw==br);
+
+    BinarySimpleUnmunger<fobjF,fobjD> unmungeF;
+    BinarySimpleMunger<fobjF,fobjD>   mungeF;
+    BinaryIOCompress::writeLatticeObject<vSpinColourVectorD,fobjF>(psi,file,unmungeF,0,"IEEE32BIG",par,record,nw,aw,bw);
+    LatticeSpinColourVector psiF(grid);
+    BinaryIOCompress::readLatticeObject<vSpinColourVectorD,fobjF>(psiF,file,mungeF,0,record,nr,ar,br);
+    assert(nw==nr && aw==ar && bw==br);
+
+    // Every word within the bound (plus the float conversion for single)
+    std::vector<fobjD> ref(grid->lSites()), backD(grid->lSites()), backF(grid->lSites());
+    unvectorizeToLexOrdArray(ref,psi);
+    unvectorizeToLexOrdArray(backD,psiD);
+    unvectorizeToLexOrdArray(backF,psiF);
+    double *r = (double *)&ref[0];
+    double *d = (double *)&backD[0];
+    double *f = (double *)&backF[0];
+    double maxD = 0, maxF = 0;
+    for(uint64_t w=0;w<ref.size()*sizeof(fobjD)/sizeof(double);w++){
+      if ( r[w] == 0.0 ) continue;
+      maxD = std::max(maxD,std::fabs((d[w]-r[w])/r[w]));
+      maxF = std::max(maxF,std::fabs((f[w]-r[w])/r[w]));
+    }
+    std::cout << GridLogMessage << bits << " mantissa bits: bound " << record.error_bound
+	      << " max relative error double " << maxD << " single " << maxF
+	      << ", ratio " << (double)record.uncompressed_bytes/record.bytes << std::endl;
+    assert(maxD <= record.error_bound);
+    assert(maxF <= record.error_bound*(1.0+1.0e-6) + std::ldexp(1.0,-24));
+  }
+
+#ifdef HAVE_LIME
+  ////////////////////////////////////////////////////////////////
+  // Lime records: compression applies to the next record only.
+  // Skipping a compressed record must not make the raw one after
+  // it read as compressed.
+  ////////////////////////////////////////////////////////////////
+  {
+    std::string lfile("./ckpoint_compress.lime");
+    GridLimeWriter WR(grid->IsBoss());
+    WR.open(lfile);
+    WR.compression = BinaryIOCompressionParameters("shuffle-deflate");
+    WR.writeLimeLatticeBinaryObject(psi,std::string("grid-test-compressed"));
+    WR.compression = BinaryIOCompressionParameters();
+    WR.writeLimeLatticeBinaryObject(psi,std::string("grid-test-raw"));
+    WR.close();
+
+    for(auto name : std::vector<std::string>({"grid-test-raw","grid-test-compressed"})){
+      GridLimeReader RD;
+      RD.open(lfile);
+      LatticeSpinColourVector psir(grid);
+      RD.readLimeLatticeBinaryObject(psir,name);
+      RD.close();
+      psir = psir - psi;
+      std::cout << GridLogMessage << "lime record " << name << " difference " << norm2(psir) << std::endl;
+      assert(norm2(psir) == 0.0);
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // SciDAC field records, lossless then error bounded, in one file
+  ////////////////////////////////////////////////////////////////
+  {
+    std::string sfile("./ckpoint_compress.scidac");
+    emptyUserRecord record;
+    ScidacWriter SW(grid->IsBoss());
+    SW.open(sfile);
+    SW.writeScidacFileRecord(grid,record);
+    SW.compression = BinaryIOCompressionParameters("shuffle-deflate");
+    SW.writeScidacFieldRecord(U,record);
+    SW.compression = BinaryIOCompressionParameters("truncate-shuffle-deflate",20);
+    SW.writeScidacFieldRecord(U,record);
+    SW.close();
+
+    LatticeGaugeField Ulossless(grid), Ulossy(grid);
+    ScidacReader SR;
+    SR.open(sfile);
+    SR.readScidacFileRecord(grid,record);
+    SR.readScidacFieldRecord(Ulossless,record);
+    SR.readScidacFieldRecord(Ulossy,record);
+    SR.close();
+
+    Ulossless = Ulossless - U;
+    Ulossy    = Ulossy    - U;
+    RealD lossy = std::sqrt(norm2(Ulossy)/norm2(U));
+    std::cout << GridLogMessage << "scidac records: lossless diff " << norm2(Ulossless)
+	      << " lossy relative diff " << lossy << std::endl;
+    assert(norm2(Ulossless) == 0.0);
+    assert(lossy < std::ldexp(1.0,-21));
+  }
+#endif
+
+  Grid_finalize();
+}
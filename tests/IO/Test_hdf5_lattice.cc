@@ -0,0 +1,96 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_hdf5_lattice.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+#ifdef HAVE_HDF5
+  Grid_init(&argc,&argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  LatticeGaugeField U(grid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+  LatticeSpinColourMatrix prop(grid);
+  gaussian(pRNG,prop);
+
+  std::string file("./ckpoint_lattice.h5");
+  {
+    Hdf5LatticeWriter WR(grid,file);
+    WR.writeLattice("gauge",U);                                   // one chunk per timeslice
+    WR.writeLattice("propagator",prop,Coordinate({4,4,4,2}));     // blocked chunks
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Collective read back
+  ////////////////////////////////////////////////////////////////
+  {
+    LatticeGaugeField       Ur(grid);
+    LatticeSpinColourMatrix propr(grid);
+    Hdf5LatticeReader RD(grid,file);
+    RD.readLattice("gauge",Ur);
+    RD.readLattice("propagator",propr);
+    Ur    = Ur - U;
+    propr = propr - prop;
+    std::cout << GridLogMessage << "read back differences " << norm2(Ur) << " " << norm2(propr) << std::endl;
+    assert(norm2(Ur) == 0.0);
+    assert(norm2(propr) == 0.0);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // One timeslice of the propagator, as an analysis code would;
+  // every rank reads it (peekSite is collective)
+  ////////////////////////////////////////////////////////////////
+  {
+    Coordinate gdims = grid->FullDimensions();
+    int t = gdims[Tdir]/2+1;
+    Coordinate start({0,0,0,t});
+    Coordinate count(gdims);
+    count[Tdir] = 1;
+    std::vector<SpinColourMatrixD> slice;
+    Hdf5LatticeIO::readHyperslab(file,"propagator",start,count,slice);
+    assert(slice.size() == gdims[0]*gdims[1]*gdims[2]);
+
+    RealD diff = 0;
+    for(uint64_t s=0;s<slice.size();s++){
+      Coordinate site({int(s%gdims[0]),int((s/gdims[0])%gdims[1]),int(s/(gdims[0]*gdims[1])),t});
+      SpinColourMatrixD ref;
+      peekSite(ref,prop,site);
+      diff += norm2(slice[s]-ref);
+    }
+    std::cout << GridLogMessage << "timeslice " << t << " hyperslab difference " << diff << std::endl;
+    assert(diff == 0.0);
+  }
+
+  Grid_finalize();
+#endif
+}
@@ -0,0 +1,137 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_partitioned_io.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+std::vector<char> FileBytes(std::string file)
+{
+  std::ifstream fin(file,std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  typedef LorentzColourMatrixD sobj;
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  LatticeGaugeField U(grid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+
+  ////////////////////////////////////////////////////////////////
+  // Checksums agree with the single file of BinaryIO
+  ////////////////////////////////////////////////////////////////
+  uint32_t nb,ab,bb;
+  {
+    std::string file("./ckpoint_partitioned_ref");
+    BinarySimpleUnmunger<sobj,sobj> unmunge;
+    { std::ofstream fout(file,std::ios::out); }
+    BinaryIO::writeLatticeObject<vLorentzColourMatrixD,sobj>(U,file,unmunge,0,"IEEE64BIG",nb,ab,bb);
+  }
+
+  for(int ranksPerFile : std::vector<int>({1,2})){
+    std::string path("./ckpoint_partitioned_"+std::to_string(ranksPerFile));
+    BinarySimpleUnmunger<sobj,sobj> unmunge;
+    BinarySimpleMunger<sobj,sobj>   munge;
+    uint32_t nw,aw,bw, nr,ar,br;
+    PartitionedIO::writeLatticeObject<vLorentzColourMatrixD,sobj>(U,path,unmunge,"IEEE64BIG","4D_SU3_GAUGE_3x3",
+								  ranksPerFile,nw,aw,bw);
+    assert(nw==nb && aw==ab && bw==bb);
+
+    LatticeGaugeField Ur(grid);
+    PartitionedIO::readLatticeObject<vLorentzColourMatrixD,sobj>(Ur,path,munge,nr,ar,br);
+    assert(nw==nr && aw==ar && bw==br);
+    Ur = Ur - U;
+    assert(norm2(Ur) == 0.0);
+    std::cout << GridLogMessage << "ranks per file " << ranksPerFile << " round trip agrees" << std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // A layout foreign to this run: the lattice cut in two along x
+  // and t, four chunks in two files, as a 2x1x1x2 job would write it
+  ////////////////////////////////////////////////////////////////
+  if ( grid->ProcessorCount() == 1 ) {
+    std::string path("./ckpoint_partitioned_split");
+    PartitionedIO::writeConfiguration(U,path);
+
+    PartitionedIOManifest manifest;
+    PartitionedIO::readManifest(grid,path,manifest);
+    std::vector<char> whole = FileBytes(path+"/part.0");
+
+    Coordinate gdims = grid->FullDimensions();
+    uint64_t site = manifest.site_bytes;
+    Coordinate cdims(gdims);
+    cdims[0] = gdims[0]/2;
+    cdims[3] = gdims[3]/2;
+    uint64_t csites = cdims[0]*cdims[1]*cdims[2]*cdims[3];
+
+    std::vector<std::vector<char> > files(2);
+    manifest.chunks.resize(0);
+    manifest.processors = std::vector<int>({2,1,1,2});
+    manifest.ranks_per_file = 2;
+    for(int c=0;c<4;c++){
+      PartitionedIOChunk chunk;
+      int px = c%2, pt = c/2;
+      chunk.file      = PartitionedIO::partFile(c/2);
+      chunk.offset    = (c%2)*csites*site;
+      chunk.start     = std::vector<int>({px*cdims[0],0,0,pt*cdims[3]});
+      chunk.dimension = std::vector<int>({cdims[0],cdims[1],cdims[2],cdims[3]});
+      chunk.checksum = chunk.scidac_checksuma = chunk.scidac_checksumb = 0;
+      for(uint64_t s=0;s<csites;s++){
+	uint64_t rem = s, g = 0, stride = 1;
+	for(int d=0;d<Nd;d++){
+	  g += (rem%cdims[d] + chunk.start[d])*stride;
+	  rem /= cdims[d];
+	  stride *= gdims[d];
+	}
+	files[c/2].insert(files[c/2].end(),&whole[g*site],&whole[g*site]+site);
+      }
+      manifest.chunks.push_back(chunk);
+    }
+    for(int f=0;f<2;f++){
+      std::ofstream fout(path+"/"+PartitionedIO::partFile(f),std::ios::binary);
+      fout.write(&files[f][0],files[f].size());
+    }
+    {
+      XmlWriter WR(PartitionedIO::manifestFile(path));
+      write(WR,"PartitionedIOManifest",manifest);
+    }
+
+    LatticeGaugeField Ur(grid);
+    PartitionedIO::readConfiguration(Ur,path);
+    Ur = Ur - U;
+    assert(norm2(Ur) == 0.0);
+    std::cout << GridLogMessage << "read from a foreign decomposition agrees" << std::endl;
+  }
+
+  Grid_finalize();
+}
@@ -0,0 +1,144 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_cayley_fused.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field> RealD RelDiff(const Field &a, const Field &b)
+{
+  Field d(a.Grid());
+  d = a - b;
+  return std::sqrt(norm2(d)/norm2(b));
+}
+
+////////////////////////////////////////////////////////////////
+// Fused hop + 5th dimension kernel against the separate passes
+////////////////////////////////////////////////////////////////
+template<class Action>
+void TestFused(std::string name, Action &Ddwf, GridParallelRNG &RNG5, GridRedBlackCartesian *FrbGrid)
+{
+  typedef typename Action::FermionField FermionField;
+
+  FermionField src(Ddwf.FermionGrid()); random(RNG5, src);
+  FermionField src_o(FrbGrid), src_e(FrbGrid);
+  pickCheckerboard(Odd,  src_o, src);
+  pickCheckerboard(Even, src_e, src);
+
+  FermionField sep(FrbGrid), fused(FrbGrid), tmp(FrbGrid);
+
+  std::vector<int> opts({WilsonKernelsStatic::OptGeneric, WilsonKernelsStatic::OptHandUnroll});
+  int opt_save  = WilsonKernelsStatic::Opt;
+  int fuse_save = WilsonKernelsStatic::FuseCayley;
+  int comm_save = WilsonKernelsStatic::Comms;
+  WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsThenCompute;
+
+  SchurDiagMooeeOperator<Action, FermionField> HermOpEO(Ddwf);
+  SchurDiagTwoOperator<Action, FermionField>   HermOpTwo(Ddwf);
+
+  for (auto opt : opts) {
+    WilsonKernelsStatic::Opt = opt;
+
+    for (int cb=0; cb<2; cb++) {
+      FermionField &in = cb ? src_o : src_e;
+
+      WilsonKernelsStatic::FuseCayley = 0; Ddwf.MooeeInvMeooe(in, sep, tmp);
+      WilsonKernelsStatic::FuseCayley = 1; Ddwf.MooeeInvMeooe(in, fused, tmp);
+      assert(fused.Checkerboard() == sep.Checkerboard());
+      RealD d = RelDiff(fused, sep);
+      std::cout << GridLogMessage << name << " Opt " << opt << " cb " << cb << " MooeeInvMeooe       fused " << d << std::endl;
+      assert(d < 1.0e-13);
+
+      WilsonKernelsStatic::FuseCayley = 0; Ddwf.MooeeInvDagMeooeDag(in, sep, tmp);
+      WilsonKernelsStatic::FuseCayley = 1; Ddwf.MooeeInvDagMeooeDag(in, fused, tmp);
+      assert(fused.Checkerboard() == sep.Checkerboard());
+      d = RelDiff(fused, sep);
+      std::cout << GridLogMessage << name << " Opt " << opt << " cb " << cb << " MooeeInvDagMeooeDag fused " << d << std::endl;
+      assert(d < 1.0e-13);
+    }
+
+    WilsonKernelsStatic::FuseCayley = 0; HermOpEO.Mpc(src_o, sep);
+    WilsonKernelsStatic::FuseCayley = 1; HermOpEO.Mpc(src_o, fused);
+    std::cout << GridLogMessage << name << " Opt " << opt << " SchurDiagMooee Mpc    fused " << RelDiff(fused, sep) << std::endl;
+    assert(RelDiff(fused, sep) < 1.0e-13);
+
+    WilsonKernelsStatic::FuseCayley = 0; HermOpTwo.MpcDag(src_o, sep);
+    WilsonKernelsStatic::FuseCayley = 1; HermOpTwo.MpcDag(src_o, fused);
+    std::cout << GridLogMessage << name << " Opt " << opt << " SchurDiagTwo MpcDag   fused " << RelDiff(fused, sep) << std::endl;
+    assert(RelDiff(fused, sep) < 1.0e-13);
+  }
+
+  int ncall = 20;
+  for (int fuse=0; fuse<2; fuse++) {
+    WilsonKernelsStatic::FuseCayley = fuse;
+    HermOpEO.Mpc(src_o, fused);
+    double t0 = usecond();
+    for (int i=0; i<ncall; i++) HermOpEO.Mpc(src_o, fused);
+    double t1 = usecond();
+    std::cout << GridLogMessage << name << " SchurDiagMooee Mpc " << (fuse ? "fused    " : "separate ")
+	      << (t1-t0)/ncall << " us per call" << std::endl;
+  }
+
+  WilsonKernelsStatic::Opt        = opt_save;
+  WilsonKernelsStatic::FuseCayley = fuse_save;
+  WilsonKernelsStatic::Comms      = comm_save;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG RNG4(UGrid); RNG4.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  GridParallelRNG RNG5(FGrid); RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4, Umu);
+
+  RealD mass = 0.1;
+  RealD M5   = 1.8;
+
+  DomainWallFermionD Dshamir(Umu, *FGrid, *FrbGrid, *UGrid, *UrbGrid, mass, M5);
+  TestFused("Shamir", Dshamir, RNG5, FrbGrid);
+
+  RealD b = 1.5, c = 0.5;
+  MobiusFermionD Dmobius(Umu, *FGrid, *FrbGrid, *UGrid, *UrbGrid, mass, M5, b, c);
+  TestFused("Mobius", Dmobius, RNG5, FrbGrid);
+
+  std::vector<ComplexD> omegas;
+  for (int s=0; s<Ls; s++) {
+    omegas.push_back(ComplexD(0.25+0.05*s, (s==Ls-2) ? 0.02 : ((s==Ls-1) ? -0.02 : 0.0)));
+  }
+  ZMobiusFermionD Dzmobius(Umu, *FGrid, *FrbGrid, *UGrid, *UrbGrid, mass, M5, omegas, b, c);
+  TestFused("ZMobius", Dzmobius, RNG5, FrbGrid);
+
+  Grid_finalize();
+}
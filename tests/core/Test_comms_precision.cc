@@ -0,0 +1,160 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_comms_precision.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+////////////////////////////////////////////////////////////////////
+// Pack/unpack round trip; error relative to the largest component
+// of each site, for sites spanning many orders of magnitude
+////////////////////////////////////////////////////////////////////
+template<class Field>
+void TestRoundTrip(GridParallelRNG &RNG,int precision,RealD tol)
+{
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::scalar_object  sobj;
+
+  GridBase *grid = RNG.Grid();
+  Field in(grid), out(grid);
+  random(RNG,in);
+  for(int x=0;x<grid->_fdimensions[0];x++){
+    Coordinate site({x,0,0,0});
+    sobj s;
+    peekSite(s,in,site);
+    s = s * std::pow(2.0,8.0*x-16.0);
+    pokeSite(s,in,site);
+  }
+
+  int bytes = CommsDatumBytes<vobj>(precision);
+  std::vector<uint8_t> buf(bytes*grid->oSites());
+  {
+    autoView( in_v , in , CpuRead);
+    autoView( out_v, out, CpuWrite);
+    for(int ss=0;ss<grid->oSites();ss++) CommsPack(precision,(void *)&buf[0],ss,in_v[ss]);
+    for(int ss=0;ss<grid->oSites();ss++) CommsUnpack(precision,out_v[ss],(void *)&buf[0],ss);
+  }
+
+  RealD worst=0;
+  Coordinate site;
+  for(int idx=0;idx<grid->gSites();idx++){
+    Lexicographic::CoorFromIndex(site,idx,grid->_fdimensions);
+    sobj a,b;
+    peekSite(a,in,site);
+    peekSite(b,out,site);
+    RealD amax = 0;
+    typedef typename RealPart<typename sobj::scalar_type>::type real;
+    real *ar = (real *)&a;
+    real *br = (real *)&b;
+    RealD dmax = 0;
+    for(int i=0;i<sizeof(sobj)/sizeof(real);i++){
+      amax = std::max(amax,(RealD)std::fabs(ar[i]));
+      dmax = std::max(dmax,(RealD)std::fabs(ar[i]-br[i]));
+    }
+    worst = std::max(worst,dmax/amax);
+  }
+  std::cout << GridLogMessage << "precision " << precision << " datum " << bytes << "/" << sizeof(vobj)
+	    << " bytes ; worst relative error " << worst << " tolerance " << tol << std::endl;
+  assert(worst <= tol);
+}
+
+////////////////////////////////////////////////////////////////////
+// Dhop with reduced precision halos against native; only differs
+// when the halo leaves the rank. Run decomposed over two or more
+// dimensions so each gather packs several faces; dimensions without
+// SIMD lanes take the table gather, those with them GatherSimd:
+//   mpirun -np 4 Test_comms_precision --mpi 2.2.1.1
+//   mpirun -np 4 Test_comms_precision --mpi 1.1.2.2
+////////////////////////////////////////////////////////////////////
+template<class Action>
+RealD DhopDifference(Action &native,Action &reduced,GridParallelRNG &RNG)
+{
+  typedef typename Action::FermionField FermionField;
+  GridBase *grid = native.FermionGrid();
+  FermionField src(grid), ref(grid), res(grid);
+  random(RNG,src);
+  native.Dhop(src,ref,DaggerNo);
+  reduced.Dhop(src,res,DaggerNo);
+  res = res - ref;
+  return std::sqrt(norm2(res)/norm2(ref));
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG RNG(UGrid); RNG.SeedFixedIntegers(seeds);
+
+  std::cout << GridLogMessage << "Pack/unpack round trip" << std::endl;
+  TestRoundTrip<LatticeFermionD>(RNG,CommsPrecisionNative,0.0);
+  TestRoundTrip<LatticeFermionD>(RNG,CommsPrecisionSingle,1.0/(1<<23));
+  TestRoundTrip<LatticeFermionD>(RNG,CommsPrecisionHalf  ,1.0/(1<<11));
+  TestRoundTrip<LatticeFermionD>(RNG,CommsPrecisionBF16  ,1.0/(1<<8));
+  TestRoundTrip<LatticeColourVectorD>(RNG,CommsPrecisionHalf,1.0/(1<<11));
+
+  LatticeGaugeFieldD Umu(UGrid); SU<Nc>::HotConfiguration(RNG,Umu);
+
+  // With a distributed dimension the reduced precision halos must be in use
+  int distributed = 0;
+  for(int d=0;d<Nd;d++) if ( UGrid->_processors[d]>1 ) distributed++;
+  std::cout << GridLogMessage << "Distributed dimensions " << distributed << std::endl;
+
+  RealD mass=0.1;
+  std::vector<int>   precisions({CommsPrecisionSingle,CommsPrecisionHalf,CommsPrecisionBF16});
+  std::vector<RealD> tolerances({1.0e-6,1.0e-3,1.0e-2});
+
+  std::cout << GridLogMessage << "Wilson Dhop halo precision" << std::endl;
+  WilsonFermionD Dw(Umu,*UGrid,*UrbGrid,mass);
+  for(int p=0;p<precisions.size();p++){
+    WilsonFermionD::ImplParams params;
+    params.commsPrecision = precisions[p];
+    WilsonFermionD Dwr(Umu,*UGrid,*UrbGrid,mass,params);
+    RealD diff = DhopDifference(Dw,Dwr,RNG);
+    std::cout << GridLogMessage << "precision " << precisions[p] << " relative difference " << diff << std::endl;
+    assert(diff <= tolerances[p]);
+    if ( distributed ) assert(diff > 0.0);
+  }
+
+  std::cout << GridLogMessage << "Improved staggered Dhop halo precision" << std::endl;
+  RealD c1=9.0/8.0;
+  RealD c2=-1.0/24.0;
+  RealD u0=1.0;
+  ImprovedStaggeredFermionD Ds(Umu,Umu,*UGrid,*UrbGrid,mass,c1,c2,u0);
+  for(int p=0;p<precisions.size();p++){
+    ImprovedStaggeredFermionD::ImplParams params;
+    params.commsPrecision = precisions[p];
+    ImprovedStaggeredFermionD Dsr(Umu,Umu,*UGrid,*UrbGrid,mass,c1,c2,u0,params);
+    RealD diff = DhopDifference(Ds,Dsr,RNG);
+    std::cout << GridLogMessage << "precision " << precisions[p] << " relative difference " << diff << std::endl;
+    assert(diff <= tolerances[p]);
+    if ( distributed ) assert(diff > 0.0);
+  }
+
+  Grid_finalize();
+}
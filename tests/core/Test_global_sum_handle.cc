@@ -0,0 +1,111 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_global_sum_handle.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layoutD = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate simd_layoutF = GridDefaultSimd(Nd,vComplexF::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian     GridD(latt_size,simd_layoutD,mpi_layout);
+  GridCartesian     GridF(latt_size,simd_layoutF,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG  pRNGD(&GridD); pRNGD.SeedFixedIntegers(seeds);
+  GridParallelRNG  pRNGF(&GridF); pRNGF.SeedFixedIntegers(seeds);
+
+  LatticeFermionD x(&GridD), y(&GridD), z(&GridD);
+  LatticeComplexF c(&GridF);
+  gaussian(pRNGD,x);
+  gaussian(pRNGD,y);
+  gaussian(pRNGF,c);
+
+  ////////////////////////////////////////////
+  // Reference values, one allreduce each
+  ////////////////////////////////////////////
+  RealD    xx_ref = real(TensorRemove(sum(localInnerProduct(x,x))));
+  ComplexD xy_ref = TensorRemove(sum(localInnerProduct(x,y)));
+  std::vector<LatticeFermionD::scalar_object> slice_ref;
+  std::vector<TComplexF> cslice_ref;
+  sliceSum(x,slice_ref,Nd-1);
+  sliceSum(c,cslice_ref,Nd-1);
+
+  ////////////////////////////////////////////
+  // Everything in one batched reduction
+  ////////////////////////////////////////////
+  RealD    xx, zz;
+  ComplexD xy;
+  std::vector<LatticeFermionD::scalar_object> slice;
+  std::vector<TComplexF> cslice;
+
+  GlobalSumHandle sums(&GridD);
+  norm2(sums,xx,x);
+  innerProduct(sums,xy,x,y);
+  sliceSum(sums,x,slice,Nd-1);
+  sliceSum(sums,c,cslice,Nd-1);
+  fuse(sums,fuse_assign(z,x+2.0*y),fuse_norm2(zz,z));
+  std::cout << GridLogMessage << " batched words " << sums.Words() << std::endl;
+  sums.Begin();
+  RealD yy = norm2(y); // blocking reductions may be issued while the batch is in flight
+  sums.Wait();
+
+  RealD zz_ref = norm2(z);
+  std::cout << GridLogMessage << " norm2 " << xx << " ref " << xx_ref << std::endl;
+  std::cout << GridLogMessage << " innerProduct " << xy << " ref " << xy_ref << std::endl;
+  std::cout << GridLogMessage << " fused norm2 " << zz << " ref " << zz_ref << std::endl;
+  assert(std::abs(xx-xx_ref) <= 1.0e-12*xx_ref);
+  assert(std::abs(xy-xy_ref) <= 1.0e-12*xx_ref);
+  assert(std::abs(zz-zz_ref) <= 1.0e-12*zz_ref);
+  assert(yy > 0.0);
+
+  assert(slice.size()==slice_ref.size());
+  assert(cslice.size()==cslice_ref.size());
+  for(int t=0;t<slice.size();t++){
+    auto diff = slice[t]-slice_ref[t];
+    RealD dd = norm2(diff);
+    RealD dc = std::abs(TensorRemove(cslice[t]-cslice_ref[t]));
+    std::cout << GridLogMessage << " slice " << t << " diff " << dd << " " << dc << std::endl;
+    assert(dd <= 1.0e-24*norm2(slice_ref[t]));
+    assert(dc <= 1.0e-5*std::abs(TensorRemove(cslice_ref[t])));
+  }
+
+  ////////////////////////////////////////////
+  // Handle is reusable after Wait
+  ////////////////////////////////////////////
+  norm2(sums,xx,y);
+  sums.Wait();
+  std::cout << GridLogMessage << " reuse norm2 " << xx << " ref " << yy << std::endl;
+  assert(std::abs(xx-yy) <= 1.0e-12*yy);
+
+  std::cout << GridLogMessage << "Test_global_sum_handle passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,122 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_lattice_fuse.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field> void CheckFuse(GridParallelRNG &pRNG,GridBase *grid,RealD tol)
+{
+  Field x(grid), p(grid), r(grid), q(grid);
+  Field xr(grid), pr(grid), rr(grid), diff(grid);
+
+  gaussian(pRNG,x);
+  gaussian(pRNG,p);
+  gaussian(pRNG,r);
+  gaussian(pRNG,q);
+
+  RealD a = 0.37, b = -1.21;
+
+  ////////////////////////////////////////////
+  // Reference: one statement at a time
+  ////////////////////////////////////////////
+  xr = x; pr = p; rr = r;
+  pr = rr + b*pr;
+  xr = xr + a*pr;
+  rr = rr - a*q;
+  RealD    cp_ref = norm2(rr);
+  ComplexD ip_ref = innerProduct(pr,q);
+
+  RealD    cp;
+  ComplexD ip;
+  fuse(fuse_assign(p, r + b*p),
+       fuse_assign(x, x + a*p),
+       fuse_assign(r, r - a*q),
+       fuse_norm2(cp, r),
+       fuse_innerProduct(ip, p, q));
+
+  diff = x - xr;  RealD dx = norm2(diff);
+  diff = p - pr;  RealD dp = norm2(diff);
+  diff = r - rr;  RealD dr = norm2(diff);
+  std::cout << GridLogMessage << " fused sweep x,p,r diff " << dx << " " << dp << " " << dr << std::endl;
+  std::cout << GridLogMessage << " fused norm2 " << cp << " ref " << cp_ref << std::endl;
+  std::cout << GridLogMessage << " fused innerProduct " << ip << " ref " << ip_ref << std::endl;
+  assert(dx <= tol*norm2(xr));
+  assert(dp <= tol*norm2(pr));
+  assert(dr <= tol*norm2(rr));
+  assert(std::abs(cp-cp_ref) <= tol*cp_ref);
+  assert(std::abs(ip-ip_ref) <= tol*std::abs(ip_ref)+tol);
+
+  ////////////////////////////////////////////
+  // Assignments only take the coalesced path
+  ////////////////////////////////////////////
+  pr = p; xr = x;
+  pr = q - pr;
+  xr = xr + b*pr;
+  fuse(fuse_assign(p, q - p), fuse_assign(x, x + b*p));
+  diff = x - xr;  dx = norm2(diff);
+  diff = p - pr;  dp = norm2(diff);
+  std::cout << GridLogMessage << " fused assign x,p diff " << dx << " " << dp << std::endl;
+  assert(dx <= tol*norm2(xr));
+  assert(dp <= tol*norm2(pr));
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layoutD = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate simd_layoutF = GridDefaultSimd(Nd,vComplexF::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian     GridD(latt_size,simd_layoutD,mpi_layout);
+  GridCartesian     GridF(latt_size,simd_layoutF,mpi_layout);
+  GridRedBlackCartesian RBGridD(&GridD);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG  pRNGD(&GridD); pRNGD.SeedFixedIntegers(seeds);
+  GridParallelRNG  pRNGF(&GridF); pRNGF.SeedFixedIntegers(seeds);
+
+  std::cout << GridLogMessage << "LatticeFermionD" << std::endl;
+  CheckFuse<LatticeFermionD>(pRNGD,&GridD,1.0e-24);
+  std::cout << GridLogMessage << "LatticeFermionF" << std::endl;
+  CheckFuse<LatticeFermionF>(pRNGF,&GridF,1.0e-10);
+
+  ////////////////////////////////////////////
+  // Checkerboard follows the expression
+  ////////////////////////////////////////////
+  LatticeFermionD src(&GridD), srcO(&RBGridD), tmpO(&RBGridD);
+  gaussian(pRNGD,src);
+  pickCheckerboard(Odd,srcO,src);
+  RealD nrm;
+  fuse(fuse_assign(tmpO, 2.0*srcO), fuse_norm2(nrm, tmpO));
+  std::cout << GridLogMessage << " checkerboard " << tmpO.Checkerboard() << " norm " << nrm << " ref " << 4.0*norm2(srcO) << std::endl;
+  assert(tmpO.Checkerboard()==Odd);
+  assert(std::abs(nrm-4.0*norm2(srcO)) <= 1.0e-12*nrm);
+
+  std::cout << GridLogMessage << "Test_lattice_fuse passed" << std::endl;
+  Grid_finalize();
+}
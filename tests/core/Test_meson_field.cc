@@ -0,0 +1,109 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_meson_field.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+#include <Grid/qcd/utils/A2Autils.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  typedef WilsonImplR FImpl;
+  typedef typename FImpl::FermionField FermionField;
+
+  const int Lblock = 3;
+  const int Rblock = 5;
+  const int Tdir   = Tp;
+  int Nt = grid->GlobalDimensions()[Tdir];
+
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  std::vector<FermionField> w(Lblock,grid), v(Rblock,grid);
+  for(auto &f : w) gaussian(pRNG,f);
+  for(auto &f : v) gaussian(pRNG,f);
+
+  ////////////////////////////////////////////////////////////////
+  // Plane wave phases, including zero momentum
+  ////////////////////////////////////////////////////////////////
+  std::vector<std::vector<int> > moms({{0,0,0},{1,0,0},{0,1,-1}});
+  std::vector<LatticeComplex> phases;
+  LatticeComplex coor(grid);
+  for(auto p : moms){
+    LatticeComplex ph(grid); ph = Zero();
+    for(int mu=0;mu<Nd-1;mu++){
+      LatticeCoordinate(coor,mu);
+      ph = ph + (2.0*M_PI*p[mu]/grid->GlobalDimensions()[mu])*coor;
+    }
+    ComplexD ci(0.0,1.0);
+    ph = exp(ci*ph);
+    phases.push_back(ph);
+  }
+
+  std::vector<Gamma::Algebra> gammas({Gamma::Algebra::Identity,
+				      Gamma::Algebra::Gamma5,
+				      Gamma::Algebra::GammaX,
+				      Gamma::Algebra::SigmaXT});
+
+  int Nmom   = phases.size();
+  int Ngamma = gammas.size();
+  Eigen::Tensor<ComplexD,5> mat(Nmom,Ngamma,Nt,Lblock,Rblock);
+  double t_kernel, t_gsum;
+  A2Autils<FImpl>::MesonField(mat,&w[0],&v[0],gammas,phases,Tdir,&t_kernel,&t_gsum);
+  std::cout << GridLogMessage << "MesonField kernel " << t_kernel << " us, global sum " << t_gsum << " us" << std::endl;
+
+  ////////////////////////////////////////////////////////////////
+  // Reference: sum over timeslices of phase * w_i^dag Gamma v_j
+  ////////////////////////////////////////////////////////////////
+  RealD maxerr = 0.0, maxval = 0.0;
+  FermionField gv(grid);
+  LatticeComplex c(grid), pc(grid);
+  std::vector<TComplex> sum;
+  for(int i=0;i<Lblock;i++){
+  for(int j=0;j<Rblock;j++){
+  for(int mu=0;mu<Ngamma;mu++){
+    gv = Gamma(gammas[mu])*v[j];
+    c  = localInnerProduct(w[i],gv);
+    for(int m=0;m<Nmom;m++){
+      pc = phases[m]*c;
+      sliceSum(pc,sum,Tdir);
+      for(int t=0;t<Nt;t++){
+	maxerr = std::max(maxerr,(RealD)abs(TensorRemove(sum[t])-mat(m,mu,t,i,j)));
+	maxval = std::max(maxval,(RealD)abs(TensorRemove(sum[t])));
+      }
+    }
+  }}}
+  std::cout << GridLogMessage << "MesonField max deviation from reference " << maxerr
+	    << " (max element " << maxval << ")" << std::endl;
+  assert(maxerr < 1.0e-10*maxval);
+
+  Grid_finalize();
+}
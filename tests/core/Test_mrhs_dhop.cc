@@ -0,0 +1,146 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_mrhs_dhop.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field>
+RealD BlockDiff(const std::vector<Field> &single,const Field &block)
+{
+  Field tmp(single[0].Grid());
+  RealD diff=0.0;
+  for(int r=0;r<single.size();r++){
+    ExtractRHS(tmp,block,r);
+    tmp = tmp - single[r];
+    diff += norm2(tmp);
+  }
+  return diff;
+}
+
+#define CHECK_RHS(name,single,block)					\
+  {									\
+    RealD d = BlockDiff(single,block);					\
+    std::cout << GridLogMessage << name << " block vs single diff " << d << std::endl; \
+    assert(d <= 1.0e-24*norm2(block));					\
+  }
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls   = 4;
+  const int Nrhs = 3;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+  GridCartesian         * BGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls*Nrhs,UGrid);
+  GridRedBlackCartesian * BrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls*Nrhs,UGrid);
+  GridCartesian         * WGrid   = SpaceTimeGrid::makeFiveDimGrid(Nrhs,UGrid);
+  GridRedBlackCartesian * WrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Nrhs,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+
+  LatticeGaugeFieldD Umu(UGrid); SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  ////////////////////////////////////////////
+  // Mobius: Nrhs blocks of Ls
+  ////////////////////////////////////////////
+  MobiusFermionD::ImplParams params;
+  MobiusFermionD Dsingle(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,1.5,0.5,params);
+  MobiusFermionD Dblock (Umu,*BGrid,*BrbGrid,*UGrid,*UrbGrid,mass,M5,1.5,0.5,params,Nrhs);
+  assert(Dblock.Ls==Ls);
+
+  std::vector<LatticeFermionD> src(Nrhs,FGrid), res(Nrhs,FGrid);
+  std::vector<LatticeFermionD> src_o(Nrhs,FrbGrid), res_o(Nrhs,FrbGrid);
+  LatticeFermionD src_b(BGrid), res_b(BGrid);
+  LatticeFermionD src_bo(BrbGrid), res_bo(BrbGrid);
+  for(int r=0;r<Nrhs;r++){
+    random(RNG5,src[r]);
+    InsertRHS(src[r],src_b,r);
+    pickCheckerboard(Odd,src_o[r],src[r]);
+  }
+  pickCheckerboard(Odd,src_bo,src_b);
+
+  for(int r=0;r<Nrhs;r++) Dsingle.Dhop(src[r],res[r],DaggerNo);
+  Dblock.Dhop(src_b,res_b,DaggerNo);
+  CHECK_RHS("Mobius Dhop",res,res_b);
+
+  for(int r=0;r<Nrhs;r++) Dsingle.M(src[r],res[r]);
+  Dblock.M(src_b,res_b);
+  CHECK_RHS("Mobius M",res,res_b);
+
+  for(int r=0;r<Nrhs;r++) Dsingle.Mdag(src[r],res[r]);
+  Dblock.Mdag(src_b,res_b);
+  CHECK_RHS("Mobius Mdag",res,res_b);
+
+  for(int r=0;r<Nrhs;r++) Dsingle.Meooe(src_o[r],res_o[r]);
+  Dblock.Meooe(src_bo,res_bo);
+  CHECK_RHS("Mobius Meooe",res_o,res_bo);
+
+  for(int r=0;r<Nrhs;r++) Dsingle.MooeeInv(src_o[r],res_o[r]);
+  Dblock.MooeeInv(src_bo,res_bo);
+  CHECK_RHS("Mobius MooeeInv",res_o,res_bo);
+
+  for(int r=0;r<Nrhs;r++) Dsingle.MooeeInvDag(src_o[r],res_o[r]);
+  Dblock.MooeeInvDag(src_bo,res_bo);
+  CHECK_RHS("Mobius MooeeInvDag",res_o,res_bo);
+
+  for(int r=0;r<Nrhs;r++) Dsingle.Dminus(src[r],res[r]);
+  Dblock.Dminus(src_b,res_b);
+  CHECK_RHS("Mobius Dminus",res,res_b);
+
+  for(int r=0;r<Nrhs;r++) Dsingle.P(src[r],res[r]);
+  Dblock.P(src_b,res_b);
+  CHECK_RHS("Mobius P",res,res_b);
+
+  ////////////////////////////////////////////
+  // Wilson: four dimensional fields, Ls=1
+  ////////////////////////////////////////////
+  WilsonFermionD Wsingle(Umu,*UGrid,*UrbGrid,mass);
+  std::vector<RealD> masses(Nrhs,mass), mus(Nrhs,0.0);
+  WilsonTMFermion5DD Wblock(Umu,*WGrid,*WrbGrid,*UGrid,*UrbGrid,masses,mus);
+
+  std::vector<LatticeFermionD> src4(Nrhs,UGrid), res4(Nrhs,UGrid);
+  LatticeFermionD src_w(WGrid), res_w(WGrid);
+  for(int r=0;r<Nrhs;r++){
+    random(RNG4,src4[r]);
+    InsertRHS(src4[r],src_w,r);
+  }
+  for(int r=0;r<Nrhs;r++) Wsingle.M(src4[r],res4[r]);
+  Wblock.M(src_w,res_w);
+  CHECK_RHS("Wilson M",res4,res_w);
+
+  std::cout << GridLogMessage << "Test_mrhs_dhop passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,108 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_node_reductions.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+////////////////////////////////////////////////////////////////////
+// Node aware reductions against the flat MPI_Allreduce, bit for bit.
+// Values are small integers and dyadic fractions so every summation
+// order is exact; any difference is a data movement error. Lengths
+// cover the scalar case and vectors spanning several window chunks.
+//   mpirun -np 4 Test_node_reductions --mpi 1.1.2.2
+////////////////////////////////////////////////////////////////////
+template<class T>
+void CompareSums(GridCartesian &Grid,int N,const std::string &type)
+{
+  std::vector<T> node(N), flat(N);
+  int rank = Grid.ThisRank();
+  for(int i=0;i<N;i++){
+    node[i] = (T)((rank+1)*(i%1021+1)) + (T)(i%7)*(T)0.125;
+  }
+  flat = node;
+
+  CartesianCommunicator::NodeAwareReductions = 1;
+  if ( N==1 ) Grid.GlobalSum(node[0]);
+  else        Grid.GlobalSumVector(&node[0],N);
+
+  CartesianCommunicator::NodeAwareReductions = 0;
+  if ( N==1 ) Grid.GlobalSum(flat[0]);
+  else        Grid.GlobalSumVector(&flat[0],N);
+
+  int mismatch = 0;
+  for(int i=0;i<N;i++){
+    if ( memcmp(&node[i],&flat[i],sizeof(T)) ) mismatch++;
+  }
+  std::cout << GridLogMessage << type << " length " << N
+	    << " mismatches " << mismatch << std::endl;
+  assert(mismatch==0);
+}
+
+template<class T>
+void CompareLengths(GridCartesian &Grid,const std::string &type)
+{
+  int chunk = 64*1024/(2*sizeof(T)); // NodeReduceBytes per rank, half contribution half result
+  std::vector<int> lengths({1,2,chunk-1,chunk,chunk+1,3*chunk+17});
+  for(auto N : lengths) CompareSums<T>(Grid,N,type);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  // Window is set up at communicator construction; ask for it before the grid exists
+  CartesianCommunicator::NodeAwareReductions = 1;
+
+  GridCartesian Grid(GridDefaultLatt(),GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+
+  std::cout << GridLogMessage << "Ranks " << Grid.ProcessorCount()
+	    << " ranks on this node " << GlobalSharedMemory::WorldShmSize << std::endl;
+
+  CompareLengths<uint64_t>(Grid,"uint64_t");
+  CompareLengths<float>   (Grid,"float");
+  CompareLengths<double>  (Grid,"double");
+
+  // Lattice reductions reach the same sums; integer valued sites keep them exact
+  LatticeComplexD a(&Grid), coor(&Grid);
+  a = Zero();
+  for(int mu=0;mu<Nd;mu++){
+    LatticeCoordinate(coor,mu);
+    a = a + coor*ComplexD(mu+1,1);
+  }
+  CartesianCommunicator::NodeAwareReductions = 1;
+  RealD    node_nrm = norm2(a);
+  ComplexD node_ip  = innerProduct(a,coor);
+  CartesianCommunicator::NodeAwareReductions = 0;
+  RealD    flat_nrm = norm2(a);
+  ComplexD flat_ip  = innerProduct(a,coor);
+  CartesianCommunicator::NodeAwareReductions = 1;
+  std::cout << GridLogMessage << "norm2 " << node_nrm << " " << flat_nrm
+	    << " innerProduct " << node_ip << " " << flat_ip << std::endl;
+  assert(memcmp(&node_nrm,&flat_nrm,sizeof(RealD))==0);
+  assert(memcmp(&node_ip ,&flat_ip ,sizeof(ComplexD))==0);
+
+  Grid_finalize();
+}
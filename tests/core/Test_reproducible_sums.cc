@@ -0,0 +1,139 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_reproducible_sums.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+static uint64_t bits(double d) { uint64_t u; memcpy(&u,&d,sizeof(u)); return u; }
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  ////////////////////////////////////////////////////////////////
+  // Superaccumulator: exact, order independent
+  ////////////////////////////////////////////////////////////////
+  {
+    ReproducibleSum acc;
+    acc.Add(1.0e100); acc.Add(1.0); acc.Add(-1.0e100);
+    assert(acc.Value() == 1.0);
+
+    ReproducibleSum tiny;
+    tiny.Add(4.9e-324); tiny.Add(4.9e-324); tiny.Add(-1.0); tiny.Add(1.0);
+    assert(tiny.Value() == 2*4.9e-324);
+
+    std::vector<double> x(100000);
+    uint64_t seed = 7;
+    for(auto &v : x) {
+      seed = seed*6364136223846793005ULL+1442695040888963407ULL;
+      int e = (int)((seed>>33)%200)-100;
+      v = std::ldexp((double)(seed>>11)/9007199254740992.0 - 0.5,e);
+    }
+    ReproducibleSum fwd, bwd, split[3];
+    for(int i=0;i<x.size();i++) fwd.Add(x[i]);
+    for(int i=x.size()-1;i>=0;i--) bwd.Add(x[i]);
+    for(int i=0;i<x.size();i++) split[i%3].Add(x[i]);
+    split[2].Merge(split[0]);
+    split[2].Merge(split[1]);
+    assert(bits(fwd.Value()) == bits(bwd.Value()));
+    assert(bits(fwd.Value()) == bits(split[2].Value()));
+    std::cout << GridLogMessage << "ReproducibleSum order independent: " << std::setprecision(17) << fwd.Value() << std::endl;
+
+    ReproducibleSum special;
+    special.Add(1.0); special.Add(HUGE_VAL);
+    assert(special.Value() == HUGE_VAL);
+    special.Add(-HUGE_VAL);
+    assert(std::isnan(special.Value()));
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Lattice reductions independent of SIMD layout and threads
+  ////////////////////////////////////////////////////////////////
+  ReproducibleSum::Enabled = 1;
+
+  Coordinate latt = GridDefaultLatt();
+  Coordinate mpi  = GridDefaultMpi();
+  int Nsimd = vComplexD::Nsimd();
+  std::vector<Coordinate> layouts;
+  for(int mu=0;mu<Nd;mu++){
+    Coordinate simd(Nd,1);
+    simd[mu] = Nsimd;
+    if ( latt[mu] % (Nsimd*mpi[mu]) == 0 ) layouts.push_back(simd);
+  }
+  layouts.push_back(GridDefaultSimd(Nd,Nsimd));
+  
+  GridCartesian *grid0 = new GridCartesian(latt,layouts[0],mpi);
+  GridParallelRNG pRNG(grid0); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  LatticeSpinColourVectorD a0(grid0), b0(grid0);
+  gaussian(pRNG,a0);
+  gaussian(pRNG,b0);
+  std::vector<SpinColourVectorD> a_lex(grid0->lSites()), b_lex(grid0->lSites());
+  unvectorizeToLexOrdArray(a_lex,a0);
+  unvectorizeToLexOrdArray(b_lex,b0);
+
+  int threads = GridThread::GetThreads();
+  uint64_t nrm_bits=0, ip_bits=0, sum_bits=0;
+  for(int l=0;l<layouts.size();l++){
+    for(int thr=1;thr<=threads;thr+=std::max(1,threads-1)){
+      GridThread::SetThreads(thr);
+      GridCartesian grid(latt,layouts[l],mpi);
+      LatticeSpinColourVectorD a(&grid), b(&grid);
+      vectorizeFromLexOrdArray(a_lex,a);
+      vectorizeFromLexOrdArray(b_lex,b);
+
+      RealD    nrm = norm2(a);
+      ComplexD ip  = innerProduct(a,b);
+      SpinColourVectorD s = sum(a);
+
+      // Fused sweep, blocking and through a handle, lands on the same bits
+      RealD    fnrm, hnrm;
+      ComplexD fip,  hip;
+      fuse(fuse_norm2(fnrm,a),fuse_innerProduct(fip,a,b));
+      GlobalSumHandle sums(&grid);
+      fuse(sums,fuse_norm2(hnrm,a),fuse_innerProduct(hip,a,b));
+      sums.Begin();
+      sums.Wait();
+      assert(bits(fnrm) == bits(nrm) && bits(hnrm) == bits(nrm));
+      assert(bits(real(fip)) == bits(real(ip)) && bits(imag(fip)) == bits(imag(ip)));
+      assert(bits(real(hip)) == bits(real(ip)) && bits(imag(hip)) == bits(imag(ip)));
+      uint64_t nb = bits(nrm);
+      uint64_t ib = bits(real(ip)) ^ bits(imag(ip));
+      uint64_t sb = bits(real(s()(0)(0)));
+      std::cout << GridLogMessage << "simd " << layouts[l] << " threads " << thr << " norm2 " << std::hexfloat << nrm
+		<< " innerProduct " << ip << std::defaultfloat << std::endl;
+      if ( l==0 && thr==1 ) { nrm_bits=nb; ip_bits=ib; sum_bits=sb; }
+      assert(nb == nrm_bits);
+      assert(ib == ip_bits);
+      assert(sb == sum_bits);
+    }
+  }
+  GridThread::SetThreads(threads);
+  std::cout << GridLogMessage << "Reproducible reductions are bitwise identical across layouts" << std::endl;
+
+  delete grid0;
+  Grid_finalize();
+}
@@ -0,0 +1,118 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_slice_sum.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  const int N = 5;
+  std::vector<LatticeSpinColourVector> q(N,grid), p(N,grid);
+  for(int n=0;n<N;n++) {
+    gaussian(pRNG,q[n]);
+    gaussian(pRNG,p[n]);
+  }
+
+  for(int dir=0;dir<Nd;dir++){
+    int Nt = grid->GlobalDimensions()[dir];
+
+    ////////////////////////////////////////////////////////////////
+    // Batched sliceSum against the lexicographic site sums
+    ////////////////////////////////////////////////////////////////
+    std::vector<std::vector<SpinColourVector> > batch;
+    sliceSum(q,batch,dir);
+    assert(batch.size()==N);
+
+    std::vector<SpinColourVector> ref;
+    std::vector<SpinColourVector> scalardata(grid->lSites());
+    RealD err = 0.0;
+    for(int n=0;n<N;n++){
+      unvectorizeToLexOrdArray(scalardata,q[n]);
+      ref.assign(Nt,Zero());
+      Coordinate ldims  = grid->LocalDimensions();
+      Coordinate lstart = grid->LocalStarts();
+      for(uint64_t lidx=0;lidx<scalardata.size();lidx++){
+	Coordinate lcoor;
+	Lexicographic::CoorFromIndex(lcoor,lidx,ldims);
+	int t = lcoor[dir]+lstart[dir];
+	ref[t] = ref[t] + scalardata[lidx];
+      }
+      for(int t=0;t<Nt;t++) grid->GlobalSumVector((ComplexD *)&ref[t],sizeof(SpinColourVector)/sizeof(ComplexD));
+
+      std::vector<SpinColourVector> single;
+      sliceSum(q[n],single,dir);
+      for(int t=0;t<Nt;t++) {
+	err += norm2(batch[n][t]-ref[t]);
+	err += norm2(single[t]-ref[t]);
+      }
+    }
+    std::cout << GridLogMessage << "dir " << dir << " batched sliceSum deviation " << err << std::endl;
+    assert(err < 1.0e-20);
+
+    ////////////////////////////////////////////////////////////////
+    // Batched inner products against the single field version
+    ////////////////////////////////////////////////////////////////
+    std::vector<std::vector<ComplexD> > ips;
+    sliceInnerProductVector(ips,p,q,dir);
+    err = 0.0;
+    for(int n=0;n<N;n++){
+      std::vector<ComplexD> ip;
+      sliceInnerProductVector(ip,p[n],q[n],dir);
+      for(int t=0;t<Nt;t++) err += norm(ips[n][t]-ip[t]);
+    }
+    std::cout << GridLogMessage << "dir " << dir << " batched sliceInnerProductVector deviation " << err << std::endl;
+    assert(err < 1.0e-20);
+
+    ////////////////////////////////////////////////////////////////
+    // All gamma insertions (with signs) in one sweep
+    ////////////////////////////////////////////////////////////////
+    std::vector<Gamma> gammas;
+    for(int g=0;g<Gamma::nGamma;g++) gammas.push_back(Gamma((Gamma::Algebra)g));
+    sliceInnerProductVector(ips,p[0],gammas,q[0],dir);
+    assert(ips.size()==Gamma::nGamma);
+    err = 0.0;
+    LatticeSpinColourVector gq(grid);
+    for(int g=0;g<Gamma::nGamma;g++){
+      std::vector<ComplexD> ip;
+      gq = gammas[g]*q[0];
+      sliceInnerProductVector(ip,p[0],gq,dir);
+      for(int t=0;t<Nt;t++) err += norm(ips[g][t]-ip[t]);
+    }
+    std::cout << GridLogMessage << "dir " << dir << " gamma insertions deviation " << err << std::endl;
+    assert(err < 1.0e-20);
+  }
+
+  Grid_finalize();
+}
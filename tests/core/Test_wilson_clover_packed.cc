@@ -0,0 +1,177 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_wilson_clover_packed.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field> RealD RelDiff(const Field &a, const Field &b)
+{
+  Field d(a.Grid());
+  d = a - b;
+  return std::sqrt(norm2(d)/norm2(b));
+}
+
+int main(int argc, char **argv)
+{
+  Grid_init(&argc, &argv);
+
+  GridCartesian         *UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd, vComplexD::Nsimd()), GridDefaultMpi());
+  GridRedBlackCartesian *UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+
+  std::vector<int> seeds({1, 2, 3, 4});
+  GridParallelRNG pRNG(UGrid);
+  pRNG.SeedFixedIntegers(seeds);
+
+  typedef WilsonCloverFermionD::FermionField     FermionField;
+  typedef WilsonCloverFermionD::CloverFieldType  CloverField;
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(pRNG, Umu);
+
+  RealD mass = 0.1;
+  RealD csw  = 1.0;
+  WilsonCloverFermionD Dwc(Umu, *UGrid, *UrbGrid, mass, csw, csw);
+
+  ////////////////////////////////////////////////////////////////
+  // Unpacked reference clover term, assembled as before packing
+  ////////////////////////////////////////////////////////////////
+  LatticeColourMatrixD Bx(UGrid), By(UGrid), Bz(UGrid), Ex(UGrid), Ey(UGrid), Ez(UGrid);
+  WilsonLoops<PeriodicGimplD>::FieldStrength(Bx, Umu, Zdir, Ydir);
+  WilsonLoops<PeriodicGimplD>::FieldStrength(By, Umu, Zdir, Xdir);
+  WilsonLoops<PeriodicGimplD>::FieldStrength(Bz, Umu, Ydir, Xdir);
+  WilsonLoops<PeriodicGimplD>::FieldStrength(Ex, Umu, Tdir, Xdir);
+  WilsonLoops<PeriodicGimplD>::FieldStrength(Ey, Umu, Tdir, Ydir);
+  WilsonLoops<PeriodicGimplD>::FieldStrength(Ez, Umu, Tdir, Zdir);
+
+  CloverField Ref(UGrid);
+  Ref  = Dwc.fillCloverYZ(Bx) * (0.5*csw);
+  Ref += Dwc.fillCloverXZ(By) * (0.5*csw);
+  Ref += Dwc.fillCloverXY(Bz) * (0.5*csw);
+  Ref += Dwc.fillCloverXT(Ex) * (0.5*csw);
+  Ref += Dwc.fillCloverYT(Ey) * (0.5*csw);
+  Ref += Dwc.fillCloverZT(Ez) * (0.5*csw);
+  Ref += 4.0 + mass;
+
+  CloverField RefDag(UGrid);
+  RefDag = adj(Ref);
+  RealD herm = RelDiff(RefDag, Ref);
+  std::cout << GridLogMessage << "clover term hermiticity violation " << herm << std::endl;
+  assert(herm < 1.0e-14);
+
+  CloverField Full = Dwc.CloverTermFull();
+  RealD packed = RelDiff(Full, Ref);
+  std::cout << GridLogMessage << "packed clover term against the 12x12 matrix " << packed << std::endl;
+  assert(packed < 1.0e-14);
+
+  ////////////////////////////////////////////////////////////////
+  // Packed Mooee, MooeeInv and daggers
+  ////////////////////////////////////////////////////////////////
+  FermionField src(UGrid), res(UGrid), ref(UGrid);
+  gaussian(pRNG, src);
+
+  ref = Ref * src;
+  Dwc.Mooee(src, res);
+  std::cout << GridLogMessage << "Mooee full grid " << RelDiff(res, ref) << std::endl;
+  assert(RelDiff(res, ref) < 1.0e-14);
+
+  FermionField src_o(UrbGrid), res_o(UrbGrid), ref_o(UrbGrid), tmp_o(UrbGrid);
+  pickCheckerboard(Odd, src_o, src);
+  pickCheckerboard(Odd, ref_o, ref);
+  Dwc.Mooee(src_o, res_o);
+  assert(RelDiff(res_o, ref_o) < 1.0e-14);
+  Dwc.MooeeDag(src_o, tmp_o);
+  assert(RelDiff(tmp_o, ref_o) < 1.0e-14);
+
+  Dwc.MooeeInv(res_o, tmp_o);
+  std::cout << GridLogMessage << "MooeeInv Mooee - 1 " << RelDiff(tmp_o, src_o) << std::endl;
+  assert(RelDiff(tmp_o, src_o) < 1.0e-12);
+  Dwc.MooeeInvDag(res_o, tmp_o);
+  assert(RelDiff(tmp_o, src_o) < 1.0e-12);
+
+  CloverField RefInv = Dwc.CloverTermInvFull();
+  res = RefInv * ref;
+  std::cout << GridLogMessage << "inverse of the full clover term " << RelDiff(res, src) << std::endl;
+  assert(RelDiff(res, src) < 1.0e-12);
+
+  ////////////////////////////////////////////////////////////////
+  // Schur operators with the clover inverse fused into Dhop
+  ////////////////////////////////////////////////////////////////
+  SchurDiagMooeeOperator<WilsonCloverFermionD, FermionField> HermOpEO(Dwc);
+  SchurDiagOneOperator<WilsonCloverFermionD, FermionField>   HermOpOne(Dwc);
+  SchurDiagTwoOperator<WilsonCloverFermionD, FermionField>   HermOpTwo(Dwc);
+
+  std::vector<int> opts({WilsonKernelsStatic::OptGeneric, WilsonKernelsStatic::OptHandUnroll});
+  int opt_save  = WilsonKernelsStatic::Opt;
+  int fuse_save = WilsonKernelsStatic::FuseClover;
+  int comm_save = WilsonKernelsStatic::Comms;
+  WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsThenCompute;
+
+  FermionField sep(UrbGrid), fused(UrbGrid);
+  for(auto opt : opts){
+    WilsonKernelsStatic::Opt = opt;
+
+    WilsonKernelsStatic::FuseClover = 0; HermOpEO.Mpc(src_o, sep);
+    WilsonKernelsStatic::FuseClover = 1; HermOpEO.Mpc(src_o, fused);
+    std::cout << GridLogMessage << "Opt " << opt << " SchurDiagMooee Mpc fused " << RelDiff(fused, sep) << std::endl;
+    assert(RelDiff(fused, sep) < 1.0e-14);
+
+    WilsonKernelsStatic::FuseClover = 0; HermOpEO.MpcDag(src_o, sep);
+    WilsonKernelsStatic::FuseClover = 1; HermOpEO.MpcDag(src_o, fused);
+    std::cout << GridLogMessage << "Opt " << opt << " SchurDiagMooee MpcDag fused " << RelDiff(fused, sep) << std::endl;
+    assert(RelDiff(fused, sep) < 1.0e-14);
+
+    WilsonKernelsStatic::FuseClover = 0; HermOpOne.Mpc(src_o, sep);
+    WilsonKernelsStatic::FuseClover = 1; HermOpOne.Mpc(src_o, fused);
+    std::cout << GridLogMessage << "Opt " << opt << " SchurDiagOne Mpc fused " << RelDiff(fused, sep) << std::endl;
+    assert(RelDiff(fused, sep) < 1.0e-14);
+
+    WilsonKernelsStatic::FuseClover = 0; HermOpTwo.MpcDag(src_o, sep);
+    WilsonKernelsStatic::FuseClover = 1; HermOpTwo.MpcDag(src_o, fused);
+    std::cout << GridLogMessage << "Opt " << opt << " SchurDiagTwo MpcDag fused " << RelDiff(fused, sep) << std::endl;
+    assert(RelDiff(fused, sep) < 1.0e-14);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Timing of the Schur operator, separate passes and fused
+  ////////////////////////////////////////////////////////////////
+  int ncall = 100;
+  for(int fuse=0;fuse<2;fuse++){
+    WilsonKernelsStatic::FuseClover = fuse;
+    HermOpEO.Mpc(src_o, sep);
+    double t0 = usecond();
+    for(int i=0;i<ncall;i++) HermOpEO.Mpc(src_o, sep);
+    double t1 = usecond();
+    std::cout << GridLogMessage << "SchurDiagMooee Mpc " << (fuse ? "fused    " : "separate ")
+	      << (t1-t0)/ncall << " us per call" << std::endl;
+  }
+
+  WilsonKernelsStatic::Opt        = opt_save;
+  WilsonKernelsStatic::FuseClover = fuse_save;
+  WilsonKernelsStatic::Comms      = comm_save;
+
+  Grid_finalize();
+}
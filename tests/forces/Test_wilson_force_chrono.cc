@@ -0,0 +1,104 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/forces/Test_wilson_force_chrono.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(&Grid);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(&Grid);  pRNG.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField U(&Grid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+
+  RealD mass=0.2;
+  WilsonFermionR Dw(U,Grid,RBGrid,mass);
+
+  ConjugateGradient<LatticeFermion> CGref  (1.0e-10,10000);
+  ConjugateGradient<LatticeFermion> CGchrono(1.0e-10,10000);
+
+  TwoFlavourEvenOddPseudoFermionAction<WilsonImplR> Ref   (Dw,CGref,CGref);
+  TwoFlavourEvenOddPseudoFermionAction<WilsonImplR> Chrono(Dw,CGchrono,CGchrono);
+  Chrono.SetChronoForecast(ChronoForecastParams(4,0.1));
+  std::cout << Chrono.LogParameters();
+
+  // Same pseudofermion for both
+  GridParallelRNG pRNGa(&Grid);  pRNGa.SeedFixedIntegers(seeds);
+  GridParallelRNG pRNGb(&Grid);  pRNGb.SeedFixedIntegers(seeds);
+  Ref.refresh(U,pRNGa);
+  Chrono.refresh(U,pRNGb);
+
+  ////////////////////////////////////////////////////////////////
+  // Force along a short MD trajectory; chrono guesses must give
+  // the same force in fewer iterations
+  ////////////////////////////////////////////////////////////////
+  LatticeGaugeField P(&Grid);
+  LatticeGaugeField Fref(&Grid);
+  LatticeGaugeField Fchrono(&Grid);
+  LatticeGaugeField Fdiff(&Grid);
+  PeriodicGimplR::generate_momenta(P,pRNG);
+
+  RealD dt = 0.02;
+  int iters_ref=0;
+  int iters_chrono=0;
+  for(int step=0;step<8;step++){
+    Ref.deriv(U,Fref);
+    iters_ref += CGref.IterationsToComplete;
+    Chrono.deriv(U,Fchrono);
+    iters_chrono += CGchrono.IterationsToComplete;
+
+    Fdiff = Fchrono-Fref;
+    RealD diff = std::sqrt(norm2(Fdiff)/norm2(Fref));
+    std::cout << GridLogMessage << "step "<<step<<" iterations "<<CGref.IterationsToComplete
+	      <<" -> "<<CGchrono.IterationsToComplete<<" force rel diff "<<diff<<std::endl;
+    assert(diff < 1.0e-8);
+    assert(CGchrono.Tolerance == CGref.Tolerance);
+
+    PeriodicGimplR::update_field(P,U,dt);
+  }
+  std::cout << GridLogMessage << "total iterations "<<iters_ref<<" -> "<<iters_chrono<<std::endl;
+  assert(iters_chrono < iters_ref);
+
+  // Refresh discards the history
+  Chrono.refresh(U,pRNGb);
+  Chrono.deriv(U,Fchrono);
+  Ref.refresh(U,pRNGa);
+  Ref.deriv(U,Fref);
+  assert(CGchrono.IterationsToComplete == CGref.IterationsToComplete);
+
+  Grid_finalize();
+}
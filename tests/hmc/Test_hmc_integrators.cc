@@ -0,0 +1,115 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/hmc/Test_hmc_integrators.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef PeriodicGimplR            Gimpl;
+typedef NoSmearing<Gimpl>         Smearing;
+typedef Representations<FundamentalRepresentation> Repr;
+typedef ActionSet<LatticeGaugeField,Repr> ActionSetR;
+
+// Energy violation of one trajectory from a fixed start
+template<class Integrator>
+RealD deltaH(GridCartesian *grid,ActionSetR &FullSet,LatticeGaugeField &U0,int MDsteps,LatticeGaugeField &U)
+{
+  Smearing Smearer;
+  IntegratorParameters MDpar(MDsteps,1.0);
+  Integrator MD(grid,MDpar,FullSet,Smearer);
+
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  U = U0;
+  MD.refresh(U,pRNG);
+  RealD H0 = MD.S(U);
+  MD.integrate(U);
+  RealD H1 = MD.S(U);
+  std::cout << GridLogMessage << MD.integrator_name() << " MDsteps "<<MDsteps<<" dH = "<<H1-H0<<std::endl;
+  return H1-H0;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  LatticeGaugeField U0(grid);
+  LatticeGaugeField U(grid);
+  SU<Nc>::HotConfiguration(pRNG,U0);
+
+  // Two levels: Iwasaki on the outer, Wilson on the inner
+  WilsonGaugeActionR  Waction(5.6);
+  IwasakiGaugeActionR Raction(2.13);
+  ActionLevel<LatticeGaugeField,Repr> Level1(1);
+  ActionLevel<LatticeGaugeField,Repr> Level2(2);
+  Level1.push_back(&Raction);
+  Level2.push_back(&Waction);
+  ActionSetR FullSet;
+  FullSet.push_back(Level1);
+  FullSet.push_back(Level2);
+
+  ////////////////////////////////////////////////////////////////
+  // Fourth order: dH falls by ~2^4 when the step is halved
+  ////////////////////////////////////////////////////////////////
+  RealD dH_omf4_a = deltaH<OMF4<Gimpl,Smearing> >(grid,FullSet,U0,4,U);
+  RealD dH_omf4_b = deltaH<OMF4<Gimpl,Smearing> >(grid,FullSet,U0,8,U);
+  RealD dH_mn2    = deltaH<MinimumNorm2<Gimpl,Smearing> >(grid,FullSet,U0,8,U);
+  std::cout << GridLogMessage << "OMF4 dH ratio on halving the step "<<dH_omf4_a/dH_omf4_b<<std::endl;
+  assert(fabs(dH_omf4_a/dH_omf4_b) > 8.0);
+  assert(fabs(dH_omf4_b) < fabs(dH_mn2));
+
+  // ForceGradient goes through the same cached update_P
+  RealD dH_fg_a = deltaH<ForceGradient<Gimpl,Smearing> >(grid,FullSet,U0,4,U);
+  RealD dH_fg_b = deltaH<ForceGradient<Gimpl,Smearing> >(grid,FullSet,U0,8,U);
+  std::cout << GridLogMessage << "ForceGradient dH ratio on halving the step "<<dH_fg_a/dH_fg_b<<std::endl;
+  assert(fabs(dH_fg_a/dH_fg_b) > 8.0);
+
+  ////////////////////////////////////////////////////////////////
+  // Reversibility with cached forces
+  ////////////////////////////////////////////////////////////////
+  {
+    Smearing Smearer;
+    IntegratorParameters MDpar(4,1.0);
+    OMF4<Gimpl,Smearing> MD(grid,MDpar,FullSet,Smearer);
+    GridParallelRNG pRNGr(grid); pRNGr.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+    U = U0;
+    MD.refresh(U,pRNGr);
+    MD.integrate(U);
+    MD.reverse_momenta();
+    MD.integrate(U);
+    LatticeGaugeField diff(grid);
+    diff = U - U0;
+    RealD rev = std::sqrt(norm2(diff)/norm2(U0));
+    std::cout << GridLogMessage << "OMF4 reversibility |U-U0|/|U0| = "<<rev<<std::endl;
+    assert(rev < 1.0e-10);
+  }
+
+  Grid_finalize();
+}
@@ -0,0 +1,104 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/solver/Test_mobius_bcg_mrhs.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls   = 8;
+  const int Nrhs = 3;
+  const int Nsrc = 5; // not a multiple of Nrhs; last batch is padded
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+  GridCartesian         * BGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls*Nrhs,UGrid);
+  GridRedBlackCartesian * BrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls*Nrhs,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+
+  LatticeGaugeFieldD Umu(UGrid); SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+  MobiusFermionD Dsingle(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,1.5,0.5);
+  MobiusFermionD Dblock (Umu,*BGrid,*BrbGrid,*UGrid,*UrbGrid,mass,M5,1.5,0.5,MobiusFermionD::ImplParams(),Nrhs);
+
+  SchurDiagTwoOperator<MobiusFermionD,LatticeFermionD> HermOp (Dsingle);
+  SchurDiagTwoOperator<MobiusFermionD,LatticeFermionD> HermOpB(Dblock);
+
+  LatticeFermionD tmp(FGrid);
+  LatticeFermionD diff(FrbGrid);
+  std::vector<LatticeFermionD> src(Nsrc,FrbGrid), ref(Nsrc,FrbGrid), result(Nsrc,FrbGrid);
+  for(int b=0;b<Nsrc;b++){
+    random(RNG5,tmp);
+    pickCheckerboard(Odd,src[b],tmp);
+  }
+
+  const RealD tol = 1.0e-8;
+
+  std::cout << GridLogMessage << "ConjugateGradient per right hand side" << std::endl;
+  ConjugateGradient<LatticeFermionD> CG(tol,10000);
+  for(int b=0;b<Nsrc;b++){
+    ref[b] = Zero();
+    CG(HermOp,src[b],ref[b]);
+  }
+
+  std::cout << GridLogMessage << "BlockConjugateGradientMultiRHS, column loop" << std::endl;
+  MultiRHSLoopOperator<LatticeFermionD> LoopOp(HermOp);
+  BlockConjugateGradientMultiRHS<LatticeFermionD> BCG(tol,10000);
+  ZeroGuesser<LatticeFermionD> Guess;
+  BCG(LoopOp,Guess,src,result);
+  for(int b=0;b<Nsrc;b++){
+    diff = result[b] - ref[b];
+    std::cout << GridLogMessage << "rhs " << b << " iterations " << BCG.IterationsToConverge[b]
+	      << " solution difference " << std::sqrt(norm2(diff)/norm2(ref[b])) << std::endl;
+    assert(BCG.TrueResiduals[b] < 10*tol);
+    assert(BCG.ResidualHistory[b].size() == BCG.IterationsToConverge[b]+1);
+  }
+  std::vector<Integer> loop_iters = BCG.IterationsToConverge;
+
+  std::cout << GridLogMessage << "BlockConjugateGradientMultiRHS, Nrhs blocked operator" << std::endl;
+  MultiRHSBlockOperator<LatticeFermionD> BlockOp(HermOpB,BrbGrid,Nrhs);
+  for(int b=0;b<Nsrc;b++) result[b] = Zero();
+  BCG(BlockOp,src,result);
+  for(int b=0;b<Nsrc;b++){
+    diff = result[b] - ref[b];
+    std::cout << GridLogMessage << "rhs " << b << " iterations " << BCG.IterationsToConverge[b]
+	      << " solution difference " << std::sqrt(norm2(diff)/norm2(ref[b])) << std::endl;
+    assert(BCG.TrueResiduals[b] < 10*tol);
+    assert(BCG.IterationsToConverge[b] == loop_iters[b]);
+  }
+
+  Grid_finalize();
+}
@@ -0,0 +1,83 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/solver/Test_wilson_cg_pipelined.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(&Grid);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          pRNG(&Grid);  pRNG.SeedFixedIntegers(seeds);
+
+  LatticeFermion src(&Grid); random(pRNG,src);
+  LatticeFermion result(&Grid);
+  LatticeFermion ref(&Grid);
+  LatticeFermion diff(&Grid);
+  LatticeGaugeField Umu(&Grid); SU<Nc>::HotConfiguration(pRNG,Umu);
+
+  RealD mass=0.5;
+  WilsonFermionR Dw(Umu,Grid,RBGrid,mass);
+
+  MdagMLinearOperator<WilsonFermionR,LatticeFermion> HermOp(Dw);
+
+  std::cout << GridLogMessage << "ConjugateGradient" << std::endl;
+  ConjugateGradient<LatticeFermion> CG(1.0e-8,10000);
+  ref=Zero();
+  CG(HermOp,src,ref);
+
+  std::cout << GridLogMessage << "ConjugateGradientPipelined" << std::endl;
+  ConjugateGradientPipelined<LatticeFermion> PCG(1.0e-8,10000);
+  result=Zero();
+  PCG(HermOp,src,result);
+  diff = result - ref;
+  std::cout << GridLogMessage << "Pipelined iterations " << PCG.IterationsToComplete
+	    << " vs " << CG.IterationsToComplete
+	    << " solution difference " << std::sqrt(norm2(diff)/norm2(ref)) << std::endl;
+  assert(PCG.TrueResidual < 1.0e-7);
+
+  for(int s=2;s<=4;s++){
+    std::cout << GridLogMessage << "ConjugateGradientSStep s=" << s << std::endl;
+    ConjugateGradientSStep<LatticeFermion> SCG(1.0e-8,10000,s);
+    result=Zero();
+    SCG(HermOp,src,result);
+    diff = result - ref;
+    std::cout << GridLogMessage << "s-step " << s << " iterations " << SCG.IterationsToComplete
+	      << " vs " << CG.IterationsToComplete
+	      << " solution difference " << std::sqrt(norm2(diff)/norm2(ref)) << std::endl;
+    assert(SCG.TrueResidual < 1.0e-7);
+  }
+
+  Grid_finalize();
+}
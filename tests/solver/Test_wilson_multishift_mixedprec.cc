@@ -0,0 +1,101 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/solver/Test_wilson_multishift_mixedprec.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         *FGrid_d   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd, vComplexD::Nsimd()), GridDefaultMpi());
+  GridCartesian         *FGrid_f   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd, vComplexF::Nsimd()), GridDefaultMpi());
+  GridRedBlackCartesian *FrbGrid_d = SpaceTimeGrid::makeFourDimRedBlackGrid(FGrid_d);
+  GridRedBlackCartesian *FrbGrid_f = SpaceTimeGrid::makeFourDimRedBlackGrid(FGrid_f);
+
+  std::vector<int> fSeeds({1, 2, 3, 4});
+  GridParallelRNG  fPRNG(FGrid_d);
+  fPRNG.SeedFixedIntegers(fSeeds);
+
+  LatticeFermionD    src(FGrid_d);    gaussian(fPRNG, src);
+  LatticeGaugeFieldD Umu_d(FGrid_d);  SU<Nc>::HotConfiguration(fPRNG, Umu_d);
+  LatticeGaugeFieldF Umu_f(FGrid_f);  precisionChange(Umu_f, Umu_d);
+
+  RealD mass = 0.1;
+  WilsonFermionD Dw_d(Umu_d, *FGrid_d, *FrbGrid_d, mass);
+  WilsonFermionF Dw_f(Umu_f, *FGrid_f, *FrbGrid_f, mass);
+
+  LatticeFermionD src_o(FrbGrid_d);
+  pickCheckerboard(Odd, src_o, src);
+
+  SchurDiagMooeeOperator<WilsonFermionD, LatticeFermionD> HermOpEO_d(Dw_d);
+  SchurDiagMooeeOperator<WilsonFermionF, LatticeFermionF> HermOpEO_f(Dw_f);
+
+  ////////////////////////////////////////
+  // A rational function with poles spread
+  // over the spectrum; shifts converge at
+  // very different rates
+  ////////////////////////////////////////
+  int nshift = 8;
+  MultiShiftFunction Rational(nshift,1.0e-2,64.0);
+  Rational.order = nshift;
+  Rational.norm  = 0.1;
+  Rational.tolerances.resize(nshift,1.0e-10);
+  for(int s=0;s<nshift;s++){
+    Rational.poles[s]    = 1.0e-3*std::pow(10.0,0.6*s);
+    Rational.residues[s] = 0.05*std::pow(10.0,0.3*s);
+  }
+
+  std::cout << GridLogMessage << "::::::::::::: Double precision multi-shift CG" << std::endl;
+  std::vector<LatticeFermionD> res_d(nshift,FrbGrid_d);
+  LatticeFermionD sum_d(FrbGrid_d);
+  ConjugateGradientMultiShift<LatticeFermionD> msCG(10000,Rational);
+  msCG(HermOpEO_d,src_o,res_d,sum_d);
+
+  std::cout << GridLogMessage << "::::::::::::: Mixed precision multi-shift CG" << std::endl;
+  std::vector<LatticeFermionD> res_m(nshift,FrbGrid_d);
+  LatticeFermionD sum_m(FrbGrid_d);
+  ConjugateGradientMultiShiftMixedPrec<LatticeFermionD,LatticeFermionF> mmsCG(10000,Rational,FrbGrid_f,HermOpEO_f);
+  mmsCG(HermOpEO_d,src_o,res_m,sum_m);
+
+  std::cout << GridLogMessage << "iterations double "<<msCG.IterationsToComplete
+	    <<" mixed "<<mmsCG.IterationsToComplete<<" with "<<mmsCG.ReliableUpdatesPerformed<<" reliable updates"<<std::endl;
+
+  LatticeFermionD diff(FrbGrid_d);
+  for(int s=0;s<nshift;s++){
+    assert(mmsCG.TrueResidualShift[s] <= Rational.tolerances[s]);
+    diff = res_m[s]-res_d[s];
+    RealD rel = std::sqrt(norm2(diff)/norm2(res_d[s]));
+    std::cout << GridLogMessage << "shift "<<s<<" pole "<<Rational.poles[s]
+	      <<" rel diff "<<rel<<" cleanup "<<mmsCG.IterationsToCleanupShift[s]<<std::endl;
+    assert(rel < 1.0e-7);
+  }
+  diff = sum_m-sum_d;
+  assert(std::sqrt(norm2(diff)/norm2(sum_d)) < 1.0e-8);
+
+  Grid_finalize();
+}